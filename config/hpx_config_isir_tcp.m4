@@ -0,0 +1,26 @@
+# -*- autoconf -*---------------------------------------------------------------
+# HPX_CONFIG_ISIR_TCP
+#
+# Enable the TCP socket transport for the ISIR network. This replaces MPI as the
+# isend/irecv transport, so the ISIR network can run between processes that
+# were not launched by an MPI runtime.
+#
+# Sets
+#   enable_isir_tcp
+#   have_isir_tcp
+#
+# Defines
+#   HAVE_ISIR_TCP
+# ------------------------------------------------------------------------------
+AC_DEFUN([HPX_CONFIG_ISIR_TCP], [
+ AC_ARG_ENABLE([isir-tcp],
+   [AS_HELP_STRING([--enable-isir-tcp],
+                   [Enable the TCP ISIR transport @<:@default=no@:>@])],
+   [], [enable_isir_tcp=no])
+
+ AS_IF([test "x$enable_isir_tcp" != xno],
+   [AC_CHECK_HEADER([sys/epoll.h], [],
+      [AC_MSG_ERROR([--enable-isir-tcp requires sys/epoll.h])])
+    AC_DEFINE([HAVE_ISIR_TCP], [1], [TCP ISIR transport available])
+    have_isir_tcp=yes])
+])
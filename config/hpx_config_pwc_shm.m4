@@ -0,0 +1,32 @@
+# -*- autoconf -*---------------------------------------------------------------
+# HPX_CONFIG_PWC_SHM
+#
+# Enable the shared-memory transport for the PWC network. This runs the PWC
+# network between processes on a single Linux host, using cross-memory attach,
+# and is mutually exclusive with photon.
+#
+# Sets
+#   enable_pwc_shm
+#   have_pwc_shm
+#
+# Defines
+#   HAVE_PWC_SHM
+#   HAVE_AS_GLOBAL
+#   HAVE_AS_REGISTERED
+# ------------------------------------------------------------------------------
+AC_DEFUN([HPX_CONFIG_PWC_SHM], [
+ AC_ARG_ENABLE([pwc-shm],
+   [AS_HELP_STRING([--enable-pwc-shm],
+                   [Enable the shared-memory PWC transport @<:@default=no@:>@])],
+   [], [enable_pwc_shm=no])
+
+ AS_IF([test "x$enable_pwc_shm" != xno],
+   [AS_IF([test "x$have_photon" == xyes],
+      [AC_MSG_ERROR([--enable-pwc-shm excludes --enable-photon])])
+    AC_CHECK_FUNC([process_vm_writev], [],
+      [AC_MSG_ERROR([--enable-pwc-shm requires process_vm_writev])])
+    AC_DEFINE([HAVE_PWC_SHM], [1], [Shared-memory PWC transport available])
+    AC_DEFINE([HAVE_AS_GLOBAL], [1], [We have global memory])
+    AC_DEFINE([HAVE_AS_REGISTERED], [1], [We have registered memory])
+    have_pwc_shm=yes])
+])
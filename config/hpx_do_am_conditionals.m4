@@ -28,7 +28,11 @@ AC_DEFUN([HPX_DO_AM_CONDITIONALS], [
  AM_CONDITIONAL([HAVE_CMPXCHG16B], [test "x$have_cmpxchg16b" == xyes])
  AM_CONDITIONAL([HAVE_KNC], [test "x$pt_cv_knc_val" == xyes])
  AM_CONDITIONAL([HAVE_PHOTON], [test "x$have_photon" == xyes])
+ AM_CONDITIONAL([HAVE_PWC_SHM], [test "x$have_pwc_shm" == xyes])
+ AM_CONDITIONAL([HAVE_PWC], [test "x$have_pwc" == xyes])
  AM_CONDITIONAL([HAVE_MPI], [test "x$have_mpi" == xyes])
+ AM_CONDITIONAL([HAVE_ISIR_TCP], [test "x$have_isir_tcp" == xyes])
+ AM_CONDITIONAL([HAVE_ISIR], [test "x$have_isir" == xyes])
  AM_CONDITIONAL([HAVE_NETWORK], [test "x$have_network" == xyes])
  AM_CONDITIONAL([HAVE_PMI], [test "x$have_pmi" == xyes])
  AM_CONDITIONAL([HAVE_JEMALLOC], [test "x$have_jemalloc" == xyes])
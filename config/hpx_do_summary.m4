@@ -7,7 +7,9 @@ AC_DEFUN([HPX_DO_SUMMARY], [
 
  # Compute some friendly strings
  AS_IF([test "x$have_mpi" == xyes], [networks="MPI"])
+ AS_IF([test "x$have_isir_tcp" == xyes], [networks="TCP $networks"])
  AS_IF([test "x$have_photon" == xyes], [networks="Photon $networks"])
+ AS_IF([test "x$have_pwc_shm" == xyes], [networks="PWC-shm $networks"])
  
  AS_IF([test "x$have_jemalloc" == xyes], [allocator="jemalloc"])
  AS_IF([test "x$have_tbbmalloc" == xyes], [allocator="tbbmalloc"])
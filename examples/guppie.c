@@ -198,7 +198,7 @@ static int _mover_action(guppie_config_t *cfg, size_t n) {
 static int _update_table_action(guppie_config_t *cfg, size_t n) {
 #define VLEN 32
   uint64_t ran[VLEN];              /* Current random numbers */
-  uint64_t t1[VLEN];
+  hpx_addr_t addrs[VLEN];
   long start, stop, size;
   long i;
   long j;
@@ -216,14 +216,12 @@ static int _update_table_action(guppie_config_t *cfg, size_t n) {
       ran[j] = (ran[j] << 1) ^ ((long) ran[j] < 0 ? POLY : 0);
     }
     for (j=0; j<VLEN; j++)
-      t1[j] = table_get(cfg->table, ran[j] & (cfg->tabsize-1));
+      addrs[j] = hpx_addr_add(cfg->table,
+                              (ran[j] & (cfg->tabsize-1)) * BLOCK_SIZE,
+                              BLOCK_SIZE);
 
-    for (j=0; j<VLEN; j++)
-      t1[j] ^= ran[j];
-
-    and = hpx_lco_and_new(VLEN);
-    for (j=0; j<VLEN; j++)
-      table_set(cfg->table, ran[j] & (cfg->tabsize-1), t1[j], and);
+    and = hpx_lco_future_new(0);
+    hpx_gas_atomic_batch(HPX_GAS_ATOMIC_XOR, VLEN, addrs, (int64_t*)ran, and);
     hpx_lco_wait(and);
     hpx_lco_delete(and, HPX_NULL);
   }
@@ -149,6 +149,24 @@ int hpx_register_action(hpx_action_type_t type, uint32_t attr, const char *key,
 hpx_action_handler_t hpx_action_get_handler(hpx_action_t id)
   HPX_PUBLIC;
 
+/// Tune how parcels for an HPX_COALESCED action are coalesced.
+///
+/// Coalesced parcels wait in a per-destination buffer until it holds @p bytes
+/// bytes, or until one of them has waited for @p usecs microseconds. A buffer
+/// holding parcels for several actions uses the smallest limits among them. A
+/// limit of 0 keeps the runtime default (--hpx-coalescing-bytes and
+/// --hpx-coalescing-usecs).
+///
+/// This must be called after hpx_init().
+///
+/// @param          id The action id.
+/// @param       bytes The byte limit, or 0 for the default.
+/// @param       usecs The deadline in microseconds, or 0 for the default.
+///
+/// @returns           HPX_SUCCESS, or HPX_ERROR if the action is not coalesced
+int hpx_action_set_coalescing(hpx_action_t id, uint32_t bytes, uint32_t usecs)
+  HPX_PUBLIC;
+
 /// @}
 
 #ifdef __cplusplus
@@ -27,6 +27,10 @@ extern "C" {
 ///        space.
 #include <hpx/addr.h>
 
+/// The scatter/gather element used by the indexed memget and memput, which
+/// callers get from the POSIX <sys/uio.h> header.
+struct iovec;
+
 /// The largest block size supported by the implementation.
 extern HPX_PUBLIC uint64_t HPX_GAS_BLOCK_BYTES_MAX;
 
@@ -497,6 +501,97 @@ int hpx_gas_memput_lsync(hpx_addr_t to, const void *from, size_t size,
 int hpx_gas_memput_rsync(hpx_addr_t to, const void *from, size_t size)
   HPX_PUBLIC;
 
+/// This copies a strided region from a global address to a local buffer,
+/// asynchronously.
+///
+/// This copies @p count pieces of @p bytes each, where piece @c i is read from
+/// @p from + @c i * @p from_stride and written to @p to + @c i * @p to_stride.
+/// The pieces are transferred as a single operation with a single completion,
+/// so this should be preferred to a sequence of hpx_gas_memget() calls for
+/// non-contiguous accesses like halo columns. The global region must lie within
+/// a single block, as for hpx_gas_memget().
+///
+/// @param           to The local address of the first piece.
+/// @param    to_stride The distance, in bytes, between local pieces.
+/// @param         from The global address of the first piece.
+/// @param  from_stride The distance, in bytes, between global pieces.
+/// @param        bytes The size, in bytes, of each piece.
+/// @param        count The number of pieces.
+/// @param        lsync The address of a zero-sized future that can be used to
+///                       wait for completion of the memget.
+///
+/// @returns HPX_SUCCESS
+int hpx_gas_memget_strided(void *to, size_t to_stride, hpx_addr_t from,
+                           size_t from_stride, size_t bytes, int count,
+                           hpx_addr_t lsync)
+  HPX_PUBLIC;
+
+/// This copies a strided region from a local buffer to a global address,
+/// asynchronously.
+///
+/// This is the put analog of hpx_gas_memget_strided(), where piece @c i is read
+/// from @p from + @c i * @p from_stride and written to @p to + @c i *
+/// @p to_stride. The global region must lie within a single block.
+///
+/// @param           to The global address of the first piece.
+/// @param    to_stride The distance, in bytes, between global pieces.
+/// @param         from The local address of the first piece.
+/// @param  from_stride The distance, in bytes, between local pieces.
+/// @param        bytes The size, in bytes, of each piece.
+/// @param        count The number of pieces.
+/// @param        lsync The address of a zero-sized future that can be used to
+///                       wait for local completion of the memput.
+/// @param        rsync The address of a zero-sized future that can be used to
+///                       wait for remote completion of the memput.
+///
+/// @returns  HPX_SUCCESS
+int hpx_gas_memput_strided(hpx_addr_t to, size_t to_stride, const void *from,
+                           size_t from_stride, size_t bytes, int count,
+                           hpx_addr_t lsync, hpx_addr_t rsync)
+  HPX_PUBLIC;
+
+/// This gathers pieces of a global block into local buffers, asynchronously.
+///
+/// Piece @c i is @c to[i].iov_len bytes read from @p from + @c offsets[i]
+/// into @c to[i].iov_base. The pieces are transferred as a single operation
+/// with a single completion, and must all lie within the block at @p from. The
+/// @p to and @p offsets arrays may be reused as soon as this returns.
+///
+/// @param           to The local buffers to copy to.
+/// @param         from The global address of the block to copy from.
+/// @param      offsets The offset of each piece within the block.
+/// @param            n The number of pieces.
+/// @param        lsync The address of a zero-sized future that can be used to
+///                       wait for completion of the memget.
+///
+/// @returns HPX_SUCCESS
+int hpx_gas_memget_indexed(const struct iovec *to, hpx_addr_t from,
+                           const size_t *offsets, int n, hpx_addr_t lsync)
+  HPX_PUBLIC;
+
+/// This scatters local buffers into pieces of a global block, asynchronously.
+///
+/// Piece @c i is @c from[i].iov_len bytes read from @c from[i].iov_base and
+/// written to @p to + @c offsets[i]. The pieces must all lie within the block
+/// at @p to. The @p offsets and @p from arrays may be reused as soon as this
+/// returns, while the buffers they describe may be reused once @p lsync is
+/// set.
+///
+/// @param           to The global address of the block to copy to.
+/// @param      offsets The offset of each piece within the block.
+/// @param         from The local buffers to copy from.
+/// @param            n The number of pieces.
+/// @param        lsync The address of a zero-sized future that can be used to
+///                       wait for local completion of the memput.
+/// @param        rsync The address of a zero-sized future that can be used to
+///                       wait for remote completion of the memput.
+///
+/// @returns  HPX_SUCCESS
+int hpx_gas_memput_indexed(hpx_addr_t to, const size_t *offsets,
+                           const struct iovec *from, int n, hpx_addr_t lsync,
+                           hpx_addr_t rsync)
+  HPX_PUBLIC;
+
 /// This copies data from a global address to a global address, asynchronously.
 ///
 /// The global address range [from, from + size) and [to, to + size) must be
@@ -537,6 +632,88 @@ int hpx_gas_memcpy(hpx_addr_t to, hpx_addr_t from, size_t size, hpx_addr_t sync)
 int hpx_gas_memcpy_sync(hpx_addr_t to, hpx_addr_t from, size_t size)
   HPX_PUBLIC;
 
+/// The atomic read-modify-write operations on global words.
+typedef enum {
+  HPX_GAS_ATOMIC_ADD = 0,                       //!< *addr += value
+  HPX_GAS_ATOMIC_AND,                           //!< *addr &= value
+  HPX_GAS_ATOMIC_OR,                            //!< *addr |= value
+  HPX_GAS_ATOMIC_XOR,                           //!< *addr ^= value
+  HPX_GAS_ATOMIC_MIN,                           //!< *addr = min(*addr, value)
+  HPX_GAS_ATOMIC_MAX                            //!< *addr = max(*addr, value)
+} hpx_gas_atomic_op_t;
+
+/// Atomically update a global word, asynchronously.
+///
+/// The @p addr must be the address of an aligned int64_t within a block. If
+/// the word is local the operation is performed immediately, otherwise it is
+/// sent to the word's owner as a single message and performed there without
+/// creating a thread. Atomic operations are only atomic with respect to other
+/// atomic operations on the same word.
+///
+/// @param         addr The global address of the word.
+/// @param           op The operation to perform.
+/// @param        value The operand.
+/// @param       result The address of a future of sizeof(int64_t) bytes that
+///                       will be set to the value of the word before the
+///                       update, or HPX_NULL.
+///
+/// @returns HPX_SUCCESS, HPX_ERROR if @p op is not a valid operation, or an
+///          error code if the operation couldn't be sent
+int hpx_gas_atomic_fetch(hpx_addr_t addr, hpx_gas_atomic_op_t op, int64_t value,
+                         hpx_addr_t result)
+  HPX_PUBLIC;
+
+/// Atomically update a global word, and return its previous value.
+int64_t hpx_gas_atomic_fetch_sync(hpx_addr_t addr, hpx_gas_atomic_op_t op,
+                                  int64_t value)
+  HPX_PUBLIC;
+
+/// Atomically compare and swap a global word, asynchronously.
+///
+/// The word at @p addr is replaced with @p desired if it is equal to
+/// @p expected. This has the same requirements as hpx_gas_atomic_fetch().
+///
+/// @param         addr The global address of the word.
+/// @param     expected The value to compare with.
+/// @param      desired The value to store if the comparison succeeds.
+/// @param       result The address of a future of sizeof(int64_t) bytes that
+///                       will be set to the value of the word before the
+///                       operation, or HPX_NULL. The swap succeeded if this is
+///                       equal to @p expected.
+///
+/// @returns HPX_SUCCESS, or an error code if the operation couldn't be sent
+int hpx_gas_atomic_cas(hpx_addr_t addr, int64_t expected, int64_t desired,
+                       hpx_addr_t result)
+  HPX_PUBLIC;
+
+/// Atomically compare and swap a global word, and return its previous value.
+int64_t hpx_gas_atomic_cas_sync(hpx_addr_t addr, int64_t expected,
+                                int64_t desired)
+  HPX_PUBLIC;
+
+/// Atomically apply a batch of updates to global words.
+///
+/// This applies @p op with @c values[i] to the word at @c addrs[i] for each
+/// of the @p n updates, without returning the previous values. Updates to
+/// local words are performed immediately. Remote updates are sent as
+/// HPX_COALESCED parcels, so with coalescing enabled a stream of updates to
+/// the same locality will share messages. The @p addrs and @p values arrays
+/// may be reused as soon as this returns.
+///
+/// @param           op The operation to perform.
+/// @param            n The number of updates.
+/// @param        addrs The global addresses of the words.
+/// @param       values The operands.
+/// @param        rsync The address of a zero-sized future that will be set
+///                       once all of the updates have been performed.
+///
+/// @returns HPX_SUCCESS, HPX_ERROR if @p op is not a valid operation, or an
+///          error code if an update couldn't be sent, in which case @p rsync
+///          is set once the updates that were sent have been performed
+int hpx_gas_atomic_batch(hpx_gas_atomic_op_t op, int n, const hpx_addr_t *addrs,
+                         const int64_t *values, hpx_addr_t rsync)
+  HPX_PUBLIC;
+
 /// GAS collectives (hpx_gas_bcast_with_continuation).
 ///
 /// This is a parallel call (bcast) that performs an @p action with @p
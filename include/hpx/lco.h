@@ -246,8 +246,8 @@ void hpx_lco_release(hpx_addr_t lco, void *ref)
 ///
 /// This admits some parallelism in the implementation, and is preferable to
 /// using hpx_lco_wait() in a loop. The calling thread will block until all of
-/// the LCOs have been set. Entries in @p lcos that are HPX_NULL will be
-/// ignored.
+/// the LCOs have been set, but suspends only once for the entire set. Entries
+/// in @p lcos that are HPX_NULL will be ignored.
 ///
 /// @param             n the number of LCOs in @p lcos
 /// @param          lcos an array of LCO addresses (must be uniformly
@@ -284,6 +284,49 @@ int hpx_lco_get_all(int n, hpx_addr_t lcos[], size_t sizes[], void *values[],
                     hpx_status_t statuses[])
   HPX_PUBLIC;
 
+/// Wait for any one of the LCOs to be set.
+///
+/// The calling thread will block until at least one of the LCOs has been
+/// set. Entries in @p lcos that are HPX_NULL will be ignored. LCOs without a
+/// monotonic triggered state (semaphores, generation counters, channels and
+/// reader/writer locks) are not supported by this interface. Nothing remains
+/// attached to the other LCOs once this returns.
+///
+/// @param             n the number of LCOs in @p lcos
+/// @param          lcos an array of LCO addresses
+/// @param[out]   status the status of the LCO that was set, pass NULL if the
+///                      status is not required
+///
+/// @returns             the index in @p lcos of the LCO that was set, or -1
+///                      with an HPX_ERROR status if all of the entries in
+///                      @p lcos were HPX_NULL or one was not supported
+int hpx_lco_wait_any(int n, hpx_addr_t lcos[], hpx_status_t *status)
+  HPX_PUBLIC;
+
+/// Get the value of any one of the LCOs.
+///
+/// The calling thread will block until at least one of the LCOs is available,
+/// and the value for that LCO will be written to its buffer in @p
+/// values. The buffers for the other LCOs will not be written to. Entries in
+/// @p lcos that are HPX_NULL will be ignored. LCOs without a monotonic
+/// triggered state are not supported, as for hpx_lco_wait_any().
+///
+/// @param             n the number of LCOs
+/// @param          lcos an array of @p n global LCO addresses
+/// @param         sizes an @p n element array of sizes that must correspond to
+///                      @p lcos and @p values
+/// @param[out]   values an array of @p n local buffers with sizes corresponding
+///                      to @p sizes
+/// @param[out]   status the status of the LCO that was set, pass NULL if the
+///                      status is not required
+///
+/// @returns             the index in @p lcos of the LCO that was read, or -1
+///                      with an HPX_ERROR status if all of the entries in
+///                      @p lcos were HPX_NULL or one was not supported
+int hpx_lco_get_any(int n, hpx_addr_t lcos[], size_t sizes[], void *values[],
+                    hpx_status_t *status)
+  HPX_PUBLIC;
+
 /// Get the size of an LCO.
 ///
 /// This may require communication.
@@ -335,6 +378,166 @@ void hpx_lco_sema_v_sync(hpx_addr_t sema)
 hpx_status_t hpx_lco_sema_p(hpx_addr_t sema)
   HPX_PUBLIC;
 
+/// Reader-writer locks allow either many readers or a single writer.
+/// @{
+
+/// Create a reader-writer lock.
+///
+/// Lock operations suspend the calling lightweight thread rather than
+/// spinning. Local locks are acquired directly, without sending a parcel.
+///
+/// @param writer_preference If non-zero, new readers wait behind any waiting
+///                          writer so that writers are not starved.
+///
+/// @returns The global address of the new lock.
+hpx_addr_t hpx_lco_rwlock_new(int writer_preference)
+  HPX_PUBLIC;
+
+/// Acquire a reader-writer lock in shared mode.
+///
+/// @param       rwlock The global address of the lock.
+///
+/// @returns            HPX_SUCCESS, or the lock's error code
+hpx_status_t hpx_lco_rwlock_rdlock(hpx_addr_t rwlock)
+  HPX_PUBLIC;
+
+/// Acquire a reader-writer lock in exclusive mode.
+///
+/// @param       rwlock The global address of the lock.
+///
+/// @returns            HPX_SUCCESS, or the lock's error code
+hpx_status_t hpx_lco_rwlock_wrlock(hpx_addr_t rwlock)
+  HPX_PUBLIC;
+
+/// Release a shared hold on a reader-writer lock.
+///
+/// This is locally asynchronous when the lock is remote.
+///
+/// @param       rwlock The global address of the lock.
+/// @param        rsync An LCO to set when the lock has been released.
+void hpx_lco_rwlock_rdunlock(hpx_addr_t rwlock, hpx_addr_t rsync)
+  HPX_PUBLIC;
+
+/// Release an exclusive hold on a reader-writer lock.
+///
+/// This is locally asynchronous when the lock is remote.
+///
+/// @param       rwlock The global address of the lock.
+/// @param        rsync An LCO to set when the lock has been released.
+void hpx_lco_rwlock_wrunlock(hpx_addr_t rwlock, hpx_addr_t rsync)
+  HPX_PUBLIC;
+/// @}
+
+/// Channels are bounded, multi-producer multi-consumer queues.
+/// @{
+
+/// Create a channel.
+///
+/// A channel holds up to @p capacity items of @p size bytes each. Senders
+/// suspend while the channel is full and receivers suspend while it is empty.
+///
+/// @param     capacity The number of items the channel can buffer (> 0).
+/// @param         size The size of each item in bytes.
+///
+/// @returns            The global address of the new channel.
+hpx_addr_t hpx_lco_chan_new(unsigned capacity, size_t size)
+  HPX_PUBLIC;
+
+/// Send @p n items to a channel.
+///
+/// The items are stored contiguously in @p values. Sends to a remote channel
+/// transfer all @p n items in a single parcel. The @p rsync LCO is set once
+/// all of the items have been inserted, or receives HPX_LCO_ERROR if the
+/// channel was closed first.
+///
+/// Only sends to a remote channel are asynchronous. When the channel is local
+/// the items are inserted directly, and the calling thread suspends while the
+/// channel is full.
+///
+/// @param         chan The global address of the channel.
+/// @param            n The number of items to send.
+/// @param         size The size of each item, must match the channel.
+/// @param       values The items to send.
+/// @param        lsync An LCO to set when @p values can be reused.
+/// @param        rsync An LCO to set when the items are in the channel.
+void hpx_lco_chan_send_n(hpx_addr_t chan, int n, size_t size,
+                         const void *values, hpx_addr_t lsync,
+                         hpx_addr_t rsync)
+  HPX_PUBLIC;
+
+/// Send one item to a channel.
+///
+/// @param         chan The global address of the channel.
+/// @param         size The size of the item, must match the channel.
+/// @param        value The item to send.
+/// @param        lsync An LCO to set when @p value can be reused.
+/// @param        rsync An LCO to set when the item is in the channel.
+void hpx_lco_chan_send(hpx_addr_t chan, size_t size, const void *value,
+                       hpx_addr_t lsync, hpx_addr_t rsync)
+  HPX_PUBLIC;
+
+/// Send one item to a channel, suspending until it has been inserted.
+///
+/// @param         chan The global address of the channel.
+/// @param         size The size of the item, must match the channel.
+/// @param        value The item to send.
+///
+/// @returns            HPX_SUCCESS, HPX_LCO_ERROR if the channel is closed, or
+///                     the channel's error code
+hpx_status_t hpx_lco_chan_send_sync(hpx_addr_t chan, size_t size,
+                                    const void *value)
+  HPX_PUBLIC;
+
+/// Receive one item from a channel, suspending while it is empty.
+///
+/// @param         chan The global address of the channel.
+/// @param         size The size of the item, must match the channel.
+/// @param[out]   value The received item.
+///
+/// @returns            HPX_SUCCESS, HPX_LCO_CHAN_EMPTY if the channel was
+///                     closed and drained, or the channel's error code
+hpx_status_t hpx_lco_chan_recv(hpx_addr_t chan, size_t size, void *value)
+  HPX_PUBLIC;
+
+/// Receive one item from a channel without waiting for a sender.
+///
+/// @param         chan The global address of the channel.
+/// @param         size The size of the item, must match the channel.
+/// @param[out]   value The received item.
+///
+/// @returns            HPX_SUCCESS, HPX_LCO_CHAN_EMPTY if the channel had no
+///                     items, or the channel's error code
+hpx_status_t hpx_lco_chan_try_recv(hpx_addr_t chan, size_t size, void *value)
+  HPX_PUBLIC;
+
+/// Receive up to @p n items from a channel.
+///
+/// This suspends until at least one item is available and then takes as many
+/// as are buffered, up to @p n. Receives from a remote channel return all of
+/// the items in a single parcel.
+///
+/// @param         chan The global address of the channel.
+/// @param            n The maximum number of items to receive.
+/// @param         size The size of each item, must match the channel.
+/// @param[out]  values A buffer for @p n items.
+/// @param[out]   count The number of items received (may be NULL).
+///
+/// @returns            HPX_SUCCESS, HPX_LCO_CHAN_EMPTY if the channel was
+///                     closed and drained, or the channel's error code
+hpx_status_t hpx_lco_chan_recv_n(hpx_addr_t chan, int n, size_t size,
+                                 void *values, int *count)
+  HPX_PUBLIC;
+
+/// Close a channel.
+///
+/// Blocked senders fail and blocked receivers drain the remaining items.
+///
+/// @param         chan The global address of the channel.
+/// @param        rsync An LCO to set when the channel is closed.
+void hpx_lco_chan_close(hpx_addr_t chan, hpx_addr_t rsync)
+  HPX_PUBLIC;
+/// @}
+
 /// An "and" LCO represents an AND gate.
 /// @{
 
@@ -420,9 +623,9 @@ hpx_addr_t hpx_lco_array_at(hpx_addr_t base, int i, size_t size)
 ///
 /// As an example, if there are typically three generations active (i.e.,
 /// threads may exist for up to three generations ahead of the current
-/// generation), then @p ninplace should be set to three. If it is set to two,
-/// then the runtime will perform some extra work testing threads that should
-/// not be tested.
+/// generation), then @p ninplace should be set to three. Threads waiting
+/// further ahead are kept ordered by generation, which costs a logarithmic
+/// insertion but still only wakes them when their generation arrives.
 ///
 /// @param ninplace the typical number of active generations
 ///
@@ -437,15 +640,27 @@ hpx_addr_t hpx_lco_gencount_new(unsigned long ninplace)
 void hpx_lco_gencount_inc(hpx_addr_t gencnt, hpx_addr_t rsync)
   HPX_PUBLIC;
 
+/// Increment the generation counter by more than one generation.
+///
+/// This is equivalent to calling hpx_lco_gencount_inc() @p n times, except
+/// that it is a single operation. Threads waiting for any of the skipped
+/// generations are woken.
+///
+/// @param gencnt the counter to increment
+/// @param      n the number of generations to advance
+/// @param  rsync The global address of an LCO signal remote completion.
+void hpx_lco_gencount_inc_by(hpx_addr_t gencnt, unsigned long n,
+                             hpx_addr_t rsync)
+  HPX_PUBLIC;
+
 /// Wait for the generation counter to reach a certain value.
 ///
 /// It is OK to wait for any generation. If the generation has already passed,
-/// this will probably not block. If the generation is far in the future (far in
-/// this case means more than the depth value provided in the counters
-/// allocator) then the thread may (transparently) wake up more often than it
-/// needs to.
+/// this will not block. A waiting thread is woken once the counter reaches
+/// any generation >= @p gen, which may happen in a single step when the
+/// counter is advanced with hpx_lco_gencount_inc_by().
 ///
-/// When this returns, it is guaranteed that the current count is <= @p gen, and
+/// When this returns, it is guaranteed that the current count is >= @p gen, and
 /// progress is guaranteed (that is, all threads waiting for @p gen will run in
 /// some bounded amount of time when the counter reaches @p gen).
 ///
@@ -456,6 +671,21 @@ void hpx_lco_gencount_inc(hpx_addr_t gencnt, hpx_addr_t rsync)
 hpx_status_t hpx_lco_gencount_wait(hpx_addr_t gencnt, unsigned long gen)
   HPX_PUBLIC;
 
+/// Wait for the generation counter to reach at least a certain value, and
+/// return the generation that was observed.
+///
+/// This is like hpx_lco_gencount_wait(), but also reports the generation,
+/// which may be later than @p gen, that satisfied the wait.
+///
+/// @param gencnt The counter to wait for.
+/// @param    gen The first generation to wait for.
+/// @param[out] current The generation when the wait completed, may be NULL.
+///
+/// @returns HPX_SUCCESS or an error code.
+hpx_status_t hpx_lco_gencount_wait_get(hpx_addr_t gencnt, unsigned long gen,
+                                       unsigned long *current)
+  HPX_PUBLIC;
+
 /// Allocate a new reduce LCO.
 ///
 /// The reduction is allocated in reduce-mode, i.e., it expects @p participants
@@ -251,6 +251,207 @@ int hpx_process_collective_allreduce_join(hpx_addr_t allreduce,
 //                                                void *out)
 //   HPX_PUBLIC;
 
+/// Allocate a locality-level collective communicator in the current process.
+///
+/// The communicator supports SPMD-style collectives with exactly one
+/// participant per locality. Every locality must call the same sequence of
+/// collective operations on the communicator. Operations are matched by their
+/// position in that sequence, so a locality may start an operation while
+/// earlier ones are still in flight, e.g., a persistent request started with
+/// hpx_process_request_start(), but the operations must be started in the
+/// same order everywhere.
+///
+/// @returns            The global address to use for the collective, or
+///                     HPX_NULL if there was an allocation problem.
+hpx_addr_t hpx_process_collective_new(void)
+  HPX_PUBLIC;
+
+/// Delete a process collective communicator.
+///
+/// This is not synchronized, so the caller must ensure that there are no
+/// active operations on the collective.
+///
+/// @param   collective The collective's address.
+void hpx_process_collective_delete(hpx_addr_t collective)
+  HPX_PUBLIC;
+
+/// Gather a value from every locality at every locality.
+///
+/// This uses a ring algorithm, so each locality sends and receives P - 1
+/// values regardless of the number of localities.
+///
+/// @param   collective The collective's address.
+/// @param        bytes The size of each locality's value in bytes.
+/// @param           in This locality's value.
+/// @param          out A buffer of HPX_LOCALITIES * @p bytes for the values,
+///                     ordered by locality rank.
+///
+/// @return             HPX_SUCCESS, or an error code if the operation fails.
+int hpx_process_allgather(hpx_addr_t collective, size_t bytes, const void *in,
+                          void *out)
+  HPX_PUBLIC;
+
+/// Reduce a value across localities, and deliver the result to every locality.
+///
+/// The values are reduced up a binomial tree and the result is broadcast back
+/// down it, in 2 * ceil(log2 P) communication steps.
+///
+/// @param   collective The collective's address.
+/// @param        bytes The size of the value in bytes.
+/// @param           in This locality's value.
+/// @param          out A buffer of @p bytes for the result, may alias @p in.
+/// @param           op The reduce operation.
+///
+/// @return             HPX_SUCCESS, or an error code if the operation fails.
+int hpx_process_allreduce(hpx_addr_t collective, size_t bytes, const void *in,
+                          void *out, hpx_action_t op)
+  HPX_PUBLIC;
+
+/// Exchange a distinct block between every pair of localities.
+///
+/// The i-th block of @p in at locality j is delivered to the j-th block of
+/// @p out at locality i. Blocks are exchanged directly between pairs of
+/// localities, so each locality only sends and receives its own P - 1 blocks.
+///
+/// @param   collective The collective's address.
+/// @param        bytes The size of a single block in bytes.
+/// @param           in A buffer of HPX_LOCALITIES * @p bytes to send.
+/// @param          out A buffer of HPX_LOCALITIES * @p bytes to receive into,
+///                     which must not overlap @p in.
+///
+/// @return             HPX_SUCCESS, or an error code if the operation fails.
+int hpx_process_alltoall(hpx_addr_t collective, size_t bytes, const void *in,
+                         void *out)
+  HPX_PUBLIC;
+
+/// Reduce a vector of values and scatter the result across localities.
+///
+/// Each locality provides one value for every locality, and locality i
+/// receives the reduction of all of the i-th values. This uses a ring
+/// algorithm, so each locality sends and receives P - 1 values.
+///
+/// @param   collective The collective's address.
+/// @param        bytes The size of a single value in bytes.
+/// @param           in A buffer of HPX_LOCALITIES * @p bytes input values.
+/// @param          out A buffer of @p bytes for the reduced value.
+/// @param           op The reduce operation.
+///
+/// @return             HPX_SUCCESS, or an error code if the operation fails.
+int hpx_process_reduce_scatter(hpx_addr_t collective, size_t bytes,
+                               const void *in, void *out, hpx_action_t op)
+  HPX_PUBLIC;
+
+/// Compute an inclusive prefix reduction over the localities.
+///
+/// Locality i receives the reduction of the values from localities 0 through
+/// i, in ceil(log2 P) communication steps.
+///
+/// @param   collective The collective's address.
+/// @param        bytes The size of the value in bytes.
+/// @param           in This locality's value.
+/// @param          out A buffer of @p bytes for the result, may alias @p in.
+/// @param           id An identity operation for the reduction type.
+/// @param           op The reduce operation.
+///
+/// @return             HPX_SUCCESS, or an error code if the operation fails.
+int hpx_process_scan(hpx_addr_t collective, size_t bytes, const void *in,
+                     void *out, hpx_action_t id, hpx_action_t op)
+  HPX_PUBLIC;
+
+/// Compute an exclusive prefix reduction over the localities.
+///
+/// This is like hpx_process_scan() except that locality i receives the
+/// reduction of the values from localities 0 through i - 1, and locality 0
+/// receives the identity.
+///
+/// @param   collective The collective's address.
+/// @param        bytes The size of the value in bytes.
+/// @param           in This locality's value.
+/// @param          out A buffer of @p bytes for the result, may alias @p in.
+/// @param           id An identity operation for the reduction type.
+/// @param           op The reduce operation.
+///
+/// @return             HPX_SUCCESS, or an error code if the operation fails.
+int hpx_process_exscan(hpx_addr_t collective, size_t bytes, const void *in,
+                       void *out, hpx_action_t id, hpx_action_t op)
+  HPX_PUBLIC;
+
+/// A persistent collective request.
+///
+/// Persistent requests bind a collective operation to its buffers once, and
+/// can then be started and completed many times, which lets iterative codes
+/// overlap computation with a collective without any per-iteration
+/// allocation. As with the blocking collectives, every locality must start
+/// the same sequence of operations on a collective, but a started operation
+/// runs asynchronously and later operations may be started before it
+/// completes.
+typedef struct hpx_process_request hpx_process_request_t;
+
+/// Create a persistent allreduce request.
+///
+/// The @p in and @p out buffers are used by every start of the request, and
+/// must stay valid until the request is freed.
+///
+/// @param   collective The collective's address.
+/// @param        bytes The size of the value in bytes.
+/// @param           in This locality's value.
+/// @param          out A buffer of @p bytes for the result, may alias @p in.
+/// @param           op The reduce operation.
+///
+/// @return             The request.
+hpx_process_request_t *hpx_process_allreduce_init(hpx_addr_t collective,
+                                                  size_t bytes, const void *in,
+                                                  void *out, hpx_action_t op)
+  HPX_PUBLIC;
+
+/// Create a persistent allgather request.
+///
+/// @param   collective The collective's address.
+/// @param        bytes The size of each locality's value in bytes.
+/// @param           in This locality's value.
+/// @param          out A buffer of HPX_LOCALITIES * @p bytes for the values.
+///
+/// @return             The request.
+hpx_process_request_t *hpx_process_allgather_init(hpx_addr_t collective,
+                                                  size_t bytes, const void *in,
+                                                  void *out)
+  HPX_PUBLIC;
+
+/// Start a persistent request.
+///
+/// The request must not already be active. The caller must not modify the
+/// input buffer or read the output buffer until the request completes.
+///
+/// @param      request The request to start.
+///
+/// @return             HPX_SUCCESS, or an error code if the start fails.
+int hpx_process_request_start(hpx_process_request_t *request)
+  HPX_PUBLIC;
+
+/// Check if a persistent request has completed, without blocking.
+///
+/// @param      request The request to test.
+///
+/// @return             true if the request is not active.
+int hpx_process_request_test(hpx_process_request_t *request)
+  HPX_PUBLIC;
+
+/// Wait for a persistent request to complete.
+///
+/// @param      request The request to wait for.
+///
+/// @return             HPX_SUCCESS, or an error code if the operation fails.
+int hpx_process_request_wait(hpx_process_request_t *request)
+  HPX_PUBLIC;
+
+/// Free a persistent request.
+///
+/// The request must not be active.
+///
+/// @param      request The request to free.
+void hpx_process_request_free(hpx_process_request_t *request)
+  HPX_PUBLIC;
+
 /// @}
 
 #ifdef __cplusplus
@@ -0,0 +1,34 @@
+// ==================================================================-*- C++ -*-
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifndef LIBHPX_NETWORK_PARCEL_LCO_OPS_H
+#define LIBHPX_NETWORK_PARCEL_LCO_OPS_H
+
+#include "libhpx/LCOOps.h"
+
+namespace libhpx {
+namespace network {
+/// Remote LCO operations implemented with request and reply parcels.
+///
+/// The waiting thread is suspended and its parcel is forwarded to the LCO, so
+/// these don't need any intermediate global allocation. This works over any
+/// network that can send parcels.
+class ParcelLCOOps : public virtual LCOOps {
+ public:
+  int wait(hpx_addr_t lco, int reset);
+  int get(hpx_addr_t lco, size_t n, void *to, int reset);
+};
+} // namespace network
+} // namespace libhpx
+
+#endif // LIBHPX_NETWORK_PARCEL_LCO_OPS_H
@@ -42,6 +42,23 @@ class ParcelOps {
   /// @returns  LIBHPX_OK The send was buffered successfully
   virtual int send(hpx_parcel_t* p, hpx_parcel_t* ssync) = 0;
 
+  /// Send a stack of parcels as the payload of a header parcel.
+  ///
+  /// The payload of the header @p p is ignored, and the receiver sees a parcel
+  /// whose payload holds the @p batch parcels laid out as in
+  /// parcel_batch_pack(). This transfers ownership of both the header and the
+  /// batch parcels. Networks that can gather the parcels directly from their
+  /// buffers override this, the default packs them into a new parcel and sends
+  /// that.
+  ///
+  /// @param            p The header parcel.
+  /// @param        batch The stack of parcels to send.
+  /// @param        ssync The local synchronization continuation.
+  ///
+  /// @returns  LIBHPX_OK The send was buffered successfully
+  virtual int sendBatch(hpx_parcel_t* p, hpx_parcel_t* batch,
+                        hpx_parcel_t* ssync);
+
   virtual void deallocate(const hpx_parcel_t* p) = 0;
 };
 }
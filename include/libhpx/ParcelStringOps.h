@@ -26,6 +26,8 @@ class ParcelStringOps : public virtual StringOps {
   void memput(hpx_addr_t dest, const void *src, size_t n, hpx_addr_t lsync, hpx_addr_t rsync);
   void memput(hpx_addr_t dest, const void *src, size_t n, hpx_addr_t rsync);
   void memput(hpx_addr_t dest, const void *src, size_t n);
+  void memgetv(const struct iovec *dest, hpx_addr_t src, const size_t *offsets, int n, hpx_addr_t lsync);
+  void memputv(hpx_addr_t dest, const size_t *offsets, const struct iovec *src, int n, hpx_addr_t lsync, hpx_addr_t rsync);
   void memcpy(hpx_addr_t dest, hpx_addr_t src, size_t n, hpx_addr_t sync);
   void memcpy(hpx_addr_t dest, hpx_addr_t src, size_t n);
 };
@@ -0,0 +1,105 @@
+// ==================================================================-*- C++ -*-
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifndef LIBHPX_NETWORK_SHARED_MEMORY_H
+#define LIBHPX_NETWORK_SHARED_MEMORY_H
+
+#include "libhpx/boot/Network.h"
+#include "hpx/hpx.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace libhpx {
+namespace network {
+/// A POSIX shared memory segment mapped by all of the localities.
+///
+/// Construction is collective over the bootstrap network, and fails unless all
+/// of the localities are on the same host. The segment is zero-filled, and the
+/// name is unlinked as soon as everyone has mapped it so that it can't leak.
+class SharedSegment {
+ public:
+  SharedSegment(const boot::Network& boot, size_t bytes, const char *tag);
+  ~SharedSegment();
+
+  char* base() const {
+    return base_;
+  }
+
+ private:
+  const size_t bytes_;
+  char         *base_;
+};
+
+/// A single-producer, single-consumer byte ring in shared memory.
+///
+/// The producer owns the tail and the consumer owns the head, and they live on
+/// separate cachelines so that the two sides don't false share. The data
+/// follows the ring in the segment, and a zero-filled ring is empty.
+class SharedRing {
+ public:
+  /// The bytes in the segment needed for a ring with @p capacity bytes, which
+  /// must be a power of two.
+  static constexpr size_t Bytes(size_t capacity) {
+    return sizeof(SharedRing) + capacity;
+  }
+
+  /// Write up to @p n bytes from @p from, and return the number of bytes
+  /// written.
+  size_t put(const void *from, size_t n, size_t capacity) {
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    uint64_t head = head_.load(std::memory_order_acquire);
+    n = std::min(n, capacity - size_t(tail - head));
+    size_t i = tail & (capacity - 1);
+    size_t first = std::min(n, capacity - i);
+    std::memcpy(data() + i, from, first);
+    std::memcpy(data(), static_cast<const char*>(from) + first, n - first);
+    tail_.store(tail + n, std::memory_order_release);
+    return n;
+  }
+
+  /// Read up to @p n bytes into @p to, and return the number of bytes read.
+  ///
+  /// If @p to is null the bytes are just skipped.
+  size_t get(void *to, size_t n, size_t capacity) {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    uint64_t tail = tail_.load(std::memory_order_acquire);
+    n = std::min(n, size_t(tail - head));
+    if (to) {
+      size_t i = head & (capacity - 1);
+      size_t first = std::min(n, capacity - i);
+      std::memcpy(to, data() + i, first);
+      std::memcpy(static_cast<char*>(to) + first, data(), n - first);
+    }
+    head_.store(head + n, std::memory_order_release);
+    return n;
+  }
+
+  /// The number of bytes that can currently be read.
+  size_t available() const {
+    return tail_.load(std::memory_order_acquire) -
+        head_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  char* data() {
+    return reinterpret_cast<char*>(this) + sizeof(*this);
+  }
+
+  alignas(HPX_CACHELINE_SIZE) std::atomic<uint64_t> head_;
+  alignas(HPX_CACHELINE_SIZE) std::atomic<uint64_t> tail_;
+};
+} // namespace network
+} // namespace libhpx
+
+#endif // LIBHPX_NETWORK_SHARED_MEMORY_H
@@ -18,6 +18,7 @@
 
 #include "hpx/hpx.h"
 #include <cstddef>
+#include <sys/uio.h>
 
 namespace libhpx {
 class StringOps {
@@ -98,6 +99,40 @@ class StringOps {
   /// @param            n The number of bytes to put.
   virtual void memput(hpx_addr_t dest, const void *src, size_t n) = 0;
 
+  /// The asynchronous vectored memget operation.
+  ///
+  /// This reads @p n pieces of the block at @p src into local buffers, where
+  /// piece @c i is @c dest[i].iov_len bytes at @c src + @c offsets[i]. All of
+  /// the pieces are transferred as a single operation, and @p lsync is set once
+  /// every local buffer has been written. The @p dest and @p offsets arrays are
+  /// not referenced after this returns.
+  ///
+  /// @param         dest The local buffers to memget into.
+  /// @param          src The global address of the block we're reading.
+  /// @param      offsets The offset of each piece within the block.
+  /// @param            n The number of pieces.
+  /// @param        lsync An LCO to set when all of @p dest has been written.
+  virtual void memgetv(const struct iovec *dest, hpx_addr_t src,
+                       const size_t *offsets, int n, hpx_addr_t lsync) = 0;
+
+  /// The asynchronous vectored memput operation.
+  ///
+  /// This writes @p n local buffers into the block at @p dest, where piece @c i
+  /// is written to @c dest + @c offsets[i]. The @p lsync LCO will be set when
+  /// it is safe to reuse the local buffers, and @p rsync will be set once all
+  /// of the pieces have been written. The @p offsets and @p src arrays are not
+  /// referenced after this returns.
+  ///
+  /// @param         dest The global address of the block we're writing.
+  /// @param      offsets The offset of each piece within the block.
+  /// @param          src The local buffers to put from.
+  /// @param            n The number of pieces.
+  /// @param        lsync An LCO to set when @p src has been read.
+  /// @param        rsync An LCO to set when all of the pieces are written.
+  virtual void memputv(hpx_addr_t dest, const size_t *offsets,
+                       const struct iovec *src, int n, hpx_addr_t lsync,
+                       hpx_addr_t rsync) = 0;
+
   /// The asynchronous memcpy operation.
   ///
   /// This will return immediately, and set the @p sync lco when the operation has
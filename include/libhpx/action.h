@@ -260,6 +260,20 @@ typedef struct {
 extern action_t actions[LIBHPX_ACTION_MAX] HPX_ALIGNED(HPX_PAGE_SIZE);
 /// @}
 
+/// The per-action coalescing limits.
+///
+/// The action table is read-only after hpx_init(), so the limits that
+/// hpx_action_set_coalescing() sets are kept in a separate table. A zero limit
+/// means that the runtime default applies.
+/// @{
+typedef struct {
+  uint32_t bytes;
+  uint32_t usecs;
+} action_coalescing_t;
+
+extern action_coalescing_t action_coalescing[LIBHPX_ACTION_MAX];
+/// @}
+
 #ifdef ENABLE_DEBUG
 void CHECK_ACTION(hpx_action_t id);
 #else
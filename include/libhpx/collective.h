@@ -19,6 +19,11 @@
 /// collective definitions/interfaces
 typedef enum {
   ALL_REDUCE = 1000 ,
+  ALL_GATHER,
+  REDUCE_SCATTER,
+  SCAN,
+  EXSCAN,
+  ALL_TO_ALL,
 } coll_type_t;
 
 typedef struct collective {
@@ -71,6 +71,7 @@ typedef enum {
   HPX_NETWORK_SMP,
   HPX_NETWORK_PWC,
   HPX_NETWORK_ISIR,
+  HPX_NETWORK_SHM,
   HPX_NETWORK_MAX
 } libhpx_network_t;
 
@@ -79,6 +80,7 @@ static const char * const HPX_NETWORK_TO_STRING[] = {
   "SMP",
   "PWC",
   "ISIR",
+  "SHM",
   "INVALID_ID"
 };
 
@@ -88,6 +90,7 @@ typedef enum {
   HPX_BOOT_SMP,              //!< Use the SMP bootstrapper.
   HPX_BOOT_MPI,              //!< Use mpirun to bootstrap HPX.
   HPX_BOOT_PMI,              //!< Use the PMI bootstrapper.
+  HPX_BOOT_TCP,              //!< Use the TCP bootstrapper.
   HPX_BOOT_MAX
 } libhpx_boot_t;
 
@@ -96,6 +99,7 @@ static const char* const HPX_BOOT_TO_STRING[] = {
   "SMP",
   "MPI",
   "PMI",
+  "TCP",
   "INVALID_ID"
 };
 
@@ -38,8 +38,24 @@ static const parcel_state_t          PARCEL_NESTED = UINT16_C(0x1 << 3);
 static const parcel_state_t PARCEL_BLOCK_ALLOCATED = UINT16_C(0x1 << 4);
 static const parcel_state_t          PARCEL_PINNED = UINT16_C(0x1 << 5);
 
-void parcel_pin(hpx_parcel_t *p);
-void parcel_nest(hpx_parcel_t *p);
+/// The alignment of parcels nested in the payload of a batch parcel.
+static const uint32_t PARCEL_BATCH_ALIGN = 16;
+
+/// The largest batch, so that nested parcel offsets fit in the offset field.
+static const uint32_t PARCEL_BATCH_MAX = UINT16_MAX * PARCEL_BATCH_ALIGN;
+
+/// Pin a parcel for the @p nested parcels in its payload.
+///
+/// A pinned parcel is freed by the last of its own deletion and the deletions
+/// of its nested parcels. The count of remaining owners is kept in the offset
+/// field.
+void parcel_pin(hpx_parcel_t *p, uint16_t nested = 1);
+
+/// Nest a parcel in the payload of @p parent.
+///
+/// The parcel's offset field records its position in the parent's payload, and
+/// deleting the parcel deletes the pinned parent.
+void parcel_nest(hpx_parcel_t *parent, hpx_parcel_t *p);
 void parcel_retain(hpx_parcel_t *p);
 void parcel_release(hpx_parcel_t *p);
 
@@ -73,7 +89,7 @@ struct hpx_parcel {
   uint32_t            src;         //!< The src rank for the parcel.
   uint32_t           size;         //!< The data size in bytes.
   parcel_state_t    state;         //!< The parcel's state bits.
-  uint16_t         offset;         //!< Reserved for future use.
+  uint16_t         offset;         //!< Nested position or pinned owners.
   hpx_action_t     action;         //!< The target action identifier.
   hpx_action_t   c_action;         //!< The continuation action identifier.
   hpx_addr_t       target;         //!< The target address for parcel_send().
@@ -179,6 +195,19 @@ static inline uint32_t parcel_payload_size(const hpx_parcel_t *p) {
   return p->size;
 }
 
+/// The number of bytes that a parcel occupies in a batch, with its padding.
+static inline uint32_t parcel_batch_size(const hpx_parcel_t *p) {
+  uint32_t n = parcel_size(p);
+  return n + (PARCEL_BATCH_ALIGN - n % PARCEL_BATCH_ALIGN) % PARCEL_BATCH_ALIGN;
+}
+
+/// Copy a stack of parcels into the payload of a batch parcel.
+///
+/// The parcels are laid out in stack order, each padded to
+/// PARCEL_BATCH_ALIGN, and are deleted after they are copied. Networks that
+/// can gather the batch directly use the same layout.
+void parcel_batch_pack(hpx_parcel_t *p, hpx_parcel_t *batch);
+
 void parcel_prepare(hpx_parcel_t *p)
   HPX_NON_NULL(1);
 
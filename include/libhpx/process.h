@@ -24,6 +24,12 @@ extern "C" {
 int process_recover_credit(hpx_parcel_t *p)
   HPX_NON_NULL(1);
 
+/// Get the fan-out of the spanning trees used by process collectives.
+///
+/// This is the configured collective radix, where a radix smaller than two
+/// selects a flat tree in which the root is the parent of every rank.
+unsigned process_tree_arity(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,7 @@
 #include "libhpx/MemoryOps.h"
 #include "libhpx/ParcelOps.h"
 #include "libhpx/StringOps.h"
+#include "libhpx/parcel.h"
 
 libhpx::CollectiveOps::~CollectiveOps()
 {
@@ -39,6 +40,21 @@ libhpx::ParcelOps::~ParcelOps()
 {
 }
 
+int
+libhpx::ParcelOps::sendBatch(hpx_parcel_t* p, hpx_parcel_t* batch,
+                             hpx_parcel_t* ssync)
+{
+  uint32_t bytes = 0;
+  for (auto q = batch; q; q = q->next) {
+    bytes += parcel_batch_size(q);
+  }
+  auto fat = parcel_new(p->target, p->action, p->c_target, p->c_action, p->pid,
+                        nullptr, bytes);
+  parcel_batch_pack(fat, batch);
+  parcel_delete(p);
+  return send(fat, ssync);
+}
+
 libhpx::StringOps::~StringOps()
 {
 }
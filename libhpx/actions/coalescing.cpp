@@ -0,0 +1,33 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <hpx/hpx.h>
+#include <libhpx/action.h>
+#include <libhpx/debug.h>
+
+action_coalescing_t action_coalescing[LIBHPX_ACTION_MAX];
+
+int hpx_action_set_coalescing(hpx_action_t id, uint32_t bytes, uint32_t usecs) {
+  CHECK_ACTION(id);
+  if (!action_is_coalesced(id)) {
+    log_error("action %s is not coalesced\n", actions[id].key);
+    return HPX_ERROR;
+  }
+  __atomic_store_n(&action_coalescing[id].bytes, bytes, __ATOMIC_RELAXED);
+  __atomic_store_n(&action_coalescing[id].usecs, usecs, __ATOMIC_RELAXED);
+  return HPX_SUCCESS;
+}
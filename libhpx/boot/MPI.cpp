@@ -22,7 +22,7 @@ namespace {
 using MPINetwork = libhpx::boot::MPI;
 }
 
-MPINetwork::MPI() : libhpx::boot::Network(), comm_(), finalizeMPI_(0)
+MPINetwork::MPI(int level) : libhpx::boot::Network(), comm_(), finalizeMPI_(0)
 {
   int init;
   if (MPI_Initialized(&init)) {
@@ -30,16 +30,16 @@ MPINetwork::MPI() : libhpx::boot::Network(), comm_(), finalizeMPI_(0)
   }
 
   if (!init) {
-    int level = MPI_THREAD_SINGLE;
-    if (MPI_Init_thread(NULL, NULL, THREAD_LEVEL, &level)) {
+    int provided = MPI_THREAD_SINGLE;
+    if (MPI_Init_thread(NULL, NULL, level, &provided)) {
       throw log_error("mpi initialization failed\n");
     }
 
     finalizeMPI_ = 1;
 
-    if (level != THREAD_LEVEL) {
+    if (provided < level) {
       throw log_error("MPI thread level failed requested %d, received %d.\n",
-                      THREAD_LEVEL, level);
+                      level, provided);
     }
   }
 
@@ -39,25 +39,40 @@ BootNetwork::abort() const
   unreachable();
 }
 
+#ifdef HAVE_MPI
+/// The ISIR network needs full MPI thread support when workers use MPI
+/// concurrently.
+static int
+_MPILevel(const config_t *cfg)
+{
+  return (cfg->isir_multiple) ? MPI_THREAD_MULTIPLE : MPI_THREAD_SERIALIZED;
+}
+#endif
+
 static BootNetwork*
-_Default()
+_Default(const config_t *cfg)
 {
+  // A local launcher tells us where to find the other ranks.
+  if (std::getenv("HPX_TCP_ROOT")) {
+    return new libhpx::boot::TCP();
+  }
+
 #ifdef HAVE_PMI
   return new libhpx::boot::PMI();
 #endif
 
 #ifdef HAVE_MPI
-  return new libhpx::boot::MPI();
+  return new libhpx::boot::MPI(_MPILevel(cfg));
 #endif
 
   return new SMP();
 }
 
 BootNetwork*
-BootNetwork::Create(libhpx_boot_t type)
+BootNetwork::Create(const config_t *cfg)
 {
   BootNetwork* boot = nullptr;
-  switch (type) {
+  switch (cfg->boot) {
    case (HPX_BOOT_PMI):
 #ifdef HAVE_PMI
     boot = new libhpx::boot::PMI();
@@ -69,13 +84,18 @@ BootNetwork::Create(libhpx_boot_t type)
 
    case (HPX_BOOT_MPI):
 #ifdef HAVE_MPI
-    boot = new libhpx::boot::MPI();
+    boot = new libhpx::boot::MPI(_MPILevel(cfg));
     log_boot("initialized mpirun bootstrapper.\n");
 #else
     dbg_error("MPI bootstrap not supported in current configuration.\n");
 #endif
     break;
 
+   case (HPX_BOOT_TCP):
+    boot = new libhpx::boot::TCP();
+    log_boot("initialized the TCP bootstrapper.\n");
+    break;
+
    case (HPX_BOOT_SMP):
     boot = new libhpx::boot::SMP();
     log_boot("initialized the SMP bootstrapper.\n");
@@ -83,12 +103,12 @@ BootNetwork::Create(libhpx_boot_t type)
 
    case HPX_BOOT_DEFAULT:
    default:
-    boot = _Default();
+    boot = _Default(cfg);
     break;
   }
 
   if (!boot) {
-    boot = _Default();
+    boot = _Default(cfg);
   }
 
   if (!boot) {
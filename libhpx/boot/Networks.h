@@ -20,6 +20,7 @@
 #ifdef HAVE_MPI
 #include <mpi.h>
 #endif
+#include <vector>
 
 namespace libhpx {
 namespace boot {
@@ -39,12 +40,41 @@ class SMP final : public Network {
   void alltoall(void * dest, const void * src, int n, int stride) const;
 };
 
+/// A bootstrapper for processes started without a job launcher.
+///
+/// The processes find each other through the HPX_TCP_RANK, HPX_TCP_RANKS and
+/// HPX_TCP_ROOT (host:port) environment variables, which a launcher like
+/// scripts/hpxrun-local sets. Every rank connects to rank 0, which listens on
+/// the root port and relays all of the collective operations.
+class TCP final : public Network {
+ public:
+  TCP();
+  ~TCP();
+
+  libhpx_boot_t type() const {
+    return HPX_BOOT_TCP;
+  }
+
+  void barrier() const;
+  void allgather(const void* src, void* dest, int n) const;
+  void alltoall(void * dest, const void * src, int n, int stride) const;
+
+ private:
+  /// Gather @p n bytes from every rank at the root and send the result back.
+  void exchange(const void *src, void *dest, size_t n) const;
+
+  static void Write(int fd, const void *src, size_t n);
+  static void Read(int fd, void *dest, size_t n);
+
+  int                root_;                 // our socket to the root
+  std::vector<int>  peers_;                 // the root's socket to each rank
+};
+
 #ifdef HAVE_MPI
 class MPI final : public Network {
-  static constexpr int THREAD_LEVEL = MPI_THREAD_SERIALIZED;
-
  public:
-  MPI();
+  /// Initialize MPI, if necessary, with at least the requested thread level.
+  MPI(int level);
   ~MPI();
 
   libhpx_boot_t type() const {
@@ -0,0 +1,237 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "Networks.h"
+#include "libhpx/debug.h"
+#include "libhpx/util/Env.h"
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+using libhpx::boot::TCP;
+using libhpx::util::getEnv;
+
+/// How long a rank keeps trying to reach the root before giving up.
+constexpr int CONNECT_ATTEMPTS = 300;
+constexpr useconds_t CONNECT_DELAY = 100000;
+
+/// Split the HPX_TCP_ROOT host:port string.
+void
+_parse_root(const std::string& root, std::string& host, std::string& port)
+{
+  auto colon = root.rfind(':');
+  if (colon == std::string::npos) {
+    dbg_error("HPX_TCP_ROOT must be host:port (given %s)\n", root.c_str());
+  }
+  host = root.substr(0, colon);
+  port = root.substr(colon + 1);
+}
+
+/// Listen on the root's address, so that the bootstrap port is only reachable
+/// where the other ranks were told to find it.
+int
+_listen(const std::string& host, const std::string& port, int backlog)
+{
+  struct addrinfo hints, *info;
+  std::memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+  if (int e = getaddrinfo(host.c_str(), port.c_str(), &hints, &info)) {
+    dbg_error("could not resolve %s (%s)\n", host.c_str(), gai_strerror(e));
+  }
+
+  int fd = socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+  int one = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  if (bind(fd, info->ai_addr, info->ai_addrlen) || listen(fd, backlog)) {
+    dbg_error("could not listen on %s:%s (%s)\n", host.c_str(), port.c_str(),
+              strerror(errno));
+  }
+  freeaddrinfo(info);
+  return fd;
+}
+
+int
+_connect(const std::string& host, const std::string& port)
+{
+  struct addrinfo hints, *info;
+  std::memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+  if (int e = getaddrinfo(host.c_str(), port.c_str(), &hints, &info)) {
+    dbg_error("could not resolve %s (%s)\n", host.c_str(), gai_strerror(e));
+  }
+
+  // The root might not be listening yet, so retry for a while.
+  int fd = -1;
+  for (int i = 0; i < CONNECT_ATTEMPTS; ++i) {
+    fd = socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+    if (!connect(fd, info->ai_addr, info->ai_addrlen)) {
+      break;
+    }
+    close(fd);
+    fd = -1;
+    usleep(CONNECT_DELAY);
+  }
+  freeaddrinfo(info);
+
+  if (fd < 0) {
+    dbg_error("could not connect to %s:%s\n", host.c_str(), port.c_str());
+  }
+  return fd;
+}
+}
+
+TCP::TCP() : Network(), root_(-1), peers_()
+{
+  std::string host, port;
+  try {
+    rank_ = getEnv<int>("HPX_TCP_RANK");
+    nRanks_ = getEnv<int>("HPX_TCP_RANKS");
+    _parse_root(getEnv<std::string>("HPX_TCP_ROOT"), host, port);
+  }
+  catch (const libhpx::util::NotFound&) {
+    dbg_error("the TCP bootstrapper requires HPX_TCP_RANK, HPX_TCP_RANKS, "
+              "and HPX_TCP_ROOT\n");
+  }
+
+  if (rank_ < 0 || nRanks_ <= rank_) {
+    dbg_error("invalid TCP rank %d of %d\n", rank_, nRanks_);
+  }
+
+  if (rank_ != 0) {
+    root_ = _connect(host, port);
+    Write(root_, &rank_, sizeof(rank_));
+    return;
+  }
+
+  // The root accepts a connection from every other rank, which identify
+  // themselves with their rank.
+  peers_.resize(nRanks_, -1);
+  int fd = _listen(host, port, nRanks_);
+  for (int i = 1; i < nRanks_; ++i) {
+    int peer = accept(fd, nullptr, nullptr);
+    if (peer < 0) {
+      dbg_error("accept failed during bootstrap (%s)\n", strerror(errno));
+    }
+    int rank;
+    Read(peer, &rank, sizeof(rank));
+    if (rank <= 0 || nRanks_ <= rank || peers_[rank] >= 0) {
+      dbg_error("unexpected rank %d during bootstrap\n", rank);
+    }
+    peers_[rank] = peer;
+  }
+  close(fd);
+}
+
+TCP::~TCP()
+{
+  if (root_ >= 0) {
+    close(root_);
+  }
+  for (int fd : peers_) {
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+}
+
+void
+TCP::Write(int fd, const void *src, size_t n)
+{
+  auto bytes = static_cast<const char*>(src);
+  while (n) {
+    ssize_t e = write(fd, bytes, n);
+    if (e < 0 && errno == EINTR) {
+      continue;
+    }
+    if (e <= 0) {
+      dbg_error("bootstrap write failed (%s)\n", strerror(errno));
+    }
+    bytes += e;
+    n -= e;
+  }
+}
+
+void
+TCP::Read(int fd, void *dest, size_t n)
+{
+  auto bytes = static_cast<char*>(dest);
+  while (n) {
+    ssize_t e = read(fd, bytes, n);
+    if (e < 0 && errno == EINTR) {
+      continue;
+    }
+    if (e <= 0) {
+      dbg_error("bootstrap read failed (%s)\n", strerror(errno));
+    }
+    bytes += e;
+    n -= e;
+  }
+}
+
+void
+TCP::exchange(const void *src, void *dest, size_t n) const
+{
+  auto out = static_cast<char*>(dest);
+  if (rank_ != 0) {
+    Write(root_, src, n);
+    Read(root_, out, nRanks_ * n);
+    return;
+  }
+
+  std::memcpy(out, src, n);
+  for (int i = 1; i < nRanks_; ++i) {
+    Read(peers_[i], out + i * n, n);
+  }
+  for (int i = 1; i < nRanks_; ++i) {
+    Write(peers_[i], out, nRanks_ * n);
+  }
+}
+
+void
+TCP::barrier() const
+{
+  char in = 0;
+  std::vector<char> out(nRanks_);
+  exchange(&in, &out[0], sizeof(in));
+}
+
+void
+TCP::allgather(const void* src, void* dest, int n) const
+{
+  exchange(src, dest, n);
+}
+
+void
+TCP::alltoall(void* dest, const void* src, int n, int stride) const
+{
+  // Bootstrap data is small, so we just allgather everyone's whole send buffer
+  // and pick out our blocks.
+  size_t span = (nRanks_ - 1) * stride + n;
+  std::vector<char> all(nRanks_ * span);
+  exchange(src, &all[0], span);
+  for (int i = 0; i < nRanks_; ++i) {
+    std::memcpy(static_cast<char*>(dest) + i * stride,
+                &all[i * span + rank_ * stride], n);
+  }
+}
@@ -570,6 +570,50 @@ AGAS::memget(void *to, hpx_addr_t from, size_t n)
   }
 }
 
+void
+AGAS::memgetv(const struct iovec *to, hpx_addr_t from, const size_t *offsets,
+              int n, hpx_addr_t lsync)
+{
+  void *lfrom;
+  if (!n) {
+    hpx_lco_set(lsync, 0, NULL, HPX_NULL, HPX_NULL);
+  }
+  else if (!tryPin(from, &lfrom)) {
+    here->net->memgetv(to, from, offsets, n, lsync);
+  }
+  else {
+    for (int i = 0; i < n; ++i) {
+      auto piece = static_cast<const char*>(lfrom) + offsets[i];
+      std::memcpy(to[i].iov_base, piece, to[i].iov_len);
+    }
+    unpin(from);
+    hpx_lco_set(lsync, 0, NULL, HPX_NULL, HPX_NULL);
+  }
+}
+
+void
+AGAS::memputv(hpx_addr_t to, const size_t *offsets, const struct iovec *from,
+              int n, hpx_addr_t lsync, hpx_addr_t rsync)
+{
+  void *lto;
+  if (!n) {
+    hpx_lco_set(lsync, 0, NULL, HPX_NULL, HPX_NULL);
+    hpx_lco_set(rsync, 0, NULL, HPX_NULL, HPX_NULL);
+  }
+  else if (!tryPin(to, &lto)) {
+    here->net->memputv(to, offsets, from, n, lsync, rsync);
+  }
+  else {
+    for (int i = 0; i < n; ++i) {
+      auto piece = static_cast<char*>(lto) + offsets[i];
+      std::memcpy(piece, from[i].iov_base, from[i].iov_len);
+    }
+    unpin(to);
+    hpx_lco_set(lsync, 0, NULL, HPX_NULL, HPX_NULL);
+    hpx_lco_set(rsync, 0, NULL, HPX_NULL, HPX_NULL);
+  }
+}
+
 void
 AGAS::memcpy(hpx_addr_t to, hpx_addr_t from, size_t size, hpx_addr_t sync)
 {
@@ -0,0 +1,225 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+/// @file libhpx/gas/atomics.cpp
+/// @brief Implements atomic operations on global addresses.
+///
+/// An operation on a word that we can pin is performed directly. Otherwise we
+/// send a single parcel for a pinned interrupt action, which performs the
+/// operation on the target without spawning a thread and continues the old
+/// value. Batched updates don't return values, so their action is coalesced
+/// and streams of updates to the same locality can share messages.
+
+#include "libhpx/action.h"
+#include "libhpx/debug.h"
+#include "hpx/hpx.h"
+#include <vector>
+
+namespace {
+/// The compare-and-swap operation, which isn't part of the public operation
+/// enumeration because it takes two operands.
+constexpr int CAS = -1;
+
+/// Check that @p op is one of the public operations.
+bool
+IsValid(int op)
+{
+  return (HPX_GAS_ATOMIC_ADD <= op && op <= HPX_GAS_ATOMIC_MAX);
+}
+
+int64_t
+Apply(int64_t *word, int op, int64_t value, int64_t compare)
+{
+  dbg_assert(((uintptr_t)word & (sizeof(*word) - 1)) == 0);
+
+  int64_t old;
+  switch (op) {
+   case CAS:
+    old = compare;
+    __atomic_compare_exchange_n(word, &old, value, false, __ATOMIC_ACQ_REL,
+                                __ATOMIC_ACQUIRE);
+    return old;
+   case HPX_GAS_ATOMIC_ADD:
+    return __atomic_fetch_add(word, value, __ATOMIC_ACQ_REL);
+   case HPX_GAS_ATOMIC_AND:
+    return __atomic_fetch_and(word, value, __ATOMIC_ACQ_REL);
+   case HPX_GAS_ATOMIC_OR:
+    return __atomic_fetch_or(word, value, __ATOMIC_ACQ_REL);
+   case HPX_GAS_ATOMIC_XOR:
+    return __atomic_fetch_xor(word, value, __ATOMIC_ACQ_REL);
+   case HPX_GAS_ATOMIC_MIN:
+    old = __atomic_load_n(word, __ATOMIC_ACQUIRE);
+    while (value < old &&
+           !__atomic_compare_exchange_n(word, &old, value, true,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+    }
+    return old;
+   case HPX_GAS_ATOMIC_MAX:
+    old = __atomic_load_n(word, __ATOMIC_ACQUIRE);
+    while (old < value &&
+           !__atomic_compare_exchange_n(word, &old, value, true,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+    }
+    return old;
+  }
+  dbg_error("unknown atomic operation %d\n", op);
+}
+
+int
+FetchHandler(int64_t *word, int op, int64_t value, int64_t compare)
+{
+  int64_t old = Apply(word, op, value, compare);
+  return HPX_THREAD_CONTINUE(old);
+}
+LIBHPX_ACTION(HPX_INTERRUPT, HPX_PINNED, Fetch, FetchHandler, HPX_POINTER,
+              HPX_INT, HPX_SINT64, HPX_SINT64);
+
+int
+UpdateHandler(int64_t *word, int op, int64_t value)
+{
+  Apply(word, op, value, 0);
+  return HPX_SUCCESS;
+}
+LIBHPX_ACTION(HPX_INTERRUPT, HPX_PINNED | HPX_COALESCED, Update,
+              UpdateHandler, HPX_POINTER, HPX_INT, HPX_SINT64);
+
+/// Perform an operation and set @p result to the old value.
+int
+Execute(hpx_addr_t addr, int op, int64_t value, int64_t compare,
+        hpx_addr_t result)
+{
+  int64_t *word;
+  if (hpx_gas_try_pin(addr, (void**)&word)) {
+    int64_t old = Apply(word, op, value, compare);
+    hpx_gas_unpin(addr);
+    hpx_lco_set_lsync(result, sizeof(old), &old, HPX_NULL);
+    return HPX_SUCCESS;
+  }
+  hpx_action_t set = hpx_lco_set_action;
+  return action_call_lsync(Fetch, addr, result, set, 3, &op, &value, &compare);
+}
+
+/// Perform an operation and return the old value.
+int64_t
+ExecuteSync(hpx_addr_t addr, int op, int64_t value, int64_t compare)
+{
+  int64_t *word;
+  if (hpx_gas_try_pin(addr, (void**)&word)) {
+    int64_t old = Apply(word, op, value, compare);
+    hpx_gas_unpin(addr);
+    return old;
+  }
+  // There is no way to return an error along with the old value, so a failed
+  // send is fatal.
+  int64_t old;
+  if (int e = action_call_rsync(Fetch, addr, &old, sizeof(old), 3, &op, &value,
+                                &compare)) {
+    dbg_error("failed to send atomic operation %d (%d)\n", op, e);
+  }
+  return old;
+}
+}
+
+int
+hpx_gas_atomic_fetch(hpx_addr_t addr, hpx_gas_atomic_op_t op, int64_t value,
+                     hpx_addr_t result)
+{
+  if (!IsValid(op)) {
+    log_error("unknown atomic operation %d\n", op);
+    return HPX_ERROR;
+  }
+  return Execute(addr, op, value, 0, result);
+}
+
+int64_t
+hpx_gas_atomic_fetch_sync(hpx_addr_t addr, hpx_gas_atomic_op_t op,
+                          int64_t value)
+{
+  if (!IsValid(op)) {
+    dbg_error("unknown atomic operation %d\n", op);
+  }
+  return ExecuteSync(addr, op, value, 0);
+}
+
+int
+hpx_gas_atomic_cas(hpx_addr_t addr, int64_t expected, int64_t desired,
+                   hpx_addr_t result)
+{
+  return Execute(addr, CAS, desired, expected, result);
+}
+
+int64_t
+hpx_gas_atomic_cas_sync(hpx_addr_t addr, int64_t expected, int64_t desired)
+{
+  return ExecuteSync(addr, CAS, desired, expected);
+}
+
+/// Apply a batch of updates.
+///
+/// We perform the updates to words that we can pin right away, and send one
+/// coalesced parcel for each of the rest. The remote updates all signal a
+/// single and gate, which sets @p rsync and then deletes itself.
+int
+hpx_gas_atomic_batch(hpx_gas_atomic_op_t op, int n, const hpx_addr_t *addrs,
+                     const int64_t *values, hpx_addr_t rsync)
+{
+  if (!IsValid(op)) {
+    log_error("unknown atomic operation %d\n", op);
+    return HPX_ERROR;
+  }
+
+  std::vector<int> remote;
+  for (int i = 0; i < n; ++i) {
+    int64_t *word;
+    if (hpx_gas_try_pin(addrs[i], (void**)&word)) {
+      Apply(word, op, values[i], 0);
+      hpx_gas_unpin(addrs[i]);
+    }
+    else {
+      remote.push_back(i);
+    }
+  }
+
+  if (remote.empty()) {
+    hpx_lco_set(rsync, 0, NULL, HPX_NULL, HPX_NULL);
+    return HPX_SUCCESS;
+  }
+
+  hpx_addr_t gate = HPX_NULL;
+  if (rsync) {
+    gate = hpx_lco_and_new(remote.size());
+    dbg_check( hpx_call_when_with_continuation(gate, rsync, hpx_lco_set_action,
+                                               gate, hpx_lco_delete_action,
+                                               NULL, 0) );
+  }
+
+  // If a send fails we signal the slots for the updates we didn't send, so that
+  // the gate still sets @p rsync and deletes itself.
+  hpx_action_t set = hpx_lco_set_action;
+  int o = op;
+  for (size_t k = 0; k < remote.size(); ++k) {
+    int i = remote[k];
+    if (int e = action_call_lsync(Update, addrs[i], gate, set, 2, &o,
+                                  &values[i])) {
+      if (gate) {
+        hpx_lco_and_set_num(gate, remote.size() - k, HPX_NULL);
+      }
+      return e;
+    }
+  }
+  return HPX_SUCCESS;
+}
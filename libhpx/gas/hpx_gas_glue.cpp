@@ -25,6 +25,7 @@
 #include "hpx/hpx.h"
 #include <cinttypes>
 #include <cstdlib>
+#include <vector>
 
 uint64_t HPX_GAS_BLOCK_BYTES_MAX;
 
@@ -328,6 +329,63 @@ hpx_gas_memput_rsync(hpx_addr_t to, const void *from, size_t size)
   return HPX_SUCCESS;
 }
 
+int
+hpx_gas_memget_indexed(const struct iovec *to, hpx_addr_t from,
+                       const size_t *offsets, int n, hpx_addr_t lsync)
+{
+  dbg_assert(here && here->gas);
+  dbg_assert(n >= 0);
+  here->gas->memgetv(to, from, offsets, n, lsync);
+  return HPX_SUCCESS;
+}
+
+int
+hpx_gas_memput_indexed(hpx_addr_t to, const size_t *offsets,
+                       const struct iovec *from, int n, hpx_addr_t lsync,
+                       hpx_addr_t rsync)
+{
+  dbg_assert(here && here->gas);
+  dbg_assert(n >= 0);
+  here->gas->memputv(to, offsets, from, n, lsync, rsync);
+  return HPX_SUCCESS;
+}
+
+/// The strided operations are lowered to the indexed form, which copies the
+/// descriptors before returning.
+/// @{
+int
+hpx_gas_memget_strided(void *to, size_t to_stride, hpx_addr_t from,
+                       size_t from_stride, size_t bytes, int count,
+                       hpx_addr_t lsync)
+{
+  std::vector<struct iovec> iov(count);
+  std::vector<size_t> offsets(count);
+  for (int i = 0; i < count; ++i) {
+    iov[i].iov_base = static_cast<char*>(to) + i * to_stride;
+    iov[i].iov_len = bytes;
+    offsets[i] = i * from_stride;
+  }
+  return hpx_gas_memget_indexed(iov.data(), from, offsets.data(), count, lsync);
+}
+
+int
+hpx_gas_memput_strided(hpx_addr_t to, size_t to_stride, const void *from,
+                       size_t from_stride, size_t bytes, int count,
+                       hpx_addr_t lsync, hpx_addr_t rsync)
+{
+  std::vector<struct iovec> iov(count);
+  std::vector<size_t> offsets(count);
+  for (int i = 0; i < count; ++i) {
+    auto piece = static_cast<const char*>(from) + i * from_stride;
+    iov[i].iov_base = const_cast<char*>(piece);
+    iov[i].iov_len = bytes;
+    offsets[i] = i * to_stride;
+  }
+  return hpx_gas_memput_indexed(to, offsets.data(), iov.data(), count, lsync,
+                                rsync);
+}
+/// @}
+
 int
 hpx_gas_memcpy(hpx_addr_t to, hpx_addr_t from, size_t size, hpx_addr_t sync)
 {
@@ -309,3 +309,43 @@ PGAS::memget(void *to, hpx_addr_t from, size_t n)
     }
   }
 }
+
+void
+PGAS::memgetv(const struct iovec *to, hpx_addr_t from, const size_t *offsets,
+              int n, hpx_addr_t lsync)
+{
+  if (!n) {
+    hpx_lco_error(lsync, HPX_SUCCESS, HPX_NULL);
+  }
+  else if (gpa_to_rank(from) == here->rank) {
+    auto lfrom = static_cast<const char*>(gpaToLVA(from));
+    for (int i = 0; i < n; ++i) {
+      std::memcpy(to[i].iov_base, lfrom + offsets[i], to[i].iov_len);
+    }
+    hpx_lco_error(lsync, HPX_SUCCESS, HPX_NULL);
+  }
+  else {
+    here->net->memgetv(to, from, offsets, n, lsync);
+  }
+}
+
+void
+PGAS::memputv(hpx_addr_t to, const size_t *offsets, const struct iovec *from,
+              int n, hpx_addr_t lsync, hpx_addr_t rsync)
+{
+  if (!n) {
+    hpx_lco_error(lsync, HPX_SUCCESS, HPX_NULL);
+    hpx_lco_error(rsync, HPX_SUCCESS, HPX_NULL);
+  }
+  else if (gpa_to_rank(to) == here->rank) {
+    auto lto = static_cast<char*>(gpaToLVA(to));
+    for (int i = 0; i < n; ++i) {
+      std::memcpy(lto + offsets[i], from[i].iov_base, from[i].iov_len);
+    }
+    hpx_lco_error(lsync, HPX_SUCCESS, HPX_NULL);
+    hpx_lco_error(rsync, HPX_SUCCESS, HPX_NULL);
+  }
+  else {
+    here->net->memputv(to, offsets, from, n, lsync, rsync);
+  }
+}
@@ -106,6 +106,25 @@ class SMP : public GAS {
     copy(ToLVA(dest), src, n);
   }
 
+  void memgetv(const struct iovec *dest, hpx_addr_t src, const size_t *offsets,
+               int n, hpx_addr_t lsync) {
+    auto lsrc = static_cast<const char*>(ToLVA(src));
+    for (int i = 0; i < n; ++i) {
+      copy(dest[i].iov_base, lsrc + offsets[i], dest[i].iov_len);
+    }
+    hpx_lco_error(lsync, HPX_SUCCESS, HPX_NULL);
+  }
+
+  void memputv(hpx_addr_t dest, const size_t *offsets, const struct iovec *src,
+               int n, hpx_addr_t lsync, hpx_addr_t rsync) {
+    auto ldest = static_cast<char*>(ToLVA(dest));
+    for (int i = 0; i < n; ++i) {
+      copy(ldest + offsets[i], src[i].iov_base, src[i].iov_len);
+    }
+    hpx_lco_error(lsync, HPX_SUCCESS, HPX_NULL);
+    hpx_lco_error(rsync, HPX_SUCCESS, HPX_NULL);
+  }
+
   void memcpy(hpx_addr_t dest, hpx_addr_t src, size_t n, hpx_addr_t sync) {
     copy(ToLVA(dest), ToLVA(src), n, sync);
   }
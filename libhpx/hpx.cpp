@@ -119,7 +119,7 @@ int hpx_init(int *argc, char ***argv) {
   }
 
   // bootstrap
-  here->boot = libhpx::boot::Network::Create(here->config->boot);
+  here->boot = libhpx::boot::Network::Create(here->config);
   if (!here->boot) {
     status = log_error("failed to bootstrap.\n");
     goto unwind1;
@@ -16,12 +16,16 @@
 #endif
 
 #include "Wrappers.h"
+#include "libhpx/Worker.h"
 #include "libhpx/action.h"
 #include "libhpx/debug.h"
+#include "libhpx/events.h"
+#include "libhpx/gpa.h"
 #include "libhpx/libhpx.h"
+#include "libhpx/locality.h"
 #include "libhpx/parcel.h"
-#include <memory>
-#include <cstring>
+#include <algorithm>
+#include <mutex>
 
 namespace {
 using libhpx::network::NetworkWrapper;
@@ -29,87 +33,202 @@ using libhpx::network::CoalescingWrapper;
 
 /// Demultiplex coalesced parcels on the receiver side.
 ///
+/// The coalesced parcels are launched in place, nested inside the parcel that
+/// carried them, which stays pinned until the last of them is deleted.
+///
 /// @param       buffer The buffer of coalesced parcels.
 /// @param            n The number of coalesced bytes.
 int
 DemultiplexHandler(char* buffer, size_t n) {
+  hpx_parcel_t *parent = libhpx::self->getCurrentParcel();
+  dbg_assert(hpx_parcel_get_data(parent) == buffer);
+
   auto end = buffer + n;
+  uint16_t count = 0;
+  for (auto i = buffer; i < end; ++count) {
+    i += parcel_batch_size(reinterpret_cast<hpx_parcel_t*>(i));
+  }
+  if (!count) {
+    return HPX_SUCCESS;
+  }
+
+  parcel_pin(parent, count);
   while (buffer < end) {
     auto p = reinterpret_cast<hpx_parcel_t*>(buffer);
-    auto q = parcel_clone(p);
-    parcel_launch(q);
-    buffer += parcel_size(p);
+    buffer += parcel_batch_size(p);
+    p->thread = nullptr;
+    p->next = nullptr;
+    parcel_set_state(p, PARCEL_SERIALIZED);
+    parcel_nest(parent, p);
+    parcel_launch(p);
   }
   return HPX_SUCCESS;
 }
 LIBHPX_ACTION(HPX_DEFAULT, HPX_MARSHALLED, Demultiplex, DemultiplexHandler,
               HPX_POINTER, HPX_SIZE_T);
+}
 
-class CoalescingBuffer {
+/// The coalesced parcels for one destination.
+class CoalescingWrapper::Buffer {
  public:
-  CoalescingBuffer() : parcels_(), ssync_(), bytes_() {
+  Buffer() : parcels_(), ssync_(), count_(), bytes_(), limit_(), start_(),
+             deadline_(), pending_(false)
+  {
+  }
+
+  bool empty() const {
+    return !count_;
+  }
+
+  unsigned count() const {
+    return count_;
+  }
+
+  uint32_t bytes() const {
+    return bytes_;
+  }
+
+  /// The time that the oldest parcel was buffered.
+  uint64_t start() const {
+    return start_;
+  }
+
+  /// Check if a parcel of @p n bytes fits in the batch.
+  bool fits(uint32_t n) const {
+    return bytes_ + n <= PARCEL_BATCH_MAX;
   }
 
-  void record(hpx_parcel_t *p) {
-    while (auto s = parcel_stack_pop(&p->next)) {
+  /// Check if the batch has reached the parcel count or its byte limit.
+  bool full(unsigned count) const {
+    return count <= count_ || limit_ <= bytes_;
+  }
+
+  /// Check if the batch has reached its deadline.
+  bool expired(uint64_t now) const {
+    return count_ && deadline_ <= now;
+  }
+
+  /// Is this buffer in its lane's pending list?
+  bool& pending() {
+    return pending_;
+  }
+
+  /// Buffer a parcel, and tighten the batch's limits to the parcel's.
+  void record(hpx_parcel_t *p, hpx_parcel_t *ssync, uint32_t n, uint32_t limit,
+              uint64_t deadline, uint64_t now) {
+    if (!count_) {
+      start_ = now;
+      limit_ = limit;
+      deadline_ = deadline;
+    }
+    limit_ = std::min(limit_, limit);
+    deadline_ = std::min(deadline_, deadline);
+    while (auto s = parcel_stack_pop(&ssync)) {
       parcel_stack_push(&ssync_, s);
     }
     parcel_stack_push(&parcels_, p);
-    bytes_ += parcel_size(p);
-  }
-
-  void finish(hpx_addr_t target, Network* net) {
-    if (!bytes_) return;
-    auto fat = action_new_parcel(Demultiplex, target, 0, 0, 2, NULL, bytes_);
-    char *next = static_cast<char*>(hpx_parcel_get_data(fat));
-    while (auto p = parcel_stack_pop(&parcels_)) {
-      auto n = parcel_size(p);
-      memcpy(next, p, n);
-      parcel_delete(p);
-      next += n;
-    }
-    if (net->send(fat, ssync_)) {
-      throw std::exception();
-    }
+    bytes_ += n;
+    ++count_;
+  }
+
+  /// Take the buffered parcels and continuations, and reset the buffer.
+  hpx_parcel_t* take(hpx_parcel_t **ssync) {
+    hpx_parcel_t *parcels = parcels_;
+    *ssync = ssync_;
+    parcels_ = nullptr;
+    ssync_ = nullptr;
+    count_ = 0;
+    bytes_ = 0;
+    return parcels;
   }
 
  private:
   hpx_parcel_t *parcels_;                       //!< parcels for this rank
   hpx_parcel_t   *ssync_;                       //!< the continuations
-  unsigned        bytes_;                       //!< the number of bytes
+  unsigned        count_;                       //!< the number of parcels
+  uint32_t        bytes_;                       //!< the number of bytes
+  uint32_t        limit_;                       //!< the byte limit
+  uint64_t        start_;                       //!< the oldest parcel's time
+  uint64_t     deadline_;                       //!< the time to send by
+  bool          pending_;
 };
 
-class Coalescing {
- public:
-  Coalescing(std::atomic<unsigned>& c) : c_(c) {
-    c_++;
+/// A worker's coalescing buffers and counters.
+struct CoalescingWrapper::Lane : public util::Aligned<HPX_CACHELINE_SIZE> {
+  Lane(unsigned ranks)
+      : lock(), buffers(ranks), pending(), batches(), parcels(), bytes(),
+        delay(), maxDelay()
+  {
   }
-  ~Coalescing() {
-    c_--;
-  }
- private:
-  std::atomic<unsigned>& c_;
+
+  std::mutex            lock;
+  std::vector<Buffer>   buffers;                //!< one per rank
+  std::vector<unsigned> pending;                //!< ranks that may have parcels
+
+  /// Counters, for tuning the limits.
+  /// @{
+  uint64_t batches;
+  uint64_t parcels;
+  uint64_t bytes;
+  uint64_t delay;                               //!< total queueing delay (ns)
+  uint64_t maxDelay;
+  /// @}
 };
+
+CoalescingWrapper::Lane&
+CoalescingWrapper::lane()
+{
+  unsigned i = (self) ? self->getId() % lanes_.size() : 0;
+  return *lanes_[i];
+}
+
+uint64_t
+CoalescingWrapper::now() const
+{
+  return hpx_time_elapsed_ns(start_);
 }
 
-/// Send parcels from the coalesced network.
 void
-CoalescingWrapper::send(unsigned n) {
-  if (!n)
+CoalescingWrapper::send(Lane& lane, unsigned rank, uint64_t now)
+{
+  Buffer& buffer = lane.buffers[rank];
+  if (buffer.empty()) {
     return;
+  }
 
-  std::unique_ptr<CoalescingBuffer[]> buffers(new CoalescingBuffer[HPX_LOCALITIES]);
+  uint64_t delay = now - buffer.start();
+  lane.batches += 1;
+  lane.parcels += buffer.count();
+  lane.bytes += buffer.bytes();
+  lane.delay += delay;
+  lane.maxDelay = std::max(lane.maxDelay, delay);
+  EVENT_NETWORK_COALESCE(rank, buffer.count(), buffer.bytes(), delay);
 
-  for (auto i = 0u, e = n; i < e; ++i) {
-    auto p = sends_.dequeue();
-    dbg_assert(p);
-    auto target = gas_.ownerOf(p->target);
-    buffers[target].record(p);
+  hpx_parcel_t *ssync;
+  hpx_parcel_t *parcels = buffer.take(&ssync);
+  auto header = action_new_parcel(Demultiplex, HPX_THERE(rank), 0, 0, 2, NULL,
+                                  0);
+  if (impl_->sendBatch(header, parcels, ssync)) {
+    throw std::exception();
   }
+}
 
-  for (auto i = 0, e = HPX_LOCALITIES; i < e; ++i) {
-    buffers[i].finish(HPX_THERE(i), impl_);
-  }
+void
+CoalescingWrapper::flush(Lane& lane, uint64_t now, bool all)
+{
+  auto& pending = lane.pending;
+  auto end = std::remove_if(pending.begin(), pending.end(), [&](unsigned rank) {
+      Buffer& buffer = lane.buffers[rank];
+      if (all || buffer.expired(now)) {
+        send(lane, rank, now);
+      }
+      if (!buffer.empty()) {
+        return false;
+      }
+      buffer.pending() = false;
+      return true;
+    });
+  pending.erase(end, pending.end());
 }
 
 int
@@ -122,45 +241,65 @@ CoalescingWrapper::send(hpx_parcel_t *p, hpx_parcel_t *ssync)
   // Prepare the parcel now, 1) to serialize it while its data is probably in
   // our cache and 2) to make sure it gets a pid from the right parent.
   parcel_prepare(p);
-  sends_.enqueue(p);
 
-  // Notify the world that there's another parcel in the queue.
-  auto n = 1 + count_++;
+  const action_coalescing_t& tune = action_coalescing[p->action];
+  uint32_t limit = __atomic_load_n(&tune.bytes, __ATOMIC_RELAXED);
+  uint32_t usecs = __atomic_load_n(&tune.usecs, __ATOMIC_RELAXED);
+  limit = (limit) ? limit : bytes_;
+  usecs = (usecs) ? usecs : usecs_;
 
-  // Coalesce on demand as long as we have enough parcels available.
-  while (size_ < n) {
-    Coalescing _(coalescing_);
-    if (count_.compare_exchange_strong(n, n - size_)) {
-      send(size_);
-      n -= size_;
-    }
-  }
+  uint32_t n = parcel_batch_size(p);
+  unsigned rank = gas_.ownerOf(p->target);
+  uint64_t t = now();
 
+  Lane& lane = this->lane();
+  std::lock_guard<std::mutex> _(lane.lock);
+  Buffer& buffer = lane.buffers[rank];
+  if (!buffer.fits(n)) {
+    send(lane, rank, t);
+  }
+  if (!buffer.pending()) {
+    buffer.pending() = true;
+    lane.pending.push_back(rank);
+  }
+  buffer.record(p, ssync, n, limit, t + usecs * UINT64_C(1000), t);
+  if (buffer.full(count_)) {
+    send(lane, rank, t);
+  }
   return LIBHPX_OK;
 }
 
 void
-CoalescingWrapper::progress(int n) {
-  // If the number of buffered parcels is the same as the previous time we
-  // progressed, we'll do an eager send operation to reduce latency and make
-  // sure we're not inducing deadlock.
-  unsigned count = count_;
-  if (count == prev_) {
-    Coalescing _(coalescing_);
-    send(count_.exchange(0));
-    count = 0;
-  }
-  prev_ = count;
+CoalescingWrapper::progress(int n)
+{
+  // Send the batches that have reached their deadline from our own lane, and
+  // from one other lane so that a worker that stops sending can't strand its
+  // parcels.
+  static __thread unsigned next = 0;
+  uint64_t t = now();
+  Lane& own = lane();
+  {
+    std::lock_guard<std::mutex> _(own.lock);
+    flush(own, t, false);
+  }
+  Lane& other = *lanes_[next++ % lanes_.size()];
+  if (&other != &own) {
+    if (auto _ = std::unique_lock<std::mutex>(other.lock, std::try_to_lock)) {
+      flush(other, t, false);
+    }
+  }
   NetworkWrapper::progress(n);
 }
 
 void
-CoalescingWrapper::flush() {
-  // coalesce the rest of the buffered sends
-  send(count_.exchange(0));
-
-  // wait for any concurrent operations to complete
-  while (coalescing_) { /* spin */; }
+CoalescingWrapper::flush()
+{
+  // send the rest of the buffered parcels
+  uint64_t t = now();
+  for (auto& lane : lanes_) {
+    std::lock_guard<std::mutex> _(lane->lock);
+    flush(*lane, t, true);
+  }
 
   // and flush the underlying network
   NetworkWrapper::flush();
@@ -171,11 +310,42 @@ CoalescingWrapper::CoalescingWrapper(Network* impl, const config_t *cfg,
     : NetworkWrapper(impl),
       util::Aligned<HPX_CACHELINE_SIZE>(),
       gas_(*gas),
-      size_(cfg->coalescing_buffersize),
-      prev_(0),
-      count_(0),
-      coalescing_(0),
-      sends_()
+      count_(cfg->coalescing_buffersize),
+      bytes_(std::max(1, cfg->coalescing_bytes)),
+      usecs_(std::max(0, cfg->coalescing_usecs)),
+      start_(hpx_time_now()),
+      lanes_()
 {
-  log_net("Created coalescing network\n");
+  for (int i = 0, e = std::max(1, cfg->threads); i < e; ++i) {
+    lanes_.emplace_back(new Lane(here->ranks));
+  }
+  log_net("Created coalescing network (%u parcels, %u bytes, %u us)\n", count_,
+          bytes_, usecs_);
+}
+
+CoalescingWrapper::~CoalescingWrapper()
+{
+  uint64_t batches = 0, parcels = 0, bytes = 0, delay = 0, maxDelay = 0;
+  for (auto& lane : lanes_) {
+    for (auto& buffer : lane->buffers) {
+      hpx_parcel_t *ssync;
+      hpx_parcel_t *stack = buffer.take(&ssync);
+      while (hpx_parcel_t *p = parcel_stack_pop(&stack)) {
+        parcel_delete(p);
+      }
+      while (hpx_parcel_t *p = parcel_stack_pop(&ssync)) {
+        parcel_delete(p);
+      }
+    }
+    batches += lane->batches;
+    parcels += lane->parcels;
+    bytes += lane->bytes;
+    delay += lane->delay;
+    maxDelay = std::max(maxDelay, lane->maxDelay);
+  }
+  if (batches) {
+    log_net("coalesced %lu parcels (%lu bytes) in %lu batches, "
+            "mean delay %lu ns, max delay %lu ns\n", parcels, bytes, batches,
+            delay / batches, maxDelay);
+  }
 }
@@ -15,34 +15,101 @@
 # include "config.h"
 #endif
 
+/// @file libhpx/network/CompressionWrapper.cpp
+/// @brief Adaptive LZ4 compression of parcels and coalesced batches.
+///
+/// The wrapper compresses a whole parcel image, header and all, into the
+/// payload of a Decompress parcel. The receiver allocates the original parcel
+/// and decompresses straight into it. A coalesced batch is compressed as the
+/// parcel that the receiver would see, so it is decompressed straight into the
+/// batch parcel that demultiplexes in place.
+///
+/// Compression only pays off if it shrinks the message by enough to cover its
+/// cost. Each action keeps a running estimate of its compression ratio. The
+/// wrapper skips compression for small messages and for actions whose estimate
+/// is poor, but still samples one in SAMPLE_PERIOD of them, so it notices when
+/// their data changes. The compression output is bounded by the ratio that we
+/// need, so an incompressible message fails fast and never needs a worst-case
+/// LZ4_compressBound() allocation.
+
 #include "Wrappers.h"
 #include "libhpx/action.h"
+#include "libhpx/debug.h"
 #include "libhpx/libhpx.h"
 #include "libhpx/parcel.h"
 #include <lz4.h>
-#include <utility>
-
-// TODO:
-// 1. in-place compression and decompression.
-// 2. compression and coalescing.
+#include <algorithm>
+#include <cstring>
+#include <memory>
 
 namespace {
 using libhpx::Network;
 using libhpx::network::NetworkWrapper;
 using libhpx::network::CompressionWrapper;
 
+/// Messages smaller than this are never compressed.
+constexpr size_t MIN_BYTES = 256;
+
+/// Compression ratios are fixed point, in 1024ths of the original size.
+constexpr uint32_t RATIO_ONE = 1024;
+
+/// Compress only when the output is at most 7/8 of the input.
+constexpr uint32_t RATIO_LIMIT = 896;
+
+/// Sample one in this many of the messages that we expect not to compress.
+constexpr uint32_t SAMPLE_PERIOD = 32;
+
+/// The running compression estimate for an action.
+struct Estimate {
+  uint16_t ratio;                               //!< 0 until first measured
+  uint16_t skips;                               //!< sends since the last sample
+};
+
+Estimate estimates[LIBHPX_ACTION_MAX];
+
+/// Decide if a message of @p bytes for @p action is worth compressing.
+bool
+_worth_compressing(hpx_action_t action, size_t bytes)
+{
+  if (bytes < MIN_BYTES) {
+    return false;
+  }
+  Estimate& e = estimates[action];
+  uint32_t ratio = __atomic_load_n(&e.ratio, __ATOMIC_RELAXED);
+  if (!ratio || ratio <= RATIO_LIMIT) {
+    return true;
+  }
+  uint32_t skips = __atomic_fetch_add(&e.skips, 1, __ATOMIC_RELAXED);
+  return (skips % SAMPLE_PERIOD) == 0;
+}
+
+/// Fold a measured ratio into an action's estimate.
+void
+_sample(hpx_action_t action, size_t in, size_t out)
+{
+  Estimate& e = estimates[action];
+  uint32_t m = (out) ? std::max<uint32_t>(1, out * RATIO_ONE / in) : RATIO_ONE;
+  uint32_t r = __atomic_load_n(&e.ratio, __ATOMIC_RELAXED);
+  r = (r) ? (3 * r + m) / 4 : m;
+  __atomic_store_n(&e.ratio, std::max<uint32_t>(1, r), __ATOMIC_RELAXED);
+}
+
 struct Args {
   size_t bytes;
   char data[];
 };
 
 int
-DecompressHandler(const Args& args, size_t)
+DecompressHandler(const Args& args, size_t n)
 {
-  // retrieve the original size from the payload.
-  auto *p = parcel_alloc(args.bytes);
+  // Decompress straight into the original parcel's allocation.
+  auto *p = parcel_alloc(args.bytes - sizeof(hpx_parcel_t));
   auto *buffer = reinterpret_cast<char*>(p);
-  LZ4_decompress_fast(args.data, buffer, args.bytes);
+  int csize = n - sizeof(Args);
+  int bytes = args.bytes;
+  if (LZ4_decompress_safe(args.data, buffer, csize, bytes) != bytes) {
+    dbg_error("failed to decompress a %zu byte parcel\n", args.bytes);
+  }
   p->thread = nullptr;
   p->next = nullptr;
   parcel_set_state(p, PARCEL_SERIALIZED);
@@ -52,6 +119,35 @@ DecompressHandler(const Args& args, size_t)
 
 LIBHPX_ACTION(HPX_DEFAULT, HPX_MARSHALLED, Decompress, DecompressHandler,
               HPX_POINTER, HPX_SIZE_T);
+
+/// Compress a parcel image into a new Decompress parcel.
+///
+/// @param       target The target of the compressed parcel.
+/// @param          pid The pid of the compressed parcel.
+/// @param       action The action whose estimate to update.
+/// @param           in The parcel image.
+/// @param        isize The size of the parcel image.
+///
+/// @returns            The compressed parcel, or nullptr if the image didn't
+///                     compress well enough.
+hpx_parcel_t *
+_compress(hpx_addr_t target, hpx_pid_t pid, hpx_action_t action,
+          const char *in, size_t isize)
+{
+  size_t limit = isize * RATIO_LIMIT / RATIO_ONE;
+  size_t bytes = sizeof(Args) + limit;
+  hpx_parcel_t *q = parcel_new(target, Decompress, 0, 0, pid, 0, bytes);
+  auto* args = static_cast<Args*>(hpx_parcel_get_data(q));
+  args->bytes = isize;
+  int csize = LZ4_compress_fast(in, args->data, isize, limit, 1);
+  _sample(action, isize, csize);
+  if (!csize) {
+    parcel_delete(q);
+    return nullptr;
+  }
+  q->size = sizeof(Args) + csize;
+  return q;
+}
 } // namespace
 
 CompressionWrapper::CompressionWrapper(Network* impl)
@@ -62,18 +158,64 @@ CompressionWrapper::CompressionWrapper(Network* impl)
 int
 CompressionWrapper::send(hpx_parcel_t *p, hpx_parcel_t *ssync)
 {
-  if (action_is_compressed(p->action)) {
-    size_t isize = parcel_size(p);
-    size_t bytes = sizeof(Args) + LZ4_compressBound(isize);
-    hpx_parcel_t *q = parcel_new(p->target, Decompress, 0, 0, p->pid, 0, bytes);
-    auto* args = static_cast<Args*>(hpx_parcel_get_data(q));
-    args->bytes = isize;
-    auto* buffer = reinterpret_cast<char*>(p);
-    if (auto csize = LZ4_compress_fast(buffer, args->data, isize, bytes, 1)) {
-      q->size = sizeof(Args) + csize;
-      std::swap(p, q);
-    }
-    parcel_delete(q);
+  if (!action_is_compressed(p->action)) {
+    return impl_->send(p, ssync);
+  }
+
+  size_t isize = parcel_size(p);
+  if (!_worth_compressing(p->action, isize)) {
+    return impl_->send(p, ssync);
+  }
+
+  auto* in = reinterpret_cast<const char*>(p);
+  if (hpx_parcel_t *q = _compress(p->target, p->pid, p->action, in, isize)) {
+    parcel_delete(p);
+    p = q;
   }
   return impl_->send(p, ssync);
 }
+
+int
+CompressionWrapper::sendBatch(hpx_parcel_t *p, hpx_parcel_t *batch,
+                              hpx_parcel_t *ssync)
+{
+  // Batches are compressed if they hold a compressed action, using the first
+  // such action's estimate.
+  hpx_action_t key = HPX_ACTION_INVALID;
+  uint32_t payload = 0;
+  for (hpx_parcel_t *q = batch; q; q = q->next) {
+    payload += parcel_batch_size(q);
+    if (key == HPX_ACTION_INVALID && action_is_compressed(q->action)) {
+      key = q->action;
+    }
+  }
+
+  size_t isize = sizeof(hpx_parcel_t) + payload;
+  if (key == HPX_ACTION_INVALID || !_worth_compressing(key, isize)) {
+    return impl_->sendBatch(p, batch, ssync);
+  }
+
+  // Gather the parcel that the receiver would see, the header followed by the
+  // batch in the layout that parcel_batch_pack() produces.
+  std::unique_ptr<char[]> image(new char[isize]);
+  std::memcpy(&image[0], p, sizeof(hpx_parcel_t));
+  reinterpret_cast<hpx_parcel_t*>(&image[0])->size = payload;
+  char *next = &image[sizeof(hpx_parcel_t)];
+  for (hpx_parcel_t *q = batch; q; q = q->next) {
+    uint32_t n = parcel_size(q);
+    std::memcpy(next, q, n);
+    std::memset(next + n, 0, parcel_batch_size(q) - n);
+    next += parcel_batch_size(q);
+  }
+
+  hpx_parcel_t *q = _compress(p->target, p->pid, key, &image[0], isize);
+  if (!q) {
+    return impl_->sendBatch(p, batch, ssync);
+  }
+
+  parcel_delete(p);
+  while (hpx_parcel_t *r = parcel_stack_pop(&batch)) {
+    parcel_delete(r);
+  }
+  return impl_->send(q, ssync);
+}
@@ -19,10 +19,12 @@
 #include "libhpx/Network.h"
 #include "Wrappers.h"
 #include "SMPNetwork.h"
-#ifdef HAVE_MPI
+#include "ShmNetwork.h"
+#ifdef HAVE_ISIR
 #include "isir/FunneledNetwork.h"
+#include "isir/MultipleNetwork.h"
 #endif
-#ifdef HAVE_PHOTON
+#ifdef HAVE_PWC
 #include "pwc/PWCNetwork.h"
 #endif
 #include "libhpx/debug.h"
@@ -38,8 +40,8 @@ using BootNetwork = libhpx::boot::Network;
 
 Network::Network()
     : StringOps(),
-      CollectiveOps(),
       LCOOps(),
+      CollectiveOps(),
       MemoryOps(),
       ParcelOps()
 {
@@ -53,8 +55,11 @@ Network*
 Network::Create(config_t *cfg, const BootNetwork& boot, GAS *gas)
 {
 #ifndef HAVE_NETWORK
-  // if we didn't build a network we need to default to SMP
-  cfg->network = HPX_NETWORK_SMP;
+  // if we didn't build a network we need to default to SMP, unless we've been
+  // asked for the shared-memory network which is always available
+  if (cfg->network != HPX_NETWORK_SHM) {
+    cfg->network = HPX_NETWORK_SMP;
+  }
 #endif
 
   libhpx_network_t type = cfg->network;
@@ -70,7 +75,7 @@ Network::Create(config_t *cfg, const BootNetwork& boot, GAS *gas)
     type = HPX_NETWORK_SMP;
   }
 
-  if (ranks > 1) {
+  if (ranks > 1 && type != HPX_NETWORK_SHM) {
 #ifndef HAVE_NETWORK
     dbg_error("Launched on %d ranks but no network available\n", ranks);
 #endif
@@ -81,14 +86,14 @@ Network::Create(config_t *cfg, const BootNetwork& boot, GAS *gas)
   }
 
   if (type == HPX_NETWORK_PWC) {
-#ifndef HAVE_PHOTON
-    dbg_error("PWC network selection fails (photon disabled in config)\n");
+#ifndef HAVE_PWC
+    dbg_error("PWC network selection fails (pwc disabled in config)\n");
 #endif
   }
 
   // handle default
   if (type == HPX_NETWORK_DEFAULT) {
-#ifdef HAVE_PHOTON
+#ifdef HAVE_PWC
     type = HPX_NETWORK_PWC;
 #else
     type = HPX_NETWORK_ISIR;
@@ -97,7 +102,7 @@ Network::Create(config_t *cfg, const BootNetwork& boot, GAS *gas)
 
   switch (type) {
    case HPX_NETWORK_PWC:
-#ifdef HAVE_PHOTON
+#ifdef HAVE_PWC
     network = libhpx::network::pwc::PWCNetwork::Create(cfg, boot, gas);
 #else
     log_level(LEVEL, "PWC network unavailable (no network configured)\n");
@@ -105,13 +110,22 @@ Network::Create(config_t *cfg, const BootNetwork& boot, GAS *gas)
     break;
 
    case HPX_NETWORK_ISIR:
-#ifdef HAVE_MPI
-    network = new libhpx::network::isir::FunneledNetwork(cfg, gas);
+#ifdef HAVE_ISIR
+    if (cfg->isir_multiple) {
+      network = new libhpx::network::isir::MultipleNetwork(cfg, boot, gas);
+    }
+    else {
+      network = new libhpx::network::isir::FunneledNetwork(cfg, boot, gas);
+    }
 #else
     log_level(LEVEL, "ISIR network unavailable (no network configured)\n");
 #endif
     break;
 
+   case HPX_NETWORK_SHM:
+    network = new ShmNetwork(cfg, boot, gas);
+    break;
+
    case HPX_NETWORK_SMP:
     network = new SMPNetwork(boot);
     break;
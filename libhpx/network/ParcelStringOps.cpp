@@ -20,6 +20,7 @@
 #include "libhpx/debug.h"
 #include "libhpx/parcel.h"
 #include <algorithm>
+#include <numeric>
 
 namespace {
 using libhpx::network::ParcelStringOps;
@@ -140,6 +141,150 @@ class ParcelMemput {
 } put;
 HPX_ACTION_DECL(ParcelMemput::Async) = 0;
 
+/// The vectored memget sends the layout of the pieces to the owner of the
+/// block, which packs them all into a single reply. The reply carries a pointer
+/// to a copy of the local buffer descriptors, which it scatters into before
+/// setting the lsync LCO.
+class ParcelMemgetv {
+  static HPX_ACTION_DECL(Request);
+  static HPX_ACTION_DECL(Reply);
+
+  struct RequestArgs {
+    struct iovec    *to;
+    hpx_addr_t    lsync;
+    int               n;
+    size_t     pieces[];                        // n offsets, then n lengths
+  };
+
+  struct ReplyArgs {
+    struct iovec *to;
+    int            n;
+    char      from[];
+  };
+
+  static int
+  ReplyHandler(const ReplyArgs& args, size_t)
+  {
+    const char *from = args.from;
+    for (int i = 0, e = args.n; i < e; ++i) {
+      char *to = static_cast<char*>(args.to[i].iov_base);
+      std::copy(from, from + args.to[i].iov_len, to);
+      from += args.to[i].iov_len;
+    }
+    delete [] args.to;
+    return HPX_SUCCESS;
+  }
+
+  static int
+  RequestHandler(const char *block, const RequestArgs& args, size_t)
+  {
+    const size_t *offsets = args.pieces;
+    const size_t *lengths = args.pieces + args.n;
+    size_t bytes = std::accumulate(lengths, lengths + args.n, sizeof(ReplyArgs));
+    auto current = hpx_thread_current_parcel();
+    hpx_addr_t target = HPX_THERE(current->src);
+    hpx_action_t rop = hpx_lco_set_action;
+    hpx_pid_t pid = current->pid;
+    auto p = parcel_new(target, Reply, args.lsync, rop, pid, NULL, bytes);
+    auto reply = static_cast<ReplyArgs*>(hpx_parcel_get_data(p));
+    reply->to = args.to;
+    reply->n = args.n;
+    char *to = reply->from;
+    for (int i = 0, e = args.n; i < e; ++i) {
+      to = std::copy(block + offsets[i], block + offsets[i] + lengths[i], to);
+    }
+    parcel_launch(p);
+    return HPX_SUCCESS;
+  }
+
+ public:
+  ParcelMemgetv() {
+    LIBHPX_REGISTER_ACTION(HPX_DEFAULT, HPX_MARSHALLED, Reply, ReplyHandler,
+                           HPX_POINTER, HPX_SIZE_T);
+    LIBHPX_REGISTER_ACTION(HPX_DEFAULT, HPX_PINNED | HPX_MARSHALLED, Request,
+                           RequestHandler, HPX_POINTER, HPX_POINTER,
+                           HPX_SIZE_T);
+  }
+
+  void
+  operator()(const struct iovec *dest, hpx_addr_t from, const size_t *offsets,
+             int n, hpx_addr_t lsync)
+  {
+    size_t bytes = sizeof(RequestArgs) + 2 * n * sizeof(size_t);
+    hpx_pid_t pid = hpx_thread_current_pid();
+    auto p = parcel_new(from, Request, HPX_NULL, HPX_ACTION_NULL, pid, NULL,
+                        bytes);
+    auto args = static_cast<RequestArgs*>(hpx_parcel_get_data(p));
+    args->to = new struct iovec[n];
+    args->lsync = lsync;
+    args->n = n;
+    std::copy(dest, dest + n, args->to);
+    std::copy(offsets, offsets + n, args->pieces);
+    std::transform(dest, dest + n, args->pieces + n,
+                   [](const struct iovec& v) { return v.iov_len; });
+    parcel_launch(p);
+  }
+} getv;
+HPX_ACTION_DECL(ParcelMemgetv::Request) = 0;
+HPX_ACTION_DECL(ParcelMemgetv::Reply) = 0;
+
+/// The vectored memput gathers the local pieces into a single parcel along
+/// with their layout, and the owner of the block scatters them.
+class ParcelMemputv {
+  static HPX_ACTION_DECL(Async);
+
+  struct Args {
+    int           n;
+    size_t pieces[];                            // n offsets, n lengths, data
+  };
+
+  static int
+  AsyncHandler(char *block, const Args& args, size_t)
+  {
+    const size_t *offsets = args.pieces;
+    const size_t *lengths = args.pieces + args.n;
+    auto from = reinterpret_cast<const char*>(lengths + args.n);
+    for (int i = 0, e = args.n; i < e; ++i) {
+      std::copy(from, from + lengths[i], block + offsets[i]);
+      from += lengths[i];
+    }
+    return HPX_SUCCESS;
+  }
+
+ public:
+  ParcelMemputv() {
+    LIBHPX_REGISTER_ACTION(HPX_INTERRUPT, HPX_PINNED | HPX_MARSHALLED, Async,
+                           AsyncHandler, HPX_POINTER, HPX_POINTER, HPX_SIZE_T);
+  }
+
+  void
+  operator()(hpx_addr_t dest, const size_t *offsets, const struct iovec *from,
+             int n, hpx_addr_t lsync, hpx_addr_t rsync)
+  {
+    size_t bytes = std::accumulate(from, from + n,
+                                   sizeof(Args) + 2 * n * sizeof(size_t),
+                                   [](size_t sum, const struct iovec& v) {
+                                     return sum + v.iov_len;
+                                   });
+    hpx_action_t set = hpx_lco_set_action;
+    hpx_pid_t pid = hpx_thread_current_pid();
+    auto p = parcel_new(dest, Async, rsync, set, pid, NULL, bytes);
+    auto args = static_cast<Args*>(hpx_parcel_get_data(p));
+    args->n = n;
+    std::copy(offsets, offsets + n, args->pieces);
+    std::transform(from, from + n, args->pieces + n,
+                   [](const struct iovec& v) { return v.iov_len; });
+    auto to = reinterpret_cast<char*>(args->pieces + 2 * n);
+    for (int i = 0; i < n; ++i) {
+      auto piece = static_cast<const char*>(from[i].iov_base);
+      to = std::copy(piece, piece + from[i].iov_len, to);
+    }
+    hpx_lco_set(lsync, 0, NULL, HPX_NULL, HPX_NULL);
+    parcel_launch(p);
+  }
+} putv;
+HPX_ACTION_DECL(ParcelMemputv::Async) = 0;
+
 class ParcelMemcpy {
   static HPX_ACTION_DECL(Request);
   static HPX_ACTION_DECL(Reply);
@@ -222,6 +367,21 @@ ParcelStringOps::memput(hpx_addr_t dest, const void *from, size_t size)
   put(dest, from, size);
 }
 
+void
+ParcelStringOps::memgetv(const struct iovec *dest, hpx_addr_t from,
+                         const size_t *offsets, int n, hpx_addr_t lsync)
+{
+  getv(dest, from, offsets, n, lsync);
+}
+
+void
+ParcelStringOps::memputv(hpx_addr_t dest, const size_t *offsets,
+                         const struct iovec *from, int n, hpx_addr_t lsync,
+                         hpx_addr_t rsync)
+{
+  putv(dest, offsets, from, n, lsync, rsync);
+}
+
 void
 ParcelStringOps::memcpy(hpx_addr_t dest, hpx_addr_t from, size_t size,
                         hpx_addr_t sync)
@@ -18,6 +18,7 @@
 #include "SMPNetwork.h"
 #include "libhpx/debug.h"
 #include "libhpx/libhpx.h"
+#include <cinttypes>
 #include <cstring>
 
 namespace {
@@ -72,6 +73,21 @@ SMPNetwork::memput(hpx_addr_t to, const void *from, size_t size)
   dbg_error("SMP string implementation called\n");
 }
 
+void
+SMPNetwork::memgetv(const struct iovec *to, hpx_addr_t from,
+                    const size_t *offsets, int n, hpx_addr_t lsync)
+{
+  dbg_error("SMP string implementation called\n");
+}
+
+void
+SMPNetwork::memputv(hpx_addr_t to, const size_t *offsets,
+                    const struct iovec *from, int n, hpx_addr_t lsync,
+                    hpx_addr_t rsync)
+{
+  dbg_error("SMP string implementation called\n");
+}
+
 void
 SMPNetwork::memcpy(hpx_addr_t to, hpx_addr_t from, size_t size, hpx_addr_t lsync)
 {
@@ -129,15 +145,20 @@ SMPNetwork::unpin(const void *addr, size_t n)
 }
 
 int
-SMPNetwork::wait(hpx_addr_t lco, int reset)
+SMPNetwork::wait(hpx_addr_t lco, int)
 {
-  return (reset) ? hpx_lco_wait_reset(lco) : hpx_lco_wait(lco);
+  // The LCO entry points only forward here when they failed to pin the LCO,
+  // and every valid address is local in SMP, so calling back into them would
+  // recurse forever.
+  log_error("could not pin LCO %" PRIu64 " for wait\n", lco);
+  return HPX_ERROR;
 }
 
 int
-SMPNetwork::get(hpx_addr_t lco, size_t n, void *to, int reset)
+SMPNetwork::get(hpx_addr_t lco, size_t, void *, int)
 {
-  return (reset) ? hpx_lco_get_reset(lco, n, to) : hpx_lco_get(lco, n, to);
+  log_error("could not pin LCO %" PRIu64 " for get\n", lco);
+  return HPX_ERROR;
 }
 
 int
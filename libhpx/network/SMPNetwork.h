@@ -49,6 +49,11 @@ class SMPNetwork final : public Network
   void memput(hpx_addr_t to, const void *from, size_t size, hpx_addr_t rsync);
   void memput(hpx_addr_t to, const void *from, size_t size);
 
+  void memgetv(const struct iovec *to, hpx_addr_t from, const size_t *offsets,
+               int n, hpx_addr_t lsync);
+  void memputv(hpx_addr_t to, const size_t *offsets, const struct iovec *from,
+               int n, hpx_addr_t lsync, hpx_addr_t rsync);
+
   void memcpy(hpx_addr_t to, hpx_addr_t from, size_t size, hpx_addr_t sync);
   void memcpy(hpx_addr_t to, hpx_addr_t from, size_t size);
 };
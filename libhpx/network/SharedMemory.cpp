@@ -0,0 +1,91 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "libhpx/SharedMemory.h"
+#include "libhpx/debug.h"
+#include <cstdio>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+using libhpx::network::SharedSegment;
+
+/// The identity that each locality contributes during startup.
+struct Identity {
+  long  host;
+  pid_t  pid;
+};
+}
+
+SharedSegment::SharedSegment(const boot::Network& boot, size_t bytes,
+                             const char *tag)
+    : bytes_(bytes),
+      base_(nullptr)
+{
+  int rank = boot.getRank();
+  std::vector<Identity> ids(boot.getNRanks());
+  Identity id = { gethostid(), getpid() };
+  boot.allgather(&id, &ids[0], sizeof(id));
+  for (auto&& i : ids) {
+    if (i.host != id.host) {
+      dbg_error("shared memory %s requires all ranks on one host\n", tag);
+    }
+  }
+
+  char name[64];
+  snprintf(name, sizeof(name), "/hpx-%s-%u-%d", tag, unsigned(getuid()),
+           int(ids[0].pid));
+
+  int fd = -1;
+  if (rank == 0) {
+    fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+      dbg_error("could not create shared memory segment %s\n", name);
+    }
+    if (ftruncate(fd, bytes_)) {
+      dbg_error("could not size shared memory segment %s\n", name);
+    }
+  }
+  boot.barrier();
+  if (rank != 0) {
+    fd = shm_open(name, O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+      dbg_error("could not open shared memory segment %s\n", name);
+    }
+  }
+
+  void *base = mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (base == MAP_FAILED) {
+    dbg_error("could not map shared memory segment %s\n", name);
+  }
+  close(fd);
+  base_ = static_cast<char*>(base);
+  boot.barrier();
+
+  if (rank == 0) {
+    shm_unlink(name);
+  }
+  log_net("mapped %zu-byte shared memory segment %s\n", bytes_, name);
+}
+
+SharedSegment::~SharedSegment()
+{
+  munmap(base_, bytes_);
+}
@@ -0,0 +1,281 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+/// @file libhpx/network/ShmNetwork.cpp
+/// @brief A parcel network over a shared memory segment.
+///
+/// Parcels are written into the rings in the same format that the ISIR network
+/// uses on the wire, i.e., the parcel starting at its action, preceded by an
+/// 8-byte length header and padded to 8 bytes. The writer may stop anywhere in
+/// a parcel when the ring fills, but the reader only starts a parcel once its
+/// whole header is available.
+
+#include "ShmNetwork.h"
+#include "libhpx/debug.h"
+#include "libhpx/parcel.h"
+
+namespace {
+using libhpx::network::ShmNetwork;
+using libhpx::network::SharedRing;
+
+/// The ring capacity, must be a power of two.
+constexpr size_t RING_BYTES = size_t(1) << 18;
+
+/// The header for each parcel in the stream.
+constexpr size_t HEADER_BYTES = sizeof(uint64_t);
+
+uint64_t Pad(uint64_t n) {
+  return (n + HEADER_BYTES - 1) & ~(HEADER_BYTES - 1);
+}
+
+uint32_t NetworkBytes(const hpx_parcel_t *p) {
+  return parcel_size(p) - offsetof(hpx_parcel_t, action);
+}
+
+uint32_t PayloadBytes(uint64_t bytes) {
+  return bytes + offsetof(hpx_parcel_t, action) - sizeof(hpx_parcel_t);
+}
+}
+
+ShmNetwork::ShmNetwork(const config_t *cfg, const boot::Network& boot,
+                       GAS *gas)
+    : Network(),
+      ParcelStringOps(),
+      ParcelLCOOps(),
+      util::Aligned<HPX_CACHELINE_SIZE>(),
+      gas_(*gas),
+      rank_(boot.getRank()),
+      ranks_(boot.getNRanks()),
+      capacity_(RING_BYTES),
+      segment_(boot, ranks_ * ranks_ * SharedRing::Bytes(capacity_), "net"),
+      sends_(),
+      recvs_(),
+      out_(ranks_),
+      in_(ranks_),
+      lock_()
+{
+  for (unsigned from = 0; from < ranks_; ++from) {
+    out_[from].offset = 0;
+    in_[from] = { nullptr, 0, 0 };
+  }
+}
+
+ShmNetwork::~ShmNetwork()
+{
+  while (hpx_parcel_t *p = sends_.dequeue()) {
+    parcel_delete(p);
+  }
+  while (hpx_parcel_t *p = recvs_.dequeue()) {
+    parcel_delete(p);
+  }
+  for (auto&& o : out_) {
+    for (auto&& s : o.sends) {
+      parcel_delete(s.p);
+      parcel_delete(s.ssync);
+    }
+  }
+  for (auto&& i : in_) {
+    parcel_delete(i.p);
+  }
+}
+
+int
+ShmNetwork::type() const {
+  return HPX_NETWORK_SHM;
+}
+
+SharedRing&
+ShmNetwork::ringAt(unsigned from, unsigned to) const
+{
+  size_t i = size_t(from) * ranks_ + to;
+  char *ring = segment_.base() + i * SharedRing::Bytes(capacity_);
+  return *reinterpret_cast<SharedRing*>(ring);
+}
+
+void
+ShmNetwork::sendAll()
+{
+  while (hpx_parcel_t *p = sends_.dequeue()) {
+    hpx_parcel_t *ssync = p->next;
+    p->next = nullptr;
+    unsigned to = gas_.ownerOf(p->target);
+    out_[to].sends.push_back({p, ssync});
+  }
+}
+
+bool
+ShmNetwork::write(unsigned to)
+{
+  Outgoing& out = out_[to];
+  SharedRing& ring = ringAt(rank_, to);
+  while (!out.sends.empty()) {
+    Send& send = out.sends.front();
+    uint64_t bytes = NetworkBytes(send.p);
+
+    // Write as much of the header, the parcel, and the padding as fits. The
+    // padding bytes are never read so their value doesn't matter.
+    const char *from = reinterpret_cast<const char*>(&send.p->action);
+    uint64_t total = HEADER_BYTES + Pad(bytes);
+    while (out.offset < total) {
+      uint64_t body = out.offset - HEADER_BYTES;
+      size_t n;
+      if (out.offset < HEADER_BYTES) {
+        const char *header = reinterpret_cast<const char*>(&bytes);
+        n = ring.put(header + out.offset, HEADER_BYTES - out.offset, capacity_);
+      }
+      else if (body < bytes) {
+        n = ring.put(from + body, bytes - body, capacity_);
+      }
+      else {
+        n = ring.put(from, Pad(bytes) - body, capacity_);
+      }
+      if (!n) {
+        return true;
+      }
+      out.offset += n;
+    }
+
+    log_net("sent %lu-byte parcel to %u\n", bytes, to);
+    parcel_delete(send.p);
+    if (send.ssync) {
+      recvs_.enqueue(send.ssync);
+    }
+    out.sends.pop_front();
+    out.offset = 0;
+  }
+  return false;
+}
+
+void
+ShmNetwork::read(unsigned from)
+{
+  Incoming& in = in_[from];
+  SharedRing& ring = ringAt(from, rank_);
+  hpx_parcel_t *chain = nullptr;
+  while (true) {
+    if (!in.p) {
+      if (ring.available() < HEADER_BYTES) {
+        break;
+      }
+      ring.get(&in.bytes, HEADER_BYTES, capacity_);
+      in.p = parcel_alloc(PayloadBytes(in.bytes));
+      in.p->thread = nullptr;
+      in.p->next = nullptr;
+      in.p->state = PARCEL_SERIALIZED;
+      in.offset = 0;
+    }
+
+    char *to = reinterpret_cast<char*>(&in.p->action);
+    if (in.offset < in.bytes) {
+      in.offset += ring.get(to + in.offset, in.bytes - in.offset, capacity_);
+    }
+    if (in.offset >= in.bytes && in.offset < Pad(in.bytes)) {
+      in.offset += ring.get(nullptr, Pad(in.bytes) - in.offset, capacity_);
+    }
+    if (in.offset < Pad(in.bytes)) {
+      break;
+    }
+
+    hpx_parcel_t *p = in.p;
+    p->size = PayloadBytes(in.bytes);
+    p->src = from;
+    log_net("received %lu-byte parcel from %u\n", in.bytes, from);
+    parcel_stack_push(&chain, p);
+    in.p = nullptr;
+  }
+
+  if (chain) {
+    recvs_.enqueue(chain);
+  }
+}
+
+bool
+ShmNetwork::progressAll()
+{
+  bool pending = false;
+  for (unsigned i = 0; i < ranks_; ++i) {
+    pending |= write(i);
+  }
+  for (unsigned i = 0; i < ranks_; ++i) {
+    read(i);
+  }
+  return pending;
+}
+
+void
+ShmNetwork::progress(int)
+{
+  if (auto _ = std::unique_lock<std::mutex>(lock_, std::try_to_lock)) {
+    sendAll();
+    progressAll();
+  }
+}
+
+void
+ShmNetwork::flush()
+{
+  // We have to keep reading while we wait for our writes, otherwise two ranks
+  // that are flushing to each other could deadlock on full rings.
+  std::lock_guard<std::mutex> _(lock_);
+  sendAll();
+  while (progressAll()) {
+  }
+}
+
+hpx_parcel_t *
+ShmNetwork::probe(int)
+{
+  return recvs_.dequeue();
+}
+
+int
+ShmNetwork::send(hpx_parcel_t *p, hpx_parcel_t *ssync)
+{
+  // Use the unused parcel-next pointer to get the ssync continuation parcels
+  // through the concurrent queue, along with the primary parcel.
+  p->next = ssync;
+  sends_.enqueue(p);
+  return 0;
+}
+
+void
+ShmNetwork::deallocate(const hpx_parcel_t* p)
+{
+  dbg_error("SHM network has no network-managed parcels\n");
+}
+
+void
+ShmNetwork::pin(const void *base, size_t n, void *key)
+{
+}
+
+void
+ShmNetwork::unpin(const void* base, size_t n)
+{
+}
+
+int
+ShmNetwork::init(void **ctx)
+{
+  dbg_error("SHM network does not support network collectives\n");
+}
+
+int
+ShmNetwork::sync(void *in, size_t count, void *out, void *ctx)
+{
+  dbg_error("SHM network does not support network collectives\n");
+}
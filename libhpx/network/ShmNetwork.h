@@ -0,0 +1,112 @@
+// ==================================================================-*- C++ -*-
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifndef LIBHPX_NETWORK_SHM_NETWORK_H
+#define LIBHPX_NETWORK_SHM_NETWORK_H
+
+#include "libhpx/Network.h"
+#include "libhpx/ParcelLCOOps.h"
+#include "libhpx/ParcelStringOps.h"
+#include "libhpx/SharedMemory.h"
+#include "libhpx/util/Aligned.h"
+#include "libhpx/util/TwoLockQueue.h"
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace libhpx {
+namespace network {
+/// A parcel network for localities that share a host.
+///
+/// The localities map a single shared memory segment that holds a ring for
+/// each ordered pair of localities.
+/// Parcels are streamed through the rings in their network representation, so
+/// a parcel that is larger than a ring is simply delivered in pieces. Sends are
+/// funneled through the network lock like the ISIR network, which makes the
+/// locking thread the only producer and consumer for this locality's rings.
+class ShmNetwork final : public Network, public ParcelStringOps,
+                         public ParcelLCOOps,
+                         public util::Aligned<HPX_CACHELINE_SIZE>
+{
+ public:
+  ShmNetwork(const config_t *cfg, const boot::Network& boot, GAS *gas);
+  ~ShmNetwork();
+
+  int type() const;
+  void progress(int);
+  hpx_parcel_t* probe(int);
+  void flush();
+
+  void deallocate(const hpx_parcel_t* p);
+  int send(hpx_parcel_t* p, hpx_parcel_t* ssync);
+
+  void pin(const void *base, size_t bytes, void *key);
+  void unpin(const void *base, size_t bytes);
+
+  int init(void **collective);
+  int sync(void *in, size_t in_size, void* out, void *collective);
+
+ private:
+  using ParcelQueue = libhpx::util::TwoLockQueue<hpx_parcel_t*>;
+
+  /// A parcel waiting to be written to a ring.
+  struct Send {
+    hpx_parcel_t     *p;
+    hpx_parcel_t *ssync;
+  };
+
+  /// The sends to a single peer, and the progress of the first one.
+  struct Outgoing {
+    std::deque<Send> sends;
+    uint64_t        offset;
+  };
+
+  /// A parcel being read from a peer's ring.
+  struct Incoming {
+    hpx_parcel_t      *p;
+    uint64_t       bytes;
+    uint64_t      offset;
+  };
+
+  /// Find the ring that carries parcels from @p from to @p to.
+  SharedRing& ringAt(unsigned from, unsigned to) const;
+
+  /// Move the queued sends to their peers' outgoing lists.
+  void sendAll();
+
+  /// Write as much as we can to a peer's ring, and return true if there are
+  /// still parcels waiting for that peer.
+  bool write(unsigned to);
+
+  /// Read any complete parcels from a peer's ring.
+  void read(unsigned from);
+
+  /// Write and read all of the rings, and return true if there are still
+  /// parcels waiting to be written.
+  bool progressAll();
+
+  const GAS&             gas_;
+  const unsigned        rank_;
+  const unsigned       ranks_;
+  const size_t      capacity_;          // the bytes in each ring
+  SharedSegment      segment_;
+  ParcelQueue          sends_;
+  ParcelQueue          recvs_;
+  std::vector<Outgoing>  out_;
+  std::vector<Incoming>   in_;
+  std::mutex            lock_;
+};
+} // namespace network
+} // namespace libhpx
+
+#endif // LIBHPX_NETWORK_SHM_NETWORK_H
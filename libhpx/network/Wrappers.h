@@ -16,8 +16,9 @@
 
 #include "libhpx/Network.h"
 #include "libhpx/util/Aligned.h"
-#include "libhpx/util/TwoLockQueue.h"
-#include <atomic>
+#include "hpx/hpx.h"
+#include <memory>
+#include <vector>
 
 namespace libhpx {
 namespace network {
@@ -51,6 +52,10 @@ class NetworkWrapper : public Network
     return impl_->send(p, ssync);
   }
 
+  int sendBatch(hpx_parcel_t* p, hpx_parcel_t* batch, hpx_parcel_t* ssync) {
+    return impl_->sendBatch(p, batch, ssync);
+  }
+
   void pin(const void *base, size_t bytes, void *key) {
     impl_->pin(base, bytes, key);
   }
@@ -101,6 +106,16 @@ class NetworkWrapper : public Network
     impl_->memput(to, from, size);
   }
 
+  void memgetv(const struct iovec *to, hpx_addr_t from, const size_t *offsets,
+               int n, hpx_addr_t lsync) {
+    impl_->memgetv(to, from, offsets, n, lsync);
+  }
+
+  void memputv(hpx_addr_t to, const size_t *offsets, const struct iovec *from,
+               int n, hpx_addr_t lsync, hpx_addr_t rsync) {
+    impl_->memputv(to, offsets, from, n, lsync, rsync);
+  }
+
   void memcpy(hpx_addr_t to, hpx_addr_t from, size_t size, hpx_addr_t sync) {
     impl_->memcpy(to, from, size, sync);
   }
@@ -124,30 +139,59 @@ class InstrumentationWrapper final : public NetworkWrapper {
   int send(hpx_parcel_t* p, hpx_parcel_t* ssync);
 };
 
+/// Compress the parcels for HPX_COMPRESSED actions.
+///
+/// Single parcels and coalesced batches that hold one are compressed with LZ4
+/// when they are large enough and their action's sampled compression ratio
+/// says that it pays off.
 class CompressionWrapper final : public NetworkWrapper {
  public:
   CompressionWrapper(Network* impl);
   int send(hpx_parcel_t* p, hpx_parcel_t* ssync);
+  int sendBatch(hpx_parcel_t* p, hpx_parcel_t* batch, hpx_parcel_t* ssync);
 };
 
+/// Coalesce the parcels for HPX_COALESCED actions.
+///
+/// Each worker buffers coalesced parcels per destination. A destination's
+/// buffer goes out as one batch when it reaches the parcel count or the byte
+/// limit, or when its oldest parcel reaches the deadline. The limits come from
+/// the coalescing options, and may be lowered per action with
+/// hpx_action_set_coalescing().
 class CoalescingWrapper final : public NetworkWrapper,
                                 public util::Aligned<HPX_CACHELINE_SIZE>
 {
  public:
   CoalescingWrapper(Network* impl, const config_t *cfg, GAS *gas);
+  ~CoalescingWrapper();
+
   void progress(int n);
   void flush();
   int send(hpx_parcel_t* p, hpx_parcel_t* ssync);
 
  private:
-  void send(unsigned n);
-
-  GAS& gas_;
-  const unsigned size_;
-  std::atomic<unsigned> prev_;
-  std::atomic<unsigned> count_;
-  std::atomic<unsigned> coalescing_;
-  util::TwoLockQueue<hpx_parcel_t*> sends_;
+  class Buffer;
+  struct Lane;
+
+  /// The lane for the calling worker.
+  Lane& lane();
+
+  /// The time since the network was created, in nanoseconds.
+  uint64_t now() const;
+
+  /// Send the buffers in a lane that have passed their deadline, or all of
+  /// them. The lane must be locked.
+  void flush(Lane& lane, uint64_t now, bool all);
+
+  /// Send the buffer for @p rank as a batch. The lane must be locked.
+  void send(Lane& lane, unsigned rank, uint64_t now);
+
+  GAS&                                gas_;
+  const unsigned                    count_;     //!< parcels per batch
+  const uint32_t                    bytes_;     //!< default byte limit
+  const uint32_t                    usecs_;     //!< default deadline
+  const hpx_time_t                  start_;
+  std::vector<std::unique_ptr<Lane>> lanes_;    //!< one per worker
 };
 
 } // namespace network
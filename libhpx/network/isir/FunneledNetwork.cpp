@@ -26,13 +26,16 @@ using libhpx::network::ParcelStringOps;
 using libhpx::network::isir::FunneledNetwork;
 }
 
-FunneledNetwork::FunneledNetwork(const config_t *cfg, GAS *gas)
+FunneledNetwork::FunneledNetwork(const config_t *cfg, const boot::Network& boot,
+                                 GAS *gas)
     : Network(),
       ParcelStringOps(),
+      ParcelLCOOps(),
       util::Aligned<HPX_CACHELINE_SIZE>(),
       sends_(),
+      batches_(),
       recvs_(),
-      xport_(),
+      xport_(cfg, boot),
       isends_(cfg, gas, xport_),
       irecvs_(cfg, xport_),
       lock_()
@@ -44,6 +47,13 @@ FunneledNetwork::~FunneledNetwork()
   while (hpx_parcel_t *p = sends_.dequeue()) {
     parcel_delete(p);
   }
+  while (Batch *b = batches_.dequeue()) {
+    while (hpx_parcel_t *p = parcel_stack_pop(&b->batch)) {
+      parcel_delete(p);
+    }
+    parcel_delete(b->p);
+    delete b;
+  }
   while (hpx_parcel_t *p = recvs_.dequeue()) {
     parcel_delete(p);
   }
@@ -61,6 +71,10 @@ FunneledNetwork::sendAll() {
     p->next = NULL;
     isends_.append(p, ssync);
   }
+  while (Batch *b = batches_.dequeue()) {
+    isends_.append(b->p, b->ssync, b->batch);
+    delete b;
+  }
 }
 
 int
@@ -105,6 +119,21 @@ FunneledNetwork::sync(void *in, size_t count, void *out, void *ctx)
    case ALL_REDUCE:
     xport_.allreduce(in, out, count, NULL, &coll->op, comm);
     break;
+   case ALL_GATHER:
+    xport_.allgather(in, out, count, comm);
+    break;
+   case REDUCE_SCATTER:
+    xport_.reduceScatter(in, out, count, &coll->op, comm);
+    break;
+   case SCAN:
+    xport_.scan(in, out, count, &coll->op, false, comm);
+    break;
+   case EXSCAN:
+    xport_.scan(in, out, count, &coll->op, true, comm);
+    break;
+   case ALL_TO_ALL:
+    xport_.alltoall(in, out, count, comm);
+    break;
    default:
     log_dflt("Collective type descriptor: %d is invalid!\n", coll->type);
     break;
@@ -127,6 +156,15 @@ FunneledNetwork::send(hpx_parcel_t *p, hpx_parcel_t *ssync) {
   return 0;
 }
 
+int
+FunneledNetwork::sendBatch(hpx_parcel_t *p, hpx_parcel_t *batch,
+                           hpx_parcel_t *ssync) {
+  // The parcel's next pointer can't carry both the batch and the ssync
+  // continuation, so batches go through their own queue.
+  batches_.enqueue(new Batch{p, batch, ssync});
+  return 0;
+}
+
 hpx_parcel_t *
 FunneledNetwork::probe(int) {
   return recvs_.dequeue();
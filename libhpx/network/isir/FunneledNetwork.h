@@ -17,7 +17,8 @@
 #include "libhpx/Network.h"
 #include "IRecvBuffer.h"
 #include "ISendBuffer.h"
-#include "MPITransport.h"
+#include "Transport.h"
+#include "libhpx/ParcelLCOOps.h"
 #include "libhpx/ParcelStringOps.h"
 #include "libhpx/util/Aligned.h"
 #include "libhpx/util/TwoLockQueue.h"
@@ -27,10 +28,11 @@ namespace libhpx {
 namespace network {
 namespace isir {
 class FunneledNetwork : public Network, public ParcelStringOps,
+                        public ParcelLCOOps,
                         public util::Aligned<HPX_CACHELINE_SIZE>
 {
  public:
-  FunneledNetwork(const config_t *cfg, GAS *gas);
+  FunneledNetwork(const config_t *cfg, const boot::Network& boot, GAS *gas);
   ~FunneledNetwork();
 
   int type() const;
@@ -40,26 +42,33 @@ class FunneledNetwork : public Network, public ParcelStringOps,
 
   void deallocate(const hpx_parcel_t* p);
   int send(hpx_parcel_t* p, hpx_parcel_t* ssync);
+  int sendBatch(hpx_parcel_t* p, hpx_parcel_t* batch, hpx_parcel_t* ssync);
 
   void pin(const void *base, size_t bytes, void *key);
   void unpin(const void *base, size_t bytes);
 
-  int wait(hpx_addr_t lco, int reset);
-  int get(hpx_addr_t lco, size_t n, void *to, int reset);
-
   int init(void **collective);
   int sync(void *in, size_t in_size, void* out, void *collective);
 
  private:
 
-  using Transport = libhpx::network::isir::MPITransport;
+  using Transport = libhpx::network::isir::Transport;
   using IRecvBuffer = libhpx::network::isir::IRecvBuffer;
   using ISendBuffer = libhpx::network::isir::ISendBuffer;
   using ParcelQueue = libhpx::util::TwoLockQueue<hpx_parcel_t*>;
 
+  /// A coalesced send waiting for the progress thread.
+  struct Batch {
+    hpx_parcel_t*     p;
+    hpx_parcel_t* batch;
+    hpx_parcel_t* ssync;
+  };
+  using BatchQueue = libhpx::util::TwoLockQueue<Batch*>;
+
   void sendAll();
 
   ParcelQueue  sends_;
+  BatchQueue batches_;
   ParcelQueue  recvs_;
   Transport    xport_;
   ISendBuffer isends_;
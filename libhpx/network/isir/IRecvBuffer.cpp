@@ -19,7 +19,7 @@
 #include "parcel_utils.h"
 #include "libhpx/events.h"
 #include "libhpx/parcel.h"
-#include <memory>
+#include <algorithm>
 #include <libhpx/Topology.h>
 #ifdef HAVE_APEX
 #include "apex.h"
@@ -35,9 +35,20 @@ IRecvBuffer::IRecvBuffer(const config_t *cfg, Transport &xport)
       capacity_(0),
       size_(0),
       requests_(nullptr),
-      records_(nullptr)
+      records_(nullptr),
+      out_(nullptr),
+      statuses_(nullptr),
+      next_(0)
 {
-  reserve((limit_) ? std::min(64u, limit_) : 64u);
+  unsigned pool = ISIR_SIZE_CLASSES * ISIR_PREPOST_DEPTH;
+  reserve(std::max(64u, 2 * pool));
+
+  // Prepost the receive pool, round-robin across the size classes so that a
+  // small limit still covers every class.
+  for (unsigned i = 0; i < pool && size_ < capacity_; ++i) {
+    records_[size_].tag = i % ISIR_SIZE_CLASSES;
+    start(size_++);
+  }
 }
 
 IRecvBuffer::~IRecvBuffer()
@@ -52,16 +63,15 @@ int
 IRecvBuffer::progress(hpx_parcel_t** stack)
 {
   assert(stack);
-  probe();
-  std::unique_ptr<int[]> out(new int[size_]);
-  std::unique_ptr<Status[]> statuses(new Status[size_]);
-  int e = xport_.Testsome(size_, &requests_[0], &out[0], &statuses[0]);
+  probe(stack);
+  int e = xport_.Testsome(size_, requests_, out_, statuses_);
   if (e) log_net("detected completed irecvs: %u\n", e);
   for (int i = 0; i < e; ++i) {
-    auto p = finish(out[i], statuses[i]);
-    EVENT_PARCEL_RECV(p->id, p->action, p->size, p->src, p->target);
-    parcel_stack_push(stack, p);
-    start(out[i]);
+    if (auto p = finish(out_[i], statuses_[i])) {
+      EVENT_PARCEL_RECV(p->id, p->action, p->size, p->src, p->target);
+      parcel_stack_push(stack, p);
+    }
+    start(out_[i]);
   }
   return e;
 }
@@ -89,6 +99,8 @@ IRecvBuffer::reserve(unsigned capacity)
   unsigned n = capacity_;
   requests_ = static_cast<Request*>(realloc(requests_, n * sizeof(Request)));
   records_ = static_cast<Record*>(realloc(records_, n* sizeof(Record)));
+  out_ = static_cast<int*>(realloc(out_, n * sizeof(int)));
+  statuses_ = static_cast<Status*>(realloc(statuses_, n * sizeof(Status)));
   return out;
 }
 
@@ -111,36 +123,63 @@ IRecvBuffer::start(unsigned i)
 }
 
 void
-IRecvBuffer::probe()
+IRecvBuffer::probe(hpx_parcel_t** stack)
 {
   int tag = xport_.iprobe();
   if (tag < 0) {
     return;
   }
 
-  auto i = size_++;
-  log_net("detected a new recv (%u) with tag: %u\n", i, tag);
-  records_[i].tag = tag;
-  start(i);
-  if (size_ == capacity_) {
-    reserve(2 * capacity_);
+  if (size_ < capacity_) {
+    auto i = size_++;
+    log_net("detected a new recv (%u) with tag: %u\n", i, tag);
+    records_[i].tag = tag;
+    start(i);
+    if (size_ == capacity_) {
+      reserve(2 * capacity_);
+    }
+    return;
+  }
+
+  // At the limit. If there is already a receive for the tag the message will
+  // match it as soon as it is reposted, otherwise we repurpose a receive for
+  // some other tag. Its tag will in turn be probed for when it is needed.
+  unsigned victim = size_;
+  for (unsigned i = 0; i < size_; ++i) {
+    unsigned j = (next_ + i) % size_;
+    if (records_[j].tag == tag) {
+      return;
+    }
+    if (victim == size_) {
+      victim = j;
+    }
+  }
+  next_ = (victim + 1) % size_;
+
+  log_net("replacing recv (%u) with tag %d by tag: %u\n", victim,
+          records_[victim].tag, tag);
+  if (auto* p = cancel(victim)) {
+    EVENT_PARCEL_RECV(p->id, p->action, p->size, p->src, p->target);
+    parcel_stack_push(stack, p);
   }
+  records_[victim].tag = tag;
+  start(victim);
 }
 
 hpx_parcel_t *
 IRecvBuffer::cancel(unsigned i)
 {
   assert(i < size_);
-  auto& record = records_[i];
-  auto* p = record.p;
-  record.p = NULL;
-  record.tag = -1;
-
-  if (xport_.cancel(requests_[i])) {
-    parcel_delete(p);
-    p = NULL;
+  Status status;
+  hpx_parcel_t *p = NULL;
+  if (xport_.cancel(requests_[i], &status)) {
+    parcel_delete(records_[i].p);
   }
-
+  else {
+    p = finish(i, status);
+  }
+  records_[i].p = NULL;
+  records_[i].tag = -1;
   return p;
 }
 
@@ -148,10 +187,17 @@ hpx_parcel_t*
 IRecvBuffer::finish(unsigned i, const Status& status)
 {
   assert(i < size_);
-  assert(xport_.bytes(status) > 0);
   Record& record = records_[i];
   auto p = record.p;
   record.p = nullptr;
+
+  // Parcels always have a header, so an empty receive is one that the
+  // transport completed with an error.
+  if (!xport_.bytes(status)) {
+    log_net("dropped a failed recv from rank %d\n", xport_.source(status));
+    parcel_delete(p);
+    return nullptr;
+  }
   p->size = isir_bytes_to_payload_size(xport_.bytes(status));
   p->src = xport_.source(status);
   log_net("finished a recv for a %u-byte payload\n", p->size);
@@ -14,7 +14,7 @@
 #ifndef LIBHPX_NETWORK_ISIR_IRECV_BUFFER_H
 #define LIBHPX_NETWORK_ISIR_IRECV_BUFFER_H
 
-#include "MPITransport.h"
+#include "Transport.h"
 #include "libhpx/config.h"
 #include "libhpx/parcel.h"
 
@@ -24,8 +24,8 @@ namespace isir {
 
 class IRecvBuffer {
  public:
-  using Transport = libhpx::network::isir::MPITransport;
-  using Status = libhpx::network::isir::MPITransport::Status;
+  using Transport = libhpx::network::isir::Transport;
+  using Status = Transport::Status;
 
   IRecvBuffer(const config_t *config, Transport &xport);
   ~IRecvBuffer();
@@ -33,7 +33,7 @@ class IRecvBuffer {
   int progress(hpx_parcel_t** recvs);
 
  private:
-  using Request = libhpx::network::isir::MPITransport::Request;
+  using Request = Transport::Request;
   struct Record {
     int tag;
     hpx_parcel_t *p;
@@ -63,12 +63,17 @@ class IRecvBuffer {
 
   /// Probe for unexpected messages.
   ///
-  /// We do not have prior knowledge of the message sizes that we will receive. In
-  /// order to detect messages that have not yet matched an active irecv, we use
-  /// the MPI_Iprobe operation.
+  /// Messages in the size classes normally match a receive from the preposted
+  /// pool, so this mostly finds parcels that are larger than the largest class,
+  /// or classes whose receives are all in use. In order to detect messages that
+  /// have not yet matched an active irecv, we use the MPI_Iprobe operation.
   ///
-  /// The side effect of this operation is to start a new irecv operation.
-  void probe();
+  /// The side effect of this operation is to start a new irecv operation for
+  /// the probed tag, which grows the pool. Once the buffer reaches its limit we
+  /// repurpose a preposted irecv for another tag instead, so that a small
+  /// limit can't leave a tag without any receive. A repurposed irecv that had
+  /// already completed is pushed onto @p stack.
+  void probe(hpx_parcel_t** stack);
 
   /// Cancel an irecv.
   ///
@@ -83,7 +88,8 @@ class IRecvBuffer {
   /// Finish an irecv.
   ///
   /// This will use the status to finish up the irecv, turning it into a usable
-  /// parcel.
+  /// parcel. A failed irecv has no bytes, in which case its buffer is deleted
+  /// and this returns nullptr.
   hpx_parcel_t* finish(unsigned i, const Status& status);
 
   Transport              &xport_;
@@ -92,6 +98,9 @@ class IRecvBuffer {
   unsigned                 size_;
   Request* requests_;
   Record*   records_;
+  int*          out_;                   // Testsome indices, sized to capacity
+  Status*  statuses_;                   // Testsome statuses, sized to capacity
+  unsigned     next_;                   // the next irecv to repurpose
 };
 
 } // namespace isir
@@ -19,12 +19,17 @@
 #include "parcel_utils.h"
 #include "libhpx/debug.h"
 #include "hpx/builtins.h"
+#include <sys/uio.h>
 #include <exception>
 #include <memory>
+#include <vector>
 
 namespace {
 using libhpx::network::isir::ISendBuffer;
 constexpr unsigned ISIR_TWIN_INC = 10;
+
+/// The padding between batched parcels.
+const char BATCH_PADDING[PARCEL_BATCH_ALIGN] = {0};
 }
 
 /// Compute the buffer index of an abstract index.
@@ -47,8 +52,7 @@ _index_of(unsigned long id, unsigned n)
 int
 ISendBuffer::PayloadSizeToTag(unsigned payload)
 {
-  unsigned parcel_size = payload + sizeof(hpx_parcel_t);
-  return ceil_div_32(parcel_size, HPX_CACHELINE_SIZE);
+  return payload_size_to_tag(payload);
 }
 
 /// Re-size an isend buffer to the requested size.
@@ -132,10 +136,33 @@ ISendBuffer::start(unsigned long id)
   hpx_parcel_t *p = records_[i].parcel;
   void *from = isir_network_offset(p);
   unsigned to = gas_.ownerOf(p->target);
-  unsigned n = payload_size_to_isir_bytes(p->size);
-  int tag = PayloadSizeToTag(p->size);
-  log_net("starting a parcel send: tag %d, %d bytes\n", tag, n);
-  requests_[i] = xport_.isend(to, from, n, tag);
+
+  if (!records_[i].batch) {
+    unsigned n = payload_size_to_isir_bytes(p->size);
+    int tag = PayloadSizeToTag(p->size);
+    log_net("starting a parcel send: tag %d, %d bytes\n", tag, n);
+    requests_[i] = xport_.isend(to, from, n, tag);
+    return;
+  }
+
+  // Gather the header's network bytes and then each batched parcel and its
+  // padding, in the layout that parcel_batch_pack() produces.
+  std::vector<struct iovec> iov;
+  iov.push_back({from, size_t(payload_size_to_isir_bytes(0))});
+  uint32_t payload = 0;
+  for (hpx_parcel_t *q = records_[i].batch; q; q = q->next) {
+    uint32_t n = parcel_size(q);
+    uint32_t padded = parcel_batch_size(q);
+    iov.push_back({q, n});
+    if (n != padded) {
+      iov.push_back({const_cast<char*>(BATCH_PADDING), padded - n});
+    }
+    payload += padded;
+  }
+  int tag = PayloadSizeToTag(payload);
+  log_net("starting a batch send: tag %d, %d bytes in %zu pieces\n", tag,
+          payload_size_to_isir_bytes(payload), iov.size());
+  requests_[i] = xport_.isendv(to, &iov[0], iov.size(), tag);
 }
 
 /// Start as many isend operations as we can.
@@ -179,6 +206,9 @@ ISendBuffer::testRange(unsigned i, unsigned n, int* out, hpx_parcel_t **ssync)
 
     // handle each of the completed requests
     parcel_delete(records_[k].parcel);
+    while (hpx_parcel_t *p = parcel_stack_pop(&records_[k].batch)) {
+      parcel_delete(p);
+    }
     while (hpx_parcel_t *p = parcel_stack_pop(&records_[k].ssync)) {
       parcel_stack_push(ssync, p);
     }
@@ -262,6 +292,9 @@ ISendBuffer::cancel(unsigned long id, hpx_parcel_t **parcels)
   unsigned i = _index_of(id, size_);
   xport_.cancel(requests_[i]);
   parcel_stack_push(parcels, records_[i].parcel);
+  while (hpx_parcel_t *p = parcel_stack_pop(&records_[i].batch)) {
+    parcel_stack_push(parcels, p);
+  }
   while (hpx_parcel_t *p = parcel_stack_pop(&records_[i].ssync)) {
     parcel_stack_push(parcels, p);
   }
@@ -309,11 +342,12 @@ ISendBuffer::~ISendBuffer()
 }
 
 void
-ISendBuffer::append(hpx_parcel_t *p, hpx_parcel_t *ssync)
+ISendBuffer::append(hpx_parcel_t *p, hpx_parcel_t *ssync, hpx_parcel_t *batch)
 {
   unsigned max = _index_of(max_++, size_);
   records_[max].parcel = p;
   records_[max].ssync = ssync;
+  records_[max].batch = batch;
   if (size_ <= max_ - min_) {
     reserve(2 * size_);
   }
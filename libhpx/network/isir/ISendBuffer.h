@@ -14,7 +14,7 @@
 #ifndef LIBHPX_NETWORK_ISIR_ISEND_BUFFER_H
 #define LIBHPX_NETWORK_ISIR_ISEND_BUFFER_H
 
-#include "MPITransport.h"
+#include "Transport.h"
 #include "libhpx/config.h"
 #include "libhpx/GAS.h"
 #include "libhpx/parcel.h"
@@ -23,7 +23,7 @@ namespace libhpx {
 namespace network {
 namespace isir {
 class ISendBuffer {
-  using Transport = libhpx::network::isir::MPITransport;
+  using Transport = libhpx::network::isir::Transport;
   using Request = Transport::Request;
 
  public:
@@ -41,9 +41,15 @@ class ISendBuffer {
   ///
   /// This may or may not start the send immediately.
   ///
+  /// If @p batch is not null then @p p is a header, and the send gathers the
+  /// batch parcels into its payload straight from their buffers, without
+  /// copying them. The batch parcels are deleted when the send completes.
+  ///
   /// @param            p The stack of parcels to send.
   /// @param        ssync The stack of parcel continuations.
-  void append(hpx_parcel_t *p, hpx_parcel_t *ssync);
+  /// @param        batch The stack of parcels to gather, if any.
+  void append(hpx_parcel_t *p, hpx_parcel_t *ssync,
+              hpx_parcel_t *batch = nullptr);
 
   /// Progress the sends in the buffer.
   ///
@@ -66,6 +72,7 @@ class ISendBuffer {
   struct Record {
     hpx_parcel_t *parcel;
     hpx_parcel_t *ssync;
+    hpx_parcel_t *batch;
   };
 
   static int PayloadSizeToTag(unsigned payload);
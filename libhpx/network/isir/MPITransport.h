@@ -15,9 +15,14 @@
 #define LIBHPX_NETWORK_ISIR_MPI_TRANSPORT_H
 
 #include "hpx/hpx.h"
+#include "libhpx/config.h"
+#include "libhpx/boot/Network.h"
+#include "libhpx/debug.h"
 #include <mpi.h>
+#include <sys/uio.h>
 #include <algorithm>
 #include <exception>
+#include <memory>
 #include <new>
 #include <alloca.h>
 #include <cassert>
@@ -32,15 +37,27 @@ class MPITransport {
   typedef MPI_Request Request;
   typedef MPI_Status Status;
 
-  MPITransport() : world_(MPI_COMM_NULL), finalize_(false) {
+  /// Each transport duplicates the world communicator, so transports that are
+  /// constructed in the same order on every rank match each other.
+  MPITransport(const config_t* cfg, const boot::Network&)
+      : world_(MPI_COMM_NULL), finalize_(false)
+  {
+    int required = (cfg->isir_multiple) ? MPI_THREAD_MULTIPLE :
+                   MPI_THREAD_SERIALIZED;
     int initialized;
+    int level;
     Check(MPI_Initialized(&initialized));
     if (!initialized) {
-      int level;
-      Check(MPI_Init_thread(nullptr, nullptr, MPI_THREAD_SERIALIZED, &level));
-      assert(level >= MPI_THREAD_SERIALIZED);
+      Check(MPI_Init_thread(nullptr, nullptr, required, &level));
       finalize_ = true;
     }
+    else {
+      Check(MPI_Query_thread(&level));
+    }
+    if (level < required) {
+      dbg_error("MPI provides thread level %d, the ISIR network needs %d\n",
+                level, required);
+    }
     Check(MPI_Comm_dup(MPI_COMM_WORLD, &world_));
   }
 
@@ -51,7 +68,9 @@ class MPITransport {
     }
   }
 
-  static bool cancel(Request& request) {
+  /// Cancel a request, or wait for it if it can't be cancelled, in which case
+  /// its status is written to @p out.
+  static bool cancel(Request& request, Status* out = nullptr) {
     if (request == MPI_REQUEST_NULL) {
       return true;
     }
@@ -62,6 +81,9 @@ class MPITransport {
     MPITransport::Check(MPI_Wait(&request, &status));
     MPITransport::Check(MPI_Test_cancelled(&status, &cancelled));
     request = MPI_REQUEST_NULL;
+    if (!cancelled && out) {
+      *out = status;
+    }
     return cancelled;
   }
 
@@ -88,6 +110,25 @@ class MPITransport {
     return request;
   }
 
+  /// Send a message gathered from @p n pieces, without copying them.
+  Request isendv(int to, const struct iovec *iov, int n, int tag) {
+    // These come from the heap because lightweight thread stacks are small.
+    std::unique_ptr<int[]> lengths(new int[n]);
+    std::unique_ptr<MPI_Aint[]> displacements(new MPI_Aint[n]);
+    for (int i = 0; i < n; ++i) {
+      lengths[i] = iov[i].iov_len;
+      Check(MPI_Get_address(iov[i].iov_base, &displacements[i]));
+    }
+    MPI_Datatype type;
+    Check(MPI_Type_create_hindexed(n, &lengths[0], &displacements[0], MPI_BYTE,
+                                   &type));
+    Check(MPI_Type_commit(&type));
+    Request request;
+    Check(MPI_Isend(MPI_BOTTOM, 1, type, to, tag, world_, &request));
+    Check(MPI_Type_free(&type));
+    return request;
+  }
+
   Request irecv(void *to, size_t n, int tag) {
     Request request;
     Check(MPI_Irecv(to, n, MPI_BYTE, MPI_ANY_SOURCE, tag, world_, &request));
@@ -152,6 +193,66 @@ class MPITransport {
     out->put(result);
   }
 
+  void allgather(void *sendbuf, void *result, int count, Communicator *comm)
+  {
+    Check(MPI_Allgather(sendbuf, count, MPI_BYTE, result, count, MPI_BYTE,
+                        *comm));
+  }
+
+  void alltoall(void *sendbuf, void *result, int count, Communicator *comm)
+  {
+    Check(MPI_Alltoall(sendbuf, count, MPI_BYTE, result, count, MPI_BYTE,
+                       *comm));
+  }
+
+  void reduceScatter(void *sendbuf, void *result, int count,
+                     hpx_monoid_op_t *op, Communicator *comm)
+  {
+    int n;
+    Check(MPI_Comm_size(*comm, &n));
+
+    // Every block needs its own operation header, so we reduce whole blocks
+    // using a contiguous datatype rather than bytes.
+    int bytes = sizeof(CollectiveArg) + count;
+    char *in = new char[n * bytes];
+    for (int i = 0; i < n; ++i) {
+      char *block = static_cast<char*>(sendbuf) + i * count;
+      new(in + i * bytes) CollectiveArg(*op, count, block);
+    }
+    CollectiveArg* out = new(alloca(bytes)) CollectiveArg(*op, 0, nullptr);
+
+    MPI_Datatype type;
+    Check(MPI_Type_contiguous(bytes, MPI_BYTE, &type));
+    Check(MPI_Type_commit(&type));
+    MPI_Op usrOp;
+    Check(MPI_Op_create(CollectiveArg::BlockOp, 1, &usrOp));
+    Check(MPI_Reduce_scatter_block(in, out, 1, type, usrOp, *comm));
+    Check(MPI_Op_free(&usrOp));
+    Check(MPI_Type_free(&type));
+    delete [] in;
+    out->put(result);
+  }
+
+  void scan(void *sendbuf, void *result, int count, hpx_monoid_op_t *op,
+            bool exclusive, Communicator *comm)
+  {
+    int bytes = sizeof(CollectiveArg) + count;
+    CollectiveArg* in = new(alloca(bytes)) CollectiveArg(*op, count, sendbuf);
+    CollectiveArg* out = new(alloca(bytes)) CollectiveArg(*op, 0, nullptr);
+
+    MPI_Op usrOp;
+    Check(MPI_Op_create(CollectiveArg::Op, 1, &usrOp));
+    if (exclusive) {
+      // rank 0's output is undefined, the caller writes the identity there
+      Check(MPI_Exscan(in, out, bytes, MPI_BYTE, usrOp, *comm));
+    }
+    else {
+      Check(MPI_Scan(in, out, bytes, MPI_BYTE, usrOp, *comm));
+    }
+    Check(MPI_Op_free(&usrOp));
+    out->put(result);
+  }
+
   static void pin(const void*, size_t, void*) {
   }
 
@@ -171,7 +272,8 @@ class MPITransport {
         : op_(op), size_(size)
     {
       if (data) {
-        std::copy(data_, data_+size, static_cast<char*>(data));
+        std::copy(static_cast<char*>(data), static_cast<char*>(data) + size,
+                  data_);
       }
     }
 
@@ -182,6 +284,17 @@ class MPITransport {
       in->op(out);
     }
 
+    /// Reduce @p n whole blocks of a contiguous block datatype.
+    static void BlockOp(void* lhs, void* rhs, int* n, MPI_Datatype* type)
+    {
+      int bytes;
+      Check(MPI_Type_size(*type, &bytes));
+      for (int i = 0; i < *n; ++i) {
+        Op(static_cast<char*>(lhs) + i * bytes,
+           static_cast<char*>(rhs) + i * bytes, nullptr, nullptr);
+      }
+    }
+
     void put(void *out) const
     {
       std::move(data_, data_ + size_, static_cast<char*>(out));
@@ -0,0 +1,256 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+/// @file libhpx/network/isir/MultipleNetwork.cpp
+/// @brief Implements the per-worker isend/irecv network.
+
+#include "MultipleNetwork.h"
+#include "libhpx/collective.h"
+#include "libhpx/debug.h"
+#include "libhpx/parcel.h"
+#include "libhpx/Worker.h"
+#include <algorithm>
+
+namespace {
+using libhpx::self;
+using libhpx::Network;
+using libhpx::network::isir::MultipleNetwork;
+}
+
+MultipleNetwork::Lane::Lane(const config_t *cfg, const boot::Network& boot,
+                            GAS *gas)
+    : xport(cfg, boot),
+      isends(cfg, gas, xport),
+      irecvs(cfg, xport),
+      recvs(),
+      lock()
+{
+}
+
+MultipleNetwork::Lane::~Lane()
+{
+  while (hpx_parcel_t *p = recvs.dequeue()) {
+    parcel_delete(p);
+  }
+}
+
+void
+MultipleNetwork::Lane::progress()
+{
+  if (auto _ = std::unique_lock<std::mutex>(lock, std::try_to_lock)) {
+    hpx_parcel_t *chain = NULL;
+    if (int n = irecvs.progress(&chain)) {
+      log_net("completed %d recvs\n", n);
+      recvs.enqueue(chain);
+    }
+    chain = NULL;
+    if (int n = isends.progress(&chain)) {
+      log_net("completed %d sends\n", n);
+      recvs.enqueue(chain);
+    }
+  }
+}
+
+MultipleNetwork::MultipleNetwork(const config_t *cfg, const boot::Network& boot,
+                                 GAS *gas)
+    : Network(),
+      ParcelStringOps(),
+      ParcelLCOOps(),
+      util::Aligned<HPX_CACHELINE_SIZE>(),
+      lanes_()
+{
+  // Lanes are matched by index, so every rank needs the same number of them.
+  int ranks = boot.getNRanks();
+  std::vector<int> threads(ranks);
+  boot.allgather(&cfg->threads, &threads[0], sizeof(int));
+  int n = std::max(1, *std::min_element(threads.begin(), threads.end()));
+
+  lanes_.reserve(n);
+  for (int i = 0; i < n; ++i) {
+    lanes_.emplace_back(new Lane(cfg, boot, gas));
+  }
+  log_net("ISIR network using %d lanes\n", n);
+}
+
+MultipleNetwork::~MultipleNetwork()
+{
+  // Only the first lane's transport can own the MPI environment, since it is
+  // created first, so it has to be destroyed after the other lanes have freed
+  // their communicators.
+  while (!lanes_.empty()) {
+    lanes_.pop_back();
+  }
+}
+
+int
+MultipleNetwork::type() const {
+  return HPX_NETWORK_ISIR;
+}
+
+MultipleNetwork::Lane&
+MultipleNetwork::lane()
+{
+  unsigned i = (self) ? self->getId() % lanes_.size() : 0;
+  return *lanes_[i];
+}
+
+int
+MultipleNetwork::init(void **ctx)
+{
+  flush();
+
+  auto coll = static_cast<coll_t*>(*ctx);
+  int num_active = coll->group_sz;
+  log_net("ISIR network collective being initialized."
+          "Total active ranks: %d\n", num_active);
+  int32_t *ranks = reinterpret_cast<int32_t*>(coll->data);
+
+  if (coll->comm_bytes == 0) {
+    // we have not yet allocated a communicator
+    coll->comm_bytes = sizeof(Transport::Communicator);
+    auto bytes = sizeof(coll_t) + coll->group_bytes + coll->comm_bytes;
+    coll = static_cast<coll_t*>(realloc(coll, bytes));
+    *ctx = coll;
+  }
+
+  // setup communicator, collectives always run on the first lane
+  auto offset = coll->data + coll->group_bytes;
+  auto comm = reinterpret_cast<Transport::Communicator*>(offset);
+  Lane& lane = *lanes_[0];
+  std::lock_guard<std::mutex> _(lane.lock);
+  lane.xport.createComm(comm, num_active, ranks);
+  return 0;
+}
+
+int
+MultipleNetwork::sync(void *in, size_t count, void *out, void *ctx)
+{
+  flush();
+
+  auto coll = static_cast<coll_t *>(ctx);
+  auto offset = coll->data + coll->group_bytes;
+  auto comm = reinterpret_cast<Transport::Communicator*>(offset);
+  Lane& lane = *lanes_[0];
+  std::lock_guard<std::mutex> _(lane.lock);
+  switch (coll->type) {
+   case ALL_REDUCE:
+    lane.xport.allreduce(in, out, count, NULL, &coll->op, comm);
+    break;
+   case ALL_GATHER:
+    lane.xport.allgather(in, out, count, comm);
+    break;
+   case REDUCE_SCATTER:
+    lane.xport.reduceScatter(in, out, count, &coll->op, comm);
+    break;
+   case SCAN:
+    lane.xport.scan(in, out, count, &coll->op, false, comm);
+    break;
+   case EXSCAN:
+    lane.xport.scan(in, out, count, &coll->op, true, comm);
+    break;
+   case ALL_TO_ALL:
+    lane.xport.alltoall(in, out, count, comm);
+    break;
+   default:
+    log_dflt("Collective type descriptor: %d is invalid!\n", coll->type);
+    break;
+  }
+  return 0;
+}
+
+void
+MultipleNetwork::deallocate(const hpx_parcel_t* p)
+{
+  dbg_error("ISIR network has not network-managed parcels\n");
+}
+
+int
+MultipleNetwork::send(hpx_parcel_t *p, hpx_parcel_t *ssync) {
+  // Start the isend directly on our own lane, there's nobody to funnel to.
+  Lane& lane = this->lane();
+  std::lock_guard<std::mutex> _(lane.lock);
+  lane.isends.append(p, ssync);
+  return 0;
+}
+
+int
+MultipleNetwork::sendBatch(hpx_parcel_t *p, hpx_parcel_t *batch,
+                           hpx_parcel_t *ssync) {
+  Lane& lane = this->lane();
+  std::lock_guard<std::mutex> _(lane.lock);
+  lane.isends.append(p, ssync, batch);
+  return 0;
+}
+
+hpx_parcel_t *
+MultipleNetwork::probe(int) {
+  if (hpx_parcel_t *p = lane().recvs.dequeue()) {
+    return p;
+  }
+
+  // Progress can complete receives on any lane, so take them from the other
+  // lanes rather than leaving them until their own worker probes.
+  unsigned n = lanes_.size();
+  unsigned i = (self) ? self->getId() % n : 0;
+  for (unsigned j = 1; j < n; ++j) {
+    if (hpx_parcel_t *p = lanes_[(i + j) % n]->recvs.dequeue()) {
+      return p;
+    }
+  }
+  return NULL;
+}
+
+void
+MultipleNetwork::flush()
+{
+  for (auto&& lane : lanes_) {
+    std::lock_guard<std::mutex> _(lane->lock);
+    hpx_parcel_t *ssync = NULL;
+    lane->isends.flush(&ssync);
+    if (ssync) {
+      lane->recvs.enqueue(ssync);
+    }
+  }
+}
+
+void
+MultipleNetwork::pin(const void *base, size_t n, void *key)
+{
+  for (auto&& lane : lanes_) {
+    lane->xport.pin(base, n, key);
+  }
+}
+
+void
+MultipleNetwork::unpin(const void* base, size_t n)
+{
+  for (auto&& lane : lanes_) {
+    lane->xport.unpin(base, n);
+  }
+}
+
+void
+MultipleNetwork::progress(int)
+{
+  lane().progress();
+
+  // Help one other lane along, in case its worker is busy running a thread.
+  if (lanes_.size() > 1) {
+    static __thread unsigned next;
+    lanes_[next++ % lanes_.size()]->progress();
+  }
+}
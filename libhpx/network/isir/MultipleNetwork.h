@@ -0,0 +1,98 @@
+// ==================================================================-*- C++ -*-
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifndef LIBHPX_NETWORK_ISIR_MULTIPLE_NETWORK_H
+#define LIBHPX_NETWORK_ISIR_MULTIPLE_NETWORK_H
+
+#include "libhpx/Network.h"
+#include "IRecvBuffer.h"
+#include "ISendBuffer.h"
+#include "Transport.h"
+#include "libhpx/ParcelLCOOps.h"
+#include "libhpx/ParcelStringOps.h"
+#include "libhpx/util/Aligned.h"
+#include "libhpx/util/TwoLockQueue.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace libhpx {
+namespace network {
+namespace isir {
+/// An isend/irecv network without the funnel.
+///
+/// The FunneledNetwork serializes every send through a single queue and send
+/// buffer. This network instead gives each worker a lane with its own
+/// transport, send buffer, and receive buffer. The transports are independent
+/// duplicates of the world, so a message sent on lane i is received on lane i
+/// at the destination, and workers post and test their own requests
+/// concurrently. For MPI this requires MPI_THREAD_MULTIPLE.
+///
+/// Each lane is protected by its own lock, which is almost always uncontended.
+/// Workers also try to progress one other lane each time they poll the
+/// network, and take completed receives from the other lanes when their own
+/// lane has none, so that a lane whose worker is busy doesn't strand its
+/// messages.
+class MultipleNetwork : public Network, public ParcelStringOps,
+                        public ParcelLCOOps,
+                        public util::Aligned<HPX_CACHELINE_SIZE>
+{
+ public:
+  MultipleNetwork(const config_t *cfg, const boot::Network& boot, GAS *gas);
+  ~MultipleNetwork();
+
+  int type() const;
+  void progress(int);
+  hpx_parcel_t* probe(int);
+  void flush();
+
+  void deallocate(const hpx_parcel_t* p);
+  int send(hpx_parcel_t* p, hpx_parcel_t* ssync);
+  int sendBatch(hpx_parcel_t* p, hpx_parcel_t* batch, hpx_parcel_t* ssync);
+
+  void pin(const void *base, size_t bytes, void *key);
+  void unpin(const void *base, size_t bytes);
+
+  int init(void **collective);
+  int sync(void *in, size_t in_size, void* out, void *collective);
+
+ private:
+  using Transport = libhpx::network::isir::Transport;
+  using IRecvBuffer = libhpx::network::isir::IRecvBuffer;
+  using ISendBuffer = libhpx::network::isir::ISendBuffer;
+  using ParcelQueue = libhpx::util::TwoLockQueue<hpx_parcel_t*>;
+
+  struct Lane : public util::Aligned<HPX_CACHELINE_SIZE> {
+    Lane(const config_t *cfg, const boot::Network& boot, GAS *gas);
+    ~Lane();
+
+    /// Progress the lane's requests, if nobody else is.
+    void progress();
+
+    Transport     xport;
+    ISendBuffer  isends;
+    IRecvBuffer  irecvs;
+    ParcelQueue   recvs;                    // completed receives and ssyncs
+    std::mutex     lock;
+  };
+
+  /// The lane used by the calling thread.
+  Lane& lane();
+
+  std::vector<std::unique_ptr<Lane>> lanes_;   // destroyed in reverse order
+};
+} // namespace isir
+} // namespace network
+} // namespace libhpx
+
+#endif // LIBHPX_NETWORK_ISIR_MULTIPLE_NETWORK_H
@@ -0,0 +1,683 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+/// @file libhpx/network/isir/TCPTransport.cpp
+/// @brief Implements the TCP isend/irecv transport.
+///
+/// Every message on a socket is an 8-byte header holding the tag and the byte
+/// count, followed by the bytes. A receive that is already posted for the tag
+/// when the header arrives reads the bytes directly into its buffer, otherwise
+/// they are read into an unexpected message that is copied when the receive is
+/// eventually posted, just like an MPI eager protocol.
+
+#include "TCPTransport.h"
+#include "libhpx/debug.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace {
+using libhpx::network::isir::TCPTransport;
+using Message = TCPTransport::Message;
+
+/// The maximum number of iovecs in a single writev.
+constexpr int IOV_BATCH = 64;
+
+/// The maximum number of events handled in one progress call.
+constexpr int EVENT_BATCH = 64;
+
+struct Header {
+  int32_t    tag;
+  uint32_t bytes;
+};
+
+/// The address of each rank's listening socket.
+struct Endpoint {
+  in_addr_t addr;
+  in_port_t port;
+};
+
+/// Blocking I/O for connection setup.
+/// @{
+void
+_write(int fd, const void *src, size_t n)
+{
+  auto bytes = static_cast<const char*>(src);
+  while (n) {
+    ssize_t e = write(fd, bytes, n);
+    if (e < 0 && errno == EINTR) {
+      continue;
+    }
+    if (e <= 0) {
+      dbg_error("TCP transport setup write failed (%s)\n", strerror(errno));
+    }
+    bytes += e;
+    n -= e;
+  }
+}
+
+void
+_read(int fd, void *dest, size_t n)
+{
+  auto bytes = static_cast<char*>(dest);
+  while (n) {
+    ssize_t e = read(fd, bytes, n);
+    if (e < 0 && errno == EINTR) {
+      continue;
+    }
+    if (e <= 0) {
+      dbg_error("TCP transport setup read failed (%s)\n", strerror(errno));
+    }
+    bytes += e;
+    n -= e;
+  }
+}
+/// @}
+
+/// Find an address that the other ranks can use to reach this host.
+in_addr_t
+_host_address()
+{
+  char host[256];
+  struct addrinfo hints, *info;
+  std::memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+  if (gethostname(host, sizeof(host)) ||
+      getaddrinfo(host, nullptr, &hints, &info)) {
+    log_net("could not resolve the host name, using the loopback address\n");
+    return htonl(INADDR_LOOPBACK);
+  }
+  in_addr_t addr = reinterpret_cast<sockaddr_in*>(info->ai_addr)->sin_addr.s_addr;
+  freeaddrinfo(info);
+  return addr;
+}
+}
+
+/// A send, a posted receive, or a buffered unexpected message.
+class TCPTransport::Message {
+ public:
+  enum Kind { SEND, RECV, UNEXPECTED };
+
+  Message(Kind kind, int peer, int tag, char *buffer, size_t n)
+      : kind(kind), peer(peer), tag(tag), buffer(buffer), n(n), bytes(0),
+        offset(0), done(false), match(nullptr), header{tag, uint32_t(n)}, iov()
+  {
+  }
+
+  Message(int peer, int tag, const struct iovec *iov, int k, size_t n)
+      : kind(SEND), peer(peer), tag(tag), buffer(nullptr), n(n), bytes(0),
+        offset(0), done(false), match(nullptr), header{tag, uint32_t(n)},
+        iov(iov, iov + k)
+  {
+  }
+
+  ~Message() {
+    if (kind == UNEXPECTED) {
+      delete [] buffer;
+    }
+  }
+
+  const Kind   kind;
+  int          peer;
+  const int     tag;
+  char      *buffer;
+  const size_t    n;                    // the send or receive buffer size
+  size_t      bytes;                    // the number of bytes received
+  size_t     offset;                    // the number of bytes read so far
+  bool         done;
+  Message    *match;                    // the receive for an unexpected message
+  Header     header;                    // the wire header for a send
+  std::vector<struct iovec> iov;        // the pieces of a send
+};
+
+struct TCPTransport::Connection {
+  Connection(int fd, int peer)
+      : fd(fd), peer(peer), sends(), sent(0), polling(false), header(), got(0),
+        recv(nullptr)
+  {
+  }
+
+  int                     fd;
+  const int             peer;
+  std::deque<Message*> sends;
+  size_t                sent;           // bytes of the first send written
+  bool               polling;           // are we waiting for EPOLLOUT
+  Header              header;           // the header being read
+  size_t                 got;           // bytes of the header read so far
+  Message              *recv;           // the message being read
+};
+
+TCPTransport::TCPTransport(const config_t *cfg, const boot::Network& boot)
+    : rank_(boot.getRank()),
+      ranks_(boot.getNRanks()),
+      connections_(std::max(1u, cfg->isir_connections)),
+      epoll_(epoll_create1(0)),
+      conns_(ranks_ * connections_),
+      next_(ranks_),
+      posted_(),
+      unexpected_()
+{
+  if (epoll_ < 0) {
+    dbg_error("could not create the TCP transport epoll (%s)\n",
+              strerror(errno));
+  }
+
+  connectAll(boot);
+
+  // Switch all of the sockets to nonblocking mode and start polling them.
+  for (auto&& c : conns_) {
+    if (!c) {
+      continue;
+    }
+    int one = 1;
+    setsockopt(c->fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    fcntl(c->fd, F_SETFL, fcntl(c->fd, F_GETFL) | O_NONBLOCK);
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = c.get();
+    if (epoll_ctl(epoll_, EPOLL_CTL_ADD, c->fd, &event)) {
+      dbg_error("could not poll TCP connection (%s)\n", strerror(errno));
+    }
+  }
+  log_net("TCP transport connected with %u connections per peer\n",
+          connections_);
+}
+
+TCPTransport::~TCPTransport()
+{
+  for (auto&& c : conns_) {
+    if (c && c->fd >= 0) {
+      ::close(c->fd);
+    }
+  }
+  ::close(epoll_);
+  for (auto&& i : posted_) {
+    for (auto m : i.second) {
+      delete m;
+    }
+  }
+  for (auto m : unexpected_) {
+    delete m;
+  }
+}
+
+void
+TCPTransport::connectAll(const boot::Network& boot)
+{
+  // Listen only on the address that we advertise to the other ranks.
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  struct sockaddr_in addr;
+  socklen_t len = sizeof(addr);
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = _host_address();
+  addr.sin_port = 0;
+  if (bind(fd, reinterpret_cast<sockaddr*>(&addr), len) ||
+      listen(fd, SOMAXCONN) ||
+      getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len)) {
+    dbg_error("could not listen for TCP connections (%s)\n", strerror(errno));
+  }
+
+  Endpoint local = { addr.sin_addr.s_addr, addr.sin_port };
+  std::vector<Endpoint> endpoints(ranks_);
+  boot.allgather(&local, &endpoints[0], sizeof(local));
+
+  // We connect to the lower ranks, and accept connections from the higher
+  // ranks. Connecting only needs the peer's listen backlog, so this can't
+  // deadlock.
+  for (int peer = 0; peer < rank_; ++peer) {
+    for (unsigned i = 0; i < connections_; ++i) {
+      std::memset(&addr, 0, sizeof(addr));
+      addr.sin_family = AF_INET;
+      addr.sin_addr.s_addr = endpoints[peer].addr;
+      addr.sin_port = endpoints[peer].port;
+      int c = socket(AF_INET, SOCK_STREAM, 0);
+      if (connect(c, reinterpret_cast<sockaddr*>(&addr), sizeof(addr))) {
+        dbg_error("could not connect to rank %d (%s)\n", peer, strerror(errno));
+      }
+      _write(c, &rank_, sizeof(rank_));
+      conns_[peer * connections_ + i].reset(new Connection(c, peer));
+    }
+  }
+
+  for (int n = (ranks_ - rank_ - 1) * connections_; n; --n) {
+    int c = accept(fd, nullptr, nullptr);
+    if (c < 0) {
+      dbg_error("could not accept TCP connection (%s)\n", strerror(errno));
+    }
+    int peer;
+    _read(c, &peer, sizeof(peer));
+    if (peer <= rank_ || ranks_ <= peer) {
+      dbg_error("unexpected TCP connection from rank %d\n", peer);
+    }
+    auto i = conns_.begin() + peer * connections_;
+    auto e = i + connections_;
+    i = std::find(i, e, nullptr);
+    if (i == e) {
+      dbg_error("too many TCP connections from rank %d\n", peer);
+    }
+    i->reset(new Connection(c, peer));
+  }
+  ::close(fd);
+}
+
+void
+TCPTransport::progress()
+{
+  struct epoll_event events[EVENT_BATCH];
+  int n = epoll_wait(epoll_, events, EVENT_BATCH, 0);
+  if (n < 0 && errno != EINTR) {
+    dbg_error("TCP transport epoll failed (%s)\n", strerror(errno));
+  }
+
+  for (int i = 0; i < n; ++i) {
+    auto c = static_cast<Connection*>(events[i].data.ptr);
+    if (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) {
+      recvAll(*c);
+    }
+    if (c->fd >= 0 && (events[i].events & EPOLLOUT)) {
+      sendAll(*c);
+    }
+  }
+}
+
+void
+TCPTransport::sendAll(Connection& c)
+{
+  while (!c.sends.empty()) {
+    // Gather as many of the queued sends as we can into one writev.
+    struct iovec iov[IOV_BATCH];
+    int n = 0;
+    size_t skip = c.sent;
+    for (auto i = c.sends.begin(), e = c.sends.end(); i != e; ++i) {
+      if (n == IOV_BATCH) {
+        break;
+      }
+      Message* m = *i;
+      size_t header = sizeof(m->header);
+      if (skip < header) {
+        iov[n++] = { reinterpret_cast<char*>(&m->header) + skip, header - skip };
+        skip = 0;
+      }
+      else {
+        skip -= header;
+      }
+
+      // A send with more pieces than fit is finished by a later writev.
+      for (auto& v : m->iov) {
+        if (n == IOV_BATCH) {
+          break;
+        }
+        if (skip >= v.iov_len) {
+          skip -= v.iov_len;
+          continue;
+        }
+        iov[n++] = { static_cast<char*>(v.iov_base) + skip, v.iov_len - skip };
+        skip = 0;
+      }
+    }
+
+    struct msghdr msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = n;
+    ssize_t e = sendmsg(c.fd, &msg, MSG_NOSIGNAL);
+    if (e < 0 && errno == EINTR) {
+      continue;
+    }
+    if (e < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      break;
+    }
+    if (e < 0) {
+      log_net("TCP send to rank %d failed (%s)\n", c.peer, strerror(errno));
+      close(c);
+      return;
+    }
+
+    // Complete the sends that were written.
+    size_t written = e;
+    while (written) {
+      Message* m = c.sends.front();
+      size_t remaining = sizeof(m->header) + m->n - c.sent;
+      if (written < remaining) {
+        c.sent += written;
+        break;
+      }
+      written -= remaining;
+      m->done = true;
+      c.sends.pop_front();
+      c.sent = 0;
+    }
+  }
+
+  // Only poll for writability while we have something to write.
+  bool polling = !c.sends.empty();
+  if (polling != c.polling) {
+    struct epoll_event event;
+    event.events = EPOLLIN | ((polling) ? EPOLLOUT : 0);
+    event.data.ptr = &c;
+    epoll_ctl(epoll_, EPOLL_CTL_MOD, c.fd, &event);
+    c.polling = polling;
+  }
+}
+
+void
+TCPTransport::recvAll(Connection& c)
+{
+  while (c.fd >= 0) {
+    ssize_t e;
+    if (!c.recv) {
+      char *header = reinterpret_cast<char*>(&c.header);
+      e = read(c.fd, header + c.got, sizeof(c.header) - c.got);
+    }
+    else {
+      Message* m = c.recv;
+      e = read(c.fd, m->buffer + m->offset, m->bytes - m->offset);
+    }
+
+    if (e < 0 && errno == EINTR) {
+      continue;
+    }
+    if (e < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      return;
+    }
+    if (e <= 0) {
+      // Peers close their connections when they shut down.
+      log_net("TCP connection to rank %d closed\n", c.peer);
+      close(c);
+      return;
+    }
+
+    if (!c.recv) {
+      c.got += e;
+      if (c.got < sizeof(c.header)) {
+        continue;
+      }
+      c.recv = match(c.peer, c.header.tag, c.header.bytes);
+      c.got = 0;
+    }
+    else {
+      c.recv->offset += e;
+    }
+
+    if (c.recv->offset == c.recv->bytes) {
+      finish(c.recv);
+      c.recv = nullptr;
+    }
+  }
+}
+
+Message*
+TCPTransport::match(int src, int tag, size_t bytes)
+{
+  Message* m = nullptr;
+  auto i = posted_.find(tag);
+  if (i != posted_.end() && !i->second.empty()) {
+    m = i->second.front();
+    i->second.pop_front();
+    if (m->n < bytes) {
+      dbg_error("%zu-byte message from rank %d truncated by %zu-byte recv\n",
+                bytes, src, m->n);
+    }
+  }
+  else {
+    m = new Message(Message::UNEXPECTED, src, tag, new char[bytes], bytes);
+    unexpected_.push_back(m);
+  }
+  m->peer = src;
+  m->bytes = bytes;
+  m->offset = 0;
+  return m;
+}
+
+void
+TCPTransport::finish(Message* m)
+{
+  m->done = true;
+  if (m->kind != Message::UNEXPECTED || !m->match) {
+    return;
+  }
+
+  // Someone posted a receive while this was being read.
+  Message* r = m->match;
+  std::memcpy(r->buffer, m->buffer, m->bytes);
+  r->peer = m->peer;
+  r->bytes = m->bytes;
+  r->done = true;
+  unexpected_.remove(m);
+  delete m;
+}
+
+void
+TCPTransport::close(Connection& c)
+{
+  epoll_ctl(epoll_, EPOLL_CTL_DEL, c.fd, nullptr);
+  ::close(c.fd);
+  c.fd = -1;
+
+  // Nothing queued on this connection can go anywhere now, so just complete
+  // it. This happens when peers shut down with traffic still in flight.
+  for (auto m : c.sends) {
+    m->done = true;
+  }
+  c.sends.clear();
+
+  // A message that was cut off can't finish, so its receive completes with an
+  // error, i.e., with no bytes. If it was still unexpected then this is the
+  // receive that was posted for it while it was being read, if any.
+  if (Message* m = c.recv) {
+    Message* r = (m->kind == Message::UNEXPECTED) ? m->match : m;
+    if (r) {
+      r->peer = c.peer;
+      r->bytes = 0;
+      r->done = true;
+    }
+    if (m->kind == Message::UNEXPECTED) {
+      unexpected_.remove(m);
+      delete m;
+    }
+  }
+  c.recv = nullptr;
+}
+
+int
+TCPTransport::iprobe()
+{
+  progress();
+  for (auto m : unexpected_) {
+    if (!m->match) {
+      return m->tag;
+    }
+  }
+  return -1;
+}
+
+TCPTransport::Request
+TCPTransport::isend(int to, const void *from, size_t n, int tag)
+{
+  struct iovec iov = { const_cast<void*>(from), n };
+  return isendv(to, &iov, 1, tag);
+}
+
+TCPTransport::Request
+TCPTransport::isendv(int to, const struct iovec *iov, int k, int tag)
+{
+  size_t n = 0;
+  for (int i = 0; i < k; ++i) {
+    n += iov[i].iov_len;
+  }
+  Message* m = new Message(to, tag, iov, k, n);
+
+  // Sends to ourself are matched immediately.
+  if (to == rank_) {
+    Message* r = match(rank_, tag, n);
+    char *buffer = r->buffer;
+    for (int i = 0; i < k; ++i) {
+      std::memcpy(buffer, iov[i].iov_base, iov[i].iov_len);
+      buffer += iov[i].iov_len;
+    }
+    r->offset = n;
+    finish(r);
+    m->done = true;
+    return m;
+  }
+
+  // Spread the sends to each peer across its connections.
+  unsigned i = next_[to]++ % connections_;
+  Connection& c = *conns_[to * connections_ + i];
+  if (c.fd < 0) {
+    dbg_error("send to rank %d after its connection closed\n", to);
+  }
+  c.sends.push_back(m);
+  if (c.sends.size() == 1) {
+    sendAll(c);
+  }
+  return m;
+}
+
+TCPTransport::Request
+TCPTransport::irecv(void *to, size_t n, int tag)
+{
+  Message* m = new Message(Message::RECV, -1, tag, static_cast<char*>(to), n);
+  for (auto i = unexpected_.begin(), e = unexpected_.end(); i != e; ++i) {
+    Message* u = *i;
+    if (u->tag != tag || u->match) {
+      continue;
+    }
+    if (u->n > n) {
+      dbg_error("%zu-byte message from rank %d truncated by %zu-byte recv\n",
+                u->n, u->peer, n);
+    }
+    u->match = m;
+    if (u->done) {
+      finish(u);
+    }
+    return m;
+  }
+  posted_[tag].push_back(m);
+  return m;
+}
+
+int
+TCPTransport::Testsome(int n, Request* reqs, int* out)
+{
+  return Testsome(n, reqs, out, nullptr);
+}
+
+int
+TCPTransport::Testsome(int n, Request* reqs, int* out, Status* statuses)
+{
+  if (!n) {
+    return 0;
+  }
+
+  progress();
+  int completed = 0;
+  for (int i = 0; i < n; ++i) {
+    Message* m = reqs[i];
+    if (!m || !m->done) {
+      continue;
+    }
+    if (statuses) {
+      statuses[completed] = { m->peer, int(m->bytes) };
+    }
+    out[completed++] = i;
+    delete m;
+    reqs[i] = nullptr;
+  }
+  return completed;
+}
+
+bool
+TCPTransport::cancel(Request& request, Status* out)
+{
+  Message* m = request;
+  if (!m) {
+    return true;
+  }
+
+  // Receives that haven't matched anything yet can be cancelled.
+  if (m->kind == Message::RECV && !m->done) {
+    auto& posted = posted_[m->tag];
+    auto i = std::find(posted.begin(), posted.end(), m);
+    if (i != posted.end()) {
+      posted.erase(i);
+      delete m;
+      request = nullptr;
+      return true;
+    }
+  }
+
+  // Anything else has to finish first.
+  while (!m->done) {
+    progress();
+  }
+  if (out) {
+    *out = { m->peer, int(m->bytes) };
+  }
+  delete m;
+  request = nullptr;
+  return false;
+}
+
+void
+TCPTransport::createComm(Communicator *, int, const int[])
+{
+  dbg_error("the TCP transport does not support network collectives\n");
+}
+
+void
+TCPTransport::allreduce(void *, void *, int, void *, hpx_monoid_op_t *,
+                        Communicator *)
+{
+  dbg_error("the TCP transport does not support network collectives\n");
+}
+
+void
+TCPTransport::allgather(void *, void *, int, Communicator *)
+{
+  dbg_error("the TCP transport does not support network collectives\n");
+}
+
+void
+TCPTransport::alltoall(void *, void *, int, Communicator *)
+{
+  dbg_error("the TCP transport does not support network collectives\n");
+}
+
+void
+TCPTransport::reduceScatter(void *, void *, int, hpx_monoid_op_t *,
+                            Communicator *)
+{
+  dbg_error("the TCP transport does not support network collectives\n");
+}
+
+void
+TCPTransport::scan(void *, void *, int, hpx_monoid_op_t *, bool,
+                   Communicator *)
+{
+  dbg_error("the TCP transport does not support network collectives\n");
+}
@@ -0,0 +1,135 @@
+// ==================================================================-*- C++ -*-
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifndef LIBHPX_NETWORK_ISIR_TCP_TRANSPORT_H
+#define LIBHPX_NETWORK_ISIR_TCP_TRANSPORT_H
+
+#include "hpx/hpx.h"
+#include "libhpx/config.h"
+#include "libhpx/boot/Network.h"
+#include <sys/uio.h>
+#include <deque>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace libhpx {
+namespace network {
+namespace isir {
+/// An isend/irecv transport over TCP sockets.
+///
+/// This provides the subset of MPI point-to-point semantics that the ISIR
+/// buffers depend on: tagged sends, receives that match any source by tag,
+/// probing for unexpected messages, and Testsome. Each pair of ranks is
+/// connected by a configurable number of sockets, and all of the sockets are
+/// driven by a single nonblocking epoll loop whenever the buffers test their
+/// requests. Sends queue per connection and go out with writev, so a burst of
+/// small parcels to the same peer leaves in a few system calls.
+///
+/// Like the rest of ISIR this is not thread safe; the network funnels all calls
+/// through its lock.
+class TCPTransport {
+ public:
+  typedef int Communicator;                     //!< for legacy collectives
+
+  class Message;
+  typedef Message* Request;
+
+  struct Status {
+    int source;
+    int  bytes;                                 //!< 0 if the message was cut off
+  };
+
+  TCPTransport(const config_t *cfg, const boot::Network& boot);
+  ~TCPTransport();
+
+  /// Cancel a request, or wait for it if it can't be cancelled, in which case
+  /// its status is written to @p out.
+  bool cancel(Request& request, Status* out = nullptr);
+
+  static int source(const Status& status) {
+    return status.source;
+  }
+
+  static int bytes(const Status& status) {
+    return status.bytes;
+  }
+
+  int iprobe();
+  Request isend(int to, const void *from, size_t n, int tag);
+  Request isendv(int to, const struct iovec *iov, int n, int tag);
+  Request irecv(void *to, size_t n, int tag);
+
+  int Testsome(int n, Request* reqs, int* out);
+  int Testsome(int n, Request* reqs, int* out, Status* statuses);
+
+  /// The network collectives are not supported over TCP, the parcel-based
+  /// process collectives work as usual.
+  /// @{
+  void createComm(Communicator *out, int n, const int ranks[]);
+  void allreduce(void *sendbuf, void *result, int count, void *datatype,
+                 hpx_monoid_op_t *op, Communicator *comm);
+  void allgather(void *sendbuf, void *result, int count, Communicator *comm);
+  void alltoall(void *sendbuf, void *result, int count, Communicator *comm);
+  void reduceScatter(void *sendbuf, void *result, int count,
+                     hpx_monoid_op_t *op, Communicator *comm);
+  void scan(void *sendbuf, void *result, int count, hpx_monoid_op_t *op,
+            bool exclusive, Communicator *comm);
+  /// @}
+
+  static void pin(const void*, size_t, void*) {
+  }
+
+  static void unpin(const void*, size_t) {
+  }
+
+ private:
+  struct Connection;
+
+  /// Connect all of the ranks to each other.
+  void connectAll(const boot::Network& boot);
+
+  /// Run the epoll loop once, without blocking.
+  void progress();
+
+  /// Write as many of a connection's queued sends as the socket will take.
+  void sendAll(Connection& c);
+
+  /// Read as many messages from a connection as are available.
+  void recvAll(Connection& c);
+
+  /// Find the receive for a newly arrived message, or buffer it as unexpected.
+  Message* match(int src, int tag, size_t bytes);
+
+  /// Finish reading a message.
+  void finish(Message* m);
+
+  /// Stop polling a connection, and complete anything that was queued on it or
+  /// being read from it.
+  void close(Connection& c);
+
+  const int                                          rank_;
+  const int                                         ranks_;
+  const unsigned                              connections_;  // per peer
+  int                                               epoll_;
+  std::vector<std::unique_ptr<Connection>>          conns_;
+  std::vector<unsigned>                              next_;  // per peer
+  std::unordered_map<int, std::deque<Message*>>    posted_;
+  std::list<Message*>                          unexpected_;
+};
+} // namespace isir
+} // namespace network
+} // namespace libhpx
+
+#endif // LIBHPX_NETWORK_ISIR_TCP_TRANSPORT_H
@@ -0,0 +1,38 @@
+// ==================================================================-*- C++ -*-
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifndef LIBHPX_NETWORK_ISIR_TRANSPORT_H
+#define LIBHPX_NETWORK_ISIR_TRANSPORT_H
+
+/// @file libhpx/network/isir/Transport.h
+/// @brief Selects the isend/irecv transport at configure time.
+
+#ifdef HAVE_ISIR_TCP
+# include "TCPTransport.h"
+#else
+# include "MPITransport.h"
+#endif
+
+namespace libhpx {
+namespace network {
+namespace isir {
+#ifdef HAVE_ISIR_TCP
+using Transport = TCPTransport;
+#else
+using Transport = MPITransport;
+#endif
+} // namespace isir
+} // namespace network
+} // namespace libhpx
+
+#endif // LIBHPX_NETWORK_ISIR_TRANSPORT_H
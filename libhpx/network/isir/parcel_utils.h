@@ -14,9 +14,20 @@
 #ifndef LIBHPX_NETWORK_ISIR_PARCEL_UTILS_H
 #define LIBHPX_NETWORK_ISIR_PARCEL_UTILS_H
 
+#include <hpx/builtins.h>
 #include <libhpx/debug.h>
 #include <libhpx/parcel.h>
 
+/// ISIR tags name the size of the receive buffer a parcel needs, in cache
+/// lines. Parcels of up to 2^(ISIR_SIZE_CLASSES - 1) lines are rounded up to a
+/// power-of-two size class, and the receive buffer keeps receives preposted
+/// for each class. Larger parcels are tagged with their exact line count,
+/// offset past the classes, and are found by probing.
+#define ISIR_SIZE_CLASSES 10
+
+/// The number of receives preposted for each size class.
+#define ISIR_PREPOST_DEPTH 4
+
 static inline uint32_t isir_prefix_size(void) {
   return offsetof(hpx_parcel_t, action);
 }
@@ -38,13 +49,26 @@ static inline uint32_t isir_bytes_to_payload_size(int bytes) {
   return bytes + isir_prefix_size() - sizeof(hpx_parcel_t);
 }
 
+static inline int payload_size_to_tag(uint32_t payload) {
+  uint32_t lines = ceil_div_32(payload + sizeof(hpx_parcel_t),
+                               HPX_CACHELINE_SIZE);
+  if (lines <= (1u << (ISIR_SIZE_CLASSES - 1))) {
+    return ceil_log2_32(lines);
+  }
+  return ISIR_SIZE_CLASSES + lines;
+}
+
+static inline uint32_t tag_to_lines(int tag) {
+  return (tag < ISIR_SIZE_CLASSES) ? 1u << tag : tag - ISIR_SIZE_CLASSES;
+}
+
 static inline uint32_t tag_to_payload_size(int tag) {
-  uint32_t parcel_size = tag * HPX_CACHELINE_SIZE;
+  uint32_t parcel_size = tag_to_lines(tag) * HPX_CACHELINE_SIZE;
   return parcel_size - sizeof(hpx_parcel_t);
 }
 
 static inline uint32_t tag_to_isir_bytes(int tag) {
-  uint32_t parcel_size = tag * HPX_CACHELINE_SIZE;
+  uint32_t parcel_size = tag_to_lines(tag) * HPX_CACHELINE_SIZE;
   return parcel_size - offsetof(hpx_parcel_t, action);
 }
 
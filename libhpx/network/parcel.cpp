@@ -90,22 +90,40 @@ parcel_state_t parcel_exchange_state(hpx_parcel_t *p, parcel_state_t state) {
   return __atomic_exchange_n(&p->state, state, __ATOMIC_ACQ_REL);
 }
 
-void parcel_pin(hpx_parcel_t *p) {
+void parcel_pin(hpx_parcel_t *p, uint16_t nested) {
   parcel_state_t state = parcel_get_state(p);
   dbg_assert_str(parcel_serialized(state), "cannot pin out-of-place parcels\n");
   dbg_assert_str(!parcel_nested(state), "cannot pin nested parcels\n");
   dbg_assert_str(!parcel_retained(state), "cannot pin retained parcels\n");
+  dbg_assert_str(nested, "cannot pin a parcel for no nested parcels\n");
+  __atomic_store_n(&p->offset, nested, __ATOMIC_RELAXED);
   parcel_set_state(p, state | PARCEL_PINNED);
 }
 
-void parcel_nest(hpx_parcel_t *p) {
+void parcel_nest(hpx_parcel_t *parent, hpx_parcel_t *p) {
   parcel_state_t state = parcel_get_state(p);
   dbg_assert_str(parcel_serialized(state), "cannot nest out-of-place parcels\n");
   dbg_assert_str(!parcel_pinned(state), "cannot nest pinned parcels\n");
   dbg_assert_str(!parcel_retained(state), "cannot nest retained parcels\n");
+  size_t offset = reinterpret_cast<char*>(p) - parent->buffer;
+  dbg_assert_str(offset % PARCEL_BATCH_ALIGN == 0, "misaligned nested parcel\n");
+  dbg_assert_str(offset < PARCEL_BATCH_MAX, "nested parcel offset too large\n");
+  p->offset = offset / PARCEL_BATCH_ALIGN;
   parcel_set_state(p, state | PARCEL_NESTED);
 }
 
+void parcel_batch_pack(hpx_parcel_t *p, hpx_parcel_t *batch) {
+  char *next = p->buffer;
+  while (hpx_parcel_t *q = parcel_stack_pop(&batch)) {
+    uint32_t n = parcel_size(q);
+    memcpy(next, q, n);
+    memset(next + n, 0, parcel_batch_size(q) - n);
+    next += parcel_batch_size(q);
+    parcel_delete(q);
+  }
+  dbg_assert(next == p->buffer + p->size);
+}
+
 void parcel_retain(hpx_parcel_t *p) {
   parcel_state_t state = parcel_get_state(p);
   dbg_assert_str(parcel_serialized(state), "cannot retain out-of-place parcels\n");
@@ -272,23 +290,20 @@ void parcel_delete(hpx_parcel_t *p) {
   }
 
   if (unlikely(parcel_nested(state))) {
-    size_t n = parcel_size(p);
-    auto parent = reinterpret_cast<hpx_parcel_t*>((char*)p - sizeof(*p));
-    size_t m = parent->size;
-    if (n != m) {
-      dbg_error("expected payload of %zu for parent, saw %zu\n", n, m);
+    size_t offset = p->offset * PARCEL_BATCH_ALIGN;
+    auto parent = reinterpret_cast<hpx_parcel_t*>((char*)p - offset - sizeof(*p));
+    if (!parcel_pinned(parcel_get_state(parent))) {
+      dbg_error("nested parcel %p has an unpinned parent\n", (void*)p);
     }
     parcel_delete(parent);
     return;
   }
 
+  // The last owner of a pinned parcel frees it.
   if (unlikely(parcel_pinned(state))) {
-    state &= ~PARCEL_PINNED;
-    state = parcel_exchange_state(p, state);
-  }
-
-  if (unlikely(parcel_pinned(state))) {
-    return;
+    if (__atomic_fetch_sub(&p->offset, 1, __ATOMIC_ACQ_REL)) {
+      return;
+    }
   }
 
   if (parcel_block_allocated(state)) {
@@ -15,7 +15,7 @@
 # include "config.h"
 #endif
 
-#include "FunneledNetwork.h"
+#include "libhpx/ParcelLCOOps.h"
 #include "libhpx/action.h"
 #include "libhpx/debug.h"
 #include "libhpx/parcel.h"
@@ -24,88 +24,98 @@
 
 namespace {
 using libhpx::self;
-using libhpx::network::isir::FunneledNetwork;
+using libhpx::network::ParcelLCOOps;
 }
 
 typedef struct {
   hpx_parcel_t *p;
   void *out;
+  hpx_status_t *status;
+  hpx_status_t e;
   char data[];
-} _isir_lco_get_reply_args_t;
+} _parcel_lco_get_reply_args_t;
 
+/// The reply writes the value directly into the suspended thread's output
+/// buffer, along with the status of the get, and then resumes it.
 static int
-_isir_lco_get_reply_handler(_isir_lco_get_reply_args_t *args, size_t n) {
+_parcel_lco_get_reply_handler(_parcel_lco_get_reply_args_t *args, size_t n) {
   size_t bytes = n - sizeof(*args);
-  if (bytes) {
+  if (bytes && args->e == HPX_SUCCESS) {
     memcpy(args->out, args->data, bytes);
   }
+  *args->status = args->e;
   self->spawn(args->p);
   return HPX_SUCCESS;
 }
-static LIBHPX_ACTION(HPX_INTERRUPT, HPX_MARSHALLED, _isir_lco_get_reply,
-                     _isir_lco_get_reply_handler, HPX_POINTER, HPX_SIZE_T);
+static LIBHPX_ACTION(HPX_INTERRUPT, HPX_MARSHALLED, _parcel_lco_get_reply,
+                     _parcel_lco_get_reply_handler, HPX_POINTER, HPX_SIZE_T);
 
 static int
-_isir_lco_get_request_handler(hpx_parcel_t *p, size_t n, void *out, int reset) {
+_parcel_lco_get_request_handler(hpx_parcel_t *p, size_t n, void *out, int reset,
+                              hpx_status_t *status) {
   dbg_assert(n > 0);
 
   // eagerly create a continuation parcel so that we can serialize the data into
   // it directly without an extra copy
-  size_t bytes = sizeof(_isir_lco_get_reply_args_t) + n;
+  size_t bytes = sizeof(_parcel_lco_get_reply_args_t) + n;
   hpx_parcel_t *cont = hpx_thread_generate_continuation(NULL, bytes);
 
   // forward the parcel and output buffer back to the sender
-  _isir_lco_get_reply_args_t *args = static_cast<_isir_lco_get_reply_args_t*>(hpx_parcel_get_data(cont));
+  _parcel_lco_get_reply_args_t *args = static_cast<_parcel_lco_get_reply_args_t*>(hpx_parcel_get_data(cont));
   args->p = p;
   args->out = out;
+  args->status = status;
 
   // perform the blocking get operation
-  int e = HPX_SUCCESS;
   hpx_addr_t target = hpx_thread_current_target();
   if (reset) {
-    e = hpx_lco_get_reset(target, n, args->data);
+    args->e = hpx_lco_get_reset(target, n, args->data);
   }
   else {
-    e = hpx_lco_get(target, n, args->data);
+    args->e = hpx_lco_get(target, n, args->data);
   }
 
   // send the continuation
-  parcel_launch_error(cont, e);
+  parcel_launch(cont);
 
   return HPX_SUCCESS;
 }
-static LIBHPX_ACTION(HPX_DEFAULT, 0, _isir_lco_get_request,
-                     _isir_lco_get_request_handler, HPX_POINTER, HPX_SIZE_T,
-                     HPX_POINTER, HPX_INT);
+static LIBHPX_ACTION(HPX_DEFAULT, 0, _parcel_lco_get_request,
+                     _parcel_lco_get_request_handler, HPX_POINTER, HPX_SIZE_T,
+                     HPX_POINTER, HPX_INT, HPX_POINTER);
 
 typedef struct {
   hpx_addr_t lco;
   size_t n;
   void *out;
   int reset;
-} _lco_get_env_t;
+  hpx_status_t status;
+} _parcel_lco_get_env_t;
 
 static void _lco_get_continuation(hpx_parcel_t *p, void *env) {
-  _lco_get_env_t *e = (_lco_get_env_t *)env;
+  _parcel_lco_get_env_t *e = (_parcel_lco_get_env_t *)env;
   hpx_addr_t addr = e->lco;
   size_t n = e->n;
   void *out = e->out;
   int reset = e->reset;
-  hpx_action_t act = _isir_lco_get_request;
+  hpx_status_t *status = &e->status;
+  hpx_action_t act = _parcel_lco_get_request;
   hpx_addr_t rsync = HPX_HERE;
-  hpx_action_t rop = _isir_lco_get_reply;
-  dbg_check(action_call_lsync(act, addr, rsync, rop, 4, &p, &n, &out, &reset));
+  hpx_action_t rop = _parcel_lco_get_reply;
+  dbg_check(action_call_lsync(act, addr, rsync, rop, 5, &p, &n, &out, &reset,
+                              &status));
 }
 
 int
-FunneledNetwork::get(hpx_addr_t lco, size_t n, void *out, int reset) {
-  _lco_get_env_t env = {
+ParcelLCOOps::get(hpx_addr_t lco, size_t n, void *out, int reset) {
+  _parcel_lco_get_env_t env = {
     .lco = lco,
     .n = n,
     .out = out,
-    .reset = reset
+    .reset = reset,
+    .status = HPX_SUCCESS
   };
 
   self->suspend(_lco_get_continuation, &env);
-  return HPX_SUCCESS;
+  return env.status;
 }
@@ -0,0 +1,92 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "libhpx/ParcelLCOOps.h"
+#include "libhpx/action.h"
+#include "libhpx/debug.h"
+#include "libhpx/parcel.h"
+#include "libhpx/Worker.h"
+#include <alloca.h>
+#include <cstring>
+
+namespace {
+using libhpx::self;
+using libhpx::network::ParcelLCOOps;
+}
+
+/// This action resumes a parcel that is suspended.
+///
+/// @param       parcel The parcel to resume.
+/// @param          out The location of the waiter's status.
+/// @param       status The status of the remote wait.
+///
+/// @returns            HPX_SUCCESS
+static int _parcel_lco_wait_reply_handler(void *parcel, hpx_status_t *out,
+                                        int status) {
+  *out = status;
+  parcel_launch(static_cast<hpx_parcel_t*>(parcel));
+  return HPX_SUCCESS;
+}
+static LIBHPX_ACTION(HPX_INTERRUPT, 0, _parcel_lco_wait_reply,
+                     _parcel_lco_wait_reply_handler, HPX_POINTER, HPX_POINTER,
+                     HPX_INT);
+
+/// This action can be used by a thread to wait on an LCO through suspension.
+///
+/// @param        reset Flag saying if this is just a wait, or a wait + reset.
+/// @param       parcel The address to be forwarded back to the caller.
+/// @param       status The address of the status to be forwarded back.
+///
+/// @returns            HPX_SUCCESS
+static int _parcel_lco_wait_handler(int reset, void *parcel,
+                                  hpx_status_t *status) {
+  hpx_addr_t lco = self->getCurrentParcel()->target;
+  int e = (reset) ? hpx_lco_wait_reset(lco) : hpx_lco_wait(lco);
+  return hpx_thread_continue(&parcel, &status, &e);
+}
+static LIBHPX_ACTION(HPX_DEFAULT, 0, _parcel_lco_wait, _parcel_lco_wait_handler,
+                     HPX_INT, HPX_POINTER, HPX_POINTER);
+
+/// This scheduler_suspend continuation permits a thread to wait for a remote
+/// LCO *without* allocating anything in the global address space.
+/// @{
+typedef struct {
+  hpx_addr_t lco;
+  int reset;
+  hpx_status_t status;
+} _parcel_lco_wait_env_t;
+
+static void _parcel_lco_wait_continuation(hpx_parcel_t *p, void *env) {
+  _parcel_lco_wait_env_t *e = static_cast<_parcel_lco_wait_env_t*>(env);
+  hpx_action_t op = _parcel_lco_wait;
+  hpx_action_t rop = _parcel_lco_wait_reply;
+  hpx_status_t *status = &e->status;
+  dbg_check( action_call_lsync(op, e->lco, HPX_HERE, rop, 3, &e->reset, &p,
+                               &status) );
+}
+/// @}
+
+int
+ParcelLCOOps::wait(hpx_addr_t lco, int reset) {
+  _parcel_lco_wait_env_t env = {
+    .lco = lco,
+    .reset = reset,
+    .status = HPX_SUCCESS
+  };
+  self->suspend(_parcel_lco_wait_continuation, &env);
+  return env.status;
+}
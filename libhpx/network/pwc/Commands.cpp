@@ -24,7 +24,7 @@
 
 namespace {
 using libhpx::network::pwc::Command;
-using libhpx::network::pwc::PhotonTransport;
+using libhpx::network::pwc::Transport;
 using libhpx::network::pwc::PWCNetwork;
 }
 
@@ -39,7 +39,7 @@ Command::lcoSet(unsigned src) const
 inline hpx_parcel_t*
 Command::lcoSetAtSource(unsigned src) const
 {
-  PhotonTransport::Op op;
+  Transport::Op op;
   op.rank = src;
   op.lop = Command::Nop();
   op.rop = Command(LCO_SET, arg_);
@@ -69,7 +69,7 @@ Command::resumeParcel(unsigned src) const
 inline hpx_parcel_t*
 Command::resumeParcelAtSource(unsigned src) const
 {
-  PhotonTransport::Op op;
+  Transport::Op op;
   op.rank = src;
   op.lop = Command::Nop();
   op.rop = Command(RESUME_PARCEL, arg_);
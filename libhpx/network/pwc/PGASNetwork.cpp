@@ -18,6 +18,7 @@
 #include "PWCNetwork.h"
 #include "Commands.h"
 #include "libhpx/action.h"
+#include "libhpx/debug.h"
 #include "libhpx/gpa.h"
 #include "libhpx/libhpx.h"
 #include "libhpx/locality.h"
@@ -301,6 +302,64 @@ PGASNetwork::memput(hpx_addr_t to, const void *from, size_t n)
 }
 /// @}
 
+/// The vectored memget and memput operations.
+///
+/// The pwc transports don't have vectored operations, so each piece is issued
+/// as its own get or put, but the pieces share a single completion. Every piece
+/// signals an and gate at the source, which sets the user's LCO once all of
+/// them have completed and then deletes itself. The pieces all lie within one
+/// block, so we can address them by adding their offsets to the block address.
+/// @{
+static hpx_addr_t
+_pwc_vectored_gate(int n, hpx_addr_t sync)
+{
+  hpx_addr_t gate = hpx_lco_and_new(n);
+  dbg_check( hpx_call_when_with_continuation(gate, sync, hpx_lco_set_action,
+                                             gate, hpx_lco_delete_action,
+                                             NULL, 0) );
+  return gate;
+}
+
+void
+PGASNetwork::memgetv(const struct iovec *to, hpx_addr_t from,
+                     const size_t *offsets, int n, hpx_addr_t lsync)
+{
+  dbg_assert(n > 0);
+  auto lcmd = Command::Nop();
+  auto rcmd = Command::Nop();
+
+  if (lsync) {
+    lcmd = Command::SetLCO(_pwc_vectored_gate(n, lsync));
+  }
+
+  for (int i = 0; i < n; ++i) {
+    get(to[i].iov_base, from + offsets[i], to[i].iov_len, lcmd, rcmd);
+  }
+}
+
+void
+PGASNetwork::memputv(hpx_addr_t to, const size_t *offsets,
+                     const struct iovec *from, int n, hpx_addr_t lsync,
+                     hpx_addr_t rsync)
+{
+  dbg_assert(n > 0);
+  auto lcmd = Command::Nop();
+  auto rcmd = Command::Nop();
+
+  if (lsync) {
+    lcmd = Command::SetLCO(_pwc_vectored_gate(n, lsync));
+  }
+
+  if (rsync) {
+    rcmd = Command::SetLCOAtSource(_pwc_vectored_gate(n, rsync));
+  }
+
+  for (int i = 0; i < n; ++i) {
+    put(to + offsets[i], from[i].iov_base, from[i].iov_len, lcmd, rcmd);
+  }
+}
+/// @}
+
 ///
 static int
 _pwc_memcpy_handler(const void *from, hpx_addr_t to, size_t n, hpx_addr_t sync)
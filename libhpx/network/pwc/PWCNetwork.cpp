@@ -26,10 +26,10 @@ using libhpx::MemoryOps;
 using libhpx::network::pwc::PWCNetwork;
 using libhpx::network::pwc::AGASNetwork;
 using libhpx::network::pwc::PGASNetwork;
-using libhpx::network::pwc::PhotonTransport;
-using Op = PhotonTransport::Op;
-using Key = PhotonTransport::Key;
-constexpr int ANY_SOURCE = PhotonTransport::ANY_SOURCE;
+using libhpx::network::pwc::Transport;
+using Op = Transport::Op;
+using Key = Transport::Key;
+constexpr int ANY_SOURCE = Transport::ANY_SOURCE;
 }
 
 PWCNetwork* PWCNetwork::Instance_ = nullptr;
@@ -43,7 +43,7 @@ PWCNetwork& PWCNetwork::Instance()
 PWCNetwork*
 PWCNetwork::Create(const config_t *cfg, const boot::Network& boot, GAS *gas)
 {
-  PhotonTransport::Initialize(cfg, boot.getRank(), boot.getNRanks());
+  Transport::Initialize(cfg, boot.getRank(), boot.getNRanks());
   if (gas->type() == HPX_GAS_AGAS) {
     return new libhpx::network::pwc::AGASNetwork(cfg, boot, gas);
   }
@@ -86,7 +86,7 @@ PWCNetwork::PWCNetwork(const config_t *cfg, const boot::Network& boot, GAS *gas)
   } local;
 
   local.peer.addr = peers_.get();
-  local.peer.key = PhotonTransport::FindKey(peers_.get(), ranks_*sizeof(Peer));
+  local.peer.key = Transport::FindKey(peers_.get(), ranks_*sizeof(Peer));
   local.heap.addr = static_cast<char*>(gas_.pinHeap(*this, &local.heap.key));
 
   std::unique_ptr<Exchange[]> remotes(new Exchange[ranks_]);
@@ -107,7 +107,7 @@ PWCNetwork::~PWCNetwork()
     int remaining, src;
     Command command;
     do {
-      PhotonTransport::Test(&command, &remaining, ANY_SOURCE, &src);
+      Transport::Test(&command, &remaining, ANY_SOURCE, &src);
       // @todo: what do we do with these commands, other than ignoring them?
     } while (remaining > 0);
   }
@@ -119,6 +119,10 @@ PWCNetwork::~PWCNetwork()
   // Unpin the heap segment.
   gas_.unpinHeap(*this);
   Instance_ = nullptr;
+
+#ifdef HAVE_PWC_SHM
+  Transport::Finalize();
+#endif
 }
 
 int
@@ -134,7 +138,7 @@ PWCNetwork::progress(int n)
   if (auto _ = std::unique_lock<std::mutex>(progressLock_, std::try_to_lock)) {
     Command command;
     int src;
-    while (PhotonTransport::Test(&command, nullptr, ANY_SOURCE, &src)) {
+    while (Transport::Test(&command, nullptr, ANY_SOURCE, &src)) {
       if (hpx_parcel_t* p = command(rank_)) {
         parcel_stack_push(&stack, p);
       }
@@ -155,7 +159,7 @@ PWCNetwork::probe(int n)
   if (auto _ = std::unique_lock<std::mutex>(probeLock_, std::try_to_lock)) {
     Command command;
     int src;
-    while (PhotonTransport::Probe(&command, nullptr, ANY_SOURCE, &src)) {
+    while (Transport::Probe(&command, nullptr, ANY_SOURCE, &src)) {
       if (hpx_parcel_t* p = command(src)) {
         parcel_stack_push(&stack, p);
       }
@@ -199,13 +203,13 @@ PWCNetwork::progressSends(unsigned rank)
 void
 PWCNetwork::pin(const void *base, size_t bytes, void *key)
 {
-  PhotonTransport::Pin(base, bytes, static_cast<Key*>(key));
+  Transport::Pin(base, bytes, static_cast<Key*>(key));
 }
 
 void
 PWCNetwork::unpin(const void *base, size_t bytes)
 {
-  PhotonTransport::Unpin(base, bytes);
+  Transport::Unpin(base, bytes);
 }
 
 int
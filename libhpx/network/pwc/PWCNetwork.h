@@ -17,13 +17,21 @@
 #include "libhpx/Network.h"
 #include "Commands.h"
 #include "Peer.h"
-#include "PhotonTransport.h"
+#include "Transport.h"
 #include "libhpx/GAS.h"
 #include "libhpx/parcel.h"
 #include "libhpx/ParcelStringOps.h"
 #include "libhpx/util/Aligned.h"
 #include <mutex>
 
+/// Resume a parcel that was suspended waiting on a remote LCO, after storing
+/// an error status for it.
+///
+/// Successful remote LCO operations resume the waiting parcel with a single
+/// ResumeParcel command, but commands can't carry a status so failures are
+/// reported with this parcel instead.
+extern HPX_ACTION_DECL(pwc_lco_resume_error);
+
 namespace libhpx {
 namespace network {
 namespace pwc {
@@ -106,6 +114,8 @@ class PGASNetwork final : public PWCNetwork, public util::Aligned<HPX_CACHELINE_
   void memput(hpx_addr_t dest, const void *src, size_t n, hpx_addr_t lsync, hpx_addr_t rsync);
   void memput(hpx_addr_t dest, const void *src, size_t n, hpx_addr_t rsync);
   void memput(hpx_addr_t dest, const void *src, size_t n);
+  void memgetv(const struct iovec *dest, hpx_addr_t src, const size_t *offsets, int n, hpx_addr_t lsync);
+  void memputv(hpx_addr_t dest, const size_t *offsets, const struct iovec *src, int n, hpx_addr_t lsync, hpx_addr_t rsync);
   void memcpy(hpx_addr_t dest, hpx_addr_t src, size_t n, hpx_addr_t sync);
   void memcpy(hpx_addr_t dest, hpx_addr_t src, size_t n);
 };
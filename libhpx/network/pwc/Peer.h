@@ -16,7 +16,7 @@
 
 #include "CircularBuffer.h"
 #include "ParcelBlock.h"
-#include "PhotonTransport.h"
+#include "Transport.h"
 #include "libhpx/config.h"
 #include "libhpx/padding.h"
 #include "libhpx/parcel.h"
@@ -36,7 +36,7 @@ namespace pwc {
 template <typename T>
 struct Remote {
   T                  *addr;
-  PhotonTransport::Key key;
+  Transport::Key key;
 };
 
 class Peer {
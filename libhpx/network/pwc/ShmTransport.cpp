@@ -0,0 +1,348 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "ShmTransport.h"
+#include "registered.h"
+#include "libhpx/debug.h"
+#include "libhpx/libhpx.h"
+#include "libhpx/locality.h"
+#include "libhpx/SharedMemory.h"
+#include "libhpx/boot/Network.h"
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include <sched.h>
+#include <sys/prctl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace {
+using libhpx::network::SharedRing;
+using libhpx::network::SharedSegment;
+using libhpx::network::pwc::ShmTransport;
+using libhpx::network::pwc::Command;
+using Op = libhpx::network::pwc::ShmTransport::Op;
+using Key = libhpx::network::pwc::ShmTransport::Key;
+
+/// The bytes in each remote completion ring, must be a power of two.
+constexpr size_t LEDGER_BYTES = size_t(1) << 16;
+
+/// The size of a completion in the ring.
+constexpr size_t ENTRY_BYTES = sizeof(uint64_t);
+
+/// The transport state.
+///
+/// Each process has one ring from every rank (including itself) for remote
+/// completions. The rings are single-producer, so the sends to each rank are
+/// serialized by a local lock. When a ring fills we move our own incoming
+/// completions into the backlog while we wait, so that two ranks sending to
+/// each other can't deadlock.
+struct State {
+  State(const libhpx::boot::Network& boot, int rank, int ranks)
+      : rank(rank),
+        ranks(ranks),
+        segment(boot, ranks * ranks * SharedRing::Bytes(LEDGER_BYTES), "pwc"),
+        pids(ranks),
+        sendLocks(new std::mutex[ranks]),
+        recvLock(),
+        backlog(),
+        next(0),
+        localLock(),
+        local(),
+        keysLock(),
+        keys()
+  {
+    pid_t pid = getpid();
+    boot.allgather(&pid, &pids[0], sizeof(pid));
+  }
+
+  SharedRing& ringAt(int from, int to) {
+    size_t i = size_t(from) * ranks + to;
+    char *ring = segment.base() + i * SharedRing::Bytes(LEDGER_BYTES);
+    return *reinterpret_cast<SharedRing*>(ring);
+  }
+
+  /// Move all of the pending remote completions into the backlog, if no one
+  /// else is receiving.
+  void drain() {
+    if (auto _ = std::unique_lock<std::mutex>(recvLock, std::try_to_lock)) {
+      for (int src = 0; src < ranks; ++src) {
+        uint64_t command;
+        while (ringAt(src, rank).get(&command, ENTRY_BYTES, LEDGER_BYTES)) {
+          backlog.emplace_back(command, src);
+        }
+      }
+    }
+  }
+
+  const int                               rank;
+  const int                              ranks;
+  SharedSegment                        segment;
+  std::vector<pid_t>                      pids;
+  std::unique_ptr<std::mutex[]>      sendLocks;
+  std::mutex                          recvLock;
+  std::deque<std::pair<uint64_t, int>> backlog;
+  int                                     next;  // the next ring to probe
+  std::mutex                         localLock;
+  std::deque<Command>                    local;
+  std::mutex                          keysLock;
+  std::map<uintptr_t, Key>                keys;
+};
+
+State* _state = nullptr;
+
+/// Copy @p n bytes between this process and the process at @p rank.
+void
+_copy(int rank, void *dest, const void *src, size_t n, bool write)
+{
+  if (rank == _state->rank) {
+    std::memcpy(dest, src, n);
+    return;
+  }
+
+  struct iovec local = { const_cast<void*>(write ? src : dest), n };
+  struct iovec remote = { const_cast<void*>(write ? dest : src), n };
+  pid_t pid = _state->pids[rank];
+  while (local.iov_len) {
+    ssize_t e = (write) ? process_vm_writev(pid, &local, 1, &remote, 1, 0) :
+                          process_vm_readv(pid, &local, 1, &remote, 1, 0);
+    if (e < 0 && errno == EPERM) {
+      dbg_error("rank %d does not allow cross-memory access, check "
+                "/proc/sys/kernel/yama/ptrace_scope or run with "
+                "--hpx-pwc-ptraceany\n", rank);
+    }
+    if (e < 0) {
+      dbg_error("cross-memory %s of %zu bytes with rank %d failed (%s)\n",
+                (write) ? "put" : "get", n, rank, strerror(errno));
+    }
+
+    // The kernel may stop at a page boundary, so continue where it left off.
+    local.iov_base = static_cast<char*>(local.iov_base) + e;
+    local.iov_len -= e;
+    remote.iov_base = static_cast<char*>(remote.iov_base) + e;
+    remote.iov_len -= e;
+  }
+}
+}
+
+void
+ShmTransport::Initialize(const config_t *cfg, int rank, int ranks)
+{
+  if (_state) {
+    return;
+  }
+
+  _state = new State(*here->boot, rank, ranks);
+
+  // Processes can only attach to each other's memory if they're allowed to
+  // ptrace each other, which Yama restricts to descendants by default. Yama
+  // only records one tracer per process, so we can name our peer when there
+  // are two ranks, but beyond that the only exception is to allow any process
+  // on the host, which the user has to ask for with --hpx-pwc-ptraceany.
+  if (cfg->pwc_ptraceany) {
+    prctl(PR_SET_PTRACER, PR_SET_PTRACER_ANY, 0, 0, 0);
+  }
+  else if (ranks == 2) {
+    prctl(PR_SET_PTRACER, _state->pids[1 - rank], 0, 0, 0);
+  }
+  here->boot->barrier();
+  registered_allocator_init();
+}
+
+void
+ShmTransport::Finalize()
+{
+  delete _state;
+  _state = nullptr;
+}
+
+const Key *
+ShmTransport::FindKeyRef(const void *addr, size_t n)
+{
+  uintptr_t begin = reinterpret_cast<uintptr_t>(addr);
+  std::lock_guard<std::mutex> _(_state->keysLock);
+  auto i = _state->keys.upper_bound(begin);
+  if (i != _state->keys.begin()) {
+    const Key& key = (--i)->second;
+    if (begin + n <= key.base + key.bytes) {
+      return &key;
+    }
+  }
+  log_net("no registration for range (%p, %zu)\n", addr, n);
+  return nullptr;
+}
+
+void
+ShmTransport::FindKey(const void *addr, size_t n, Key *key)
+{
+  if (const Key *found = ShmTransport::FindKeyRef(addr, n)) {
+    *key = *found;
+  }
+  else {
+    dbg_error("failed to find registration for (%p, %zu)\n", addr, n);
+  }
+}
+
+Key
+ShmTransport::FindKey(const void *addr, size_t n)
+{
+  Key key;
+  FindKey(addr, n, &key);
+  return key;
+}
+
+void
+ShmTransport::Pin(const void *base, size_t n, Key *key)
+{
+  uintptr_t begin = reinterpret_cast<uintptr_t>(base);
+  {
+    std::lock_guard<std::mutex> _(_state->keysLock);
+    _state->keys[begin] = { begin, n };
+  }
+
+  static constexpr auto LEVEL= HPX_LOG_NET | HPX_LOG_MEMORY;
+  log_level(LEVEL, "pinned segment (%p, %zu)\n", base, n);
+
+  if (key) {
+    *key = { begin, n };
+  }
+}
+
+void
+ShmTransport::Unpin(const void *base, size_t n)
+{
+  // The registered allocator may return chunks after we've been finalized, and
+  // there's nothing left to track by then.
+  if (!_state) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> _(_state->keysLock);
+  if (!_state->keys.erase(reinterpret_cast<uintptr_t>(base))) {
+    dbg_error("unpinning segment (%p, %zu) that was never pinned\n", base, n);
+  }
+
+  static constexpr auto LEVEL= HPX_LOG_NET | HPX_LOG_MEMORY;
+  log_level(LEVEL, "unpinned the segment (%p, %zu)\n", base, n);
+}
+
+void
+ShmTransport::Complete(const Command& lop, const Command& rop, unsigned rank)
+{
+  if (lop) {
+    std::lock_guard<std::mutex> _(_state->localLock);
+    _state->local.push_back(lop);
+  }
+
+  if (rop) {
+    uint64_t command = Command::Pack(rop);
+    SharedRing& ring = _state->ringAt(_state->rank, rank);
+    std::lock_guard<std::mutex> _(_state->sendLocks[rank]);
+    while (!ring.put(&command, ENTRY_BYTES, LEDGER_BYTES)) {
+      _state->drain();
+      sched_yield();
+    }
+  }
+}
+
+int
+ShmTransport::Op::cmd()
+{
+  Complete(lop, rop, rank);
+  return LIBHPX_OK;
+}
+
+int
+ShmTransport::Op::put()
+{
+  // We don't need a key for the local buffer, since the kernel does the copy.
+  dbg_assert(dest_key);
+  _copy(rank, dest, src, n, true);
+  Complete(lop, rop, rank);
+  return LIBHPX_OK;
+}
+
+int
+ShmTransport::Op::get()
+{
+  dbg_assert(src_key);
+  _copy(rank, dest, src, n, false);
+  Complete(lop, rop, rank);
+  return LIBHPX_OK;
+}
+
+int
+ShmTransport::Test(Command *op, int *remaining, int id, int *src)
+{
+  std::lock_guard<std::mutex> _(_state->localLock);
+  int flag = !_state->local.empty();
+  if (flag) {
+    *op = _state->local.front();
+    _state->local.pop_front();
+    *src = _state->rank;
+  }
+  if (remaining) {
+    *remaining = _state->local.size();
+  }
+  return flag;
+}
+
+int
+ShmTransport::Probe(Command *op, int *remaining, int rank, int *src)
+{
+  std::lock_guard<std::mutex> _(_state->recvLock);
+  auto& backlog = _state->backlog;
+  for (auto i = backlog.begin(), e = backlog.end(); i != e; ++i) {
+    if (rank == ANY_SOURCE || rank == i->second) {
+      *op = Command::Unpack(i->first);
+      *src = i->second;
+      backlog.erase(i);
+      if (remaining) {
+        *remaining = backlog.size();
+      }
+      return 1;
+    }
+  }
+
+  // Round-robin through the rings so that one busy sender can't starve the
+  // others.
+  int ranks = _state->ranks;
+  for (int i = 0; i < ranks; ++i) {
+    int from = (rank == ANY_SOURCE) ? (_state->next + i) % ranks : rank;
+    uint64_t command;
+    if (_state->ringAt(from, _state->rank).get(&command, ENTRY_BYTES,
+                                               LEDGER_BYTES)) {
+      _state->next = (from + 1) % ranks;
+      *op = Command::Unpack(command);
+      *src = from;
+      if (remaining) {
+        *remaining = backlog.size();
+      }
+      return 1;
+    }
+  }
+
+  if (remaining) {
+    *remaining = 0;
+  }
+  return 0;
+}
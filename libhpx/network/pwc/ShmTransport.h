@@ -0,0 +1,86 @@
+// ==================================================================-*- C++ -*-
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifndef LIBHPX_NETWORK_PWC_SHM_TRANSPORT_H
+#define LIBHPX_NETWORK_PWC_SHM_TRANSPORT_H
+
+#include "Commands.h"
+#include "libhpx/config.h"
+
+namespace libhpx {
+namespace network {
+namespace pwc {
+
+/// A put/get-with-completion transport for processes on a single host.
+///
+/// This implements the Transport interface without RDMA hardware. Data
+/// moves directly between the processes' address spaces with cross-memory
+/// attach (process_vm_writev/readv), and remote completions are delivered
+/// through per-pair rings in a shared memory segment. Local completions are
+/// queued in-process, since every operation completes before it returns.
+class ShmTransport {
+ public:
+  static constexpr int ANY_SOURCE = -1;
+
+  /// The registered region that covers a buffer.
+  ///
+  /// Registration isn't needed for cross-memory attach, but we track it anyway
+  /// so that the network sees the same registration behavior as with RDMA.
+  struct Key {
+    uintptr_t  base;
+    size_t    bytes;
+  };
+
+  struct alignas(HPX_CACHELINE_SIZE) Op {
+    unsigned                     rank;
+    const unsigned            PADDING;
+    Command                       lop;
+    Command                       rop;
+    size_t                          n;
+    void*                        dest;
+    const ShmTransport::Key* dest_key;
+    const void*                   src;
+    const ShmTransport::Key*  src_key;
+
+    Op() : rank(), PADDING(), lop(), rop(), n(), dest(nullptr),
+           dest_key(nullptr), src(nullptr), src_key(nullptr) {
+    }
+
+    int cmd();
+    int put();
+    int get();
+  };
+
+  static void Initialize(const config_t *config, int rank, int ranks);
+  static void Finalize();
+
+  static int Test(Command *op, int *remaining, int id, int *src);
+  static int Probe(Command *op, int *remaining, int rank, int *src);
+
+  static void Pin(const void *base, size_t bytes, Key *key);
+  static void Unpin(const void *base, size_t bytes);
+
+  static const Key* FindKeyRef(const void *addr, size_t n);
+  static void FindKey(const void *addr, size_t n, Key *key);
+  static Key FindKey(const void *addr, size_t n);
+
+ private:
+  /// Deliver the local and remote completions for a finished operation.
+  static void Complete(const Command& lop, const Command& rop, unsigned rank);
+};
+
+} // namespace pwc
+} // namespace network
+} // namespace libhpx
+
+#endif // LIBHPX_NETWORK_PWC_SHM_TRANSPORT_H
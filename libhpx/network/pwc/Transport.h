@@ -0,0 +1,38 @@
+// ==================================================================-*- C++ -*-
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifndef LIBHPX_NETWORK_PWC_TRANSPORT_H
+#define LIBHPX_NETWORK_PWC_TRANSPORT_H
+
+/// @file libhpx/network/pwc/Transport.h
+/// @brief Selects the put/get-with-completion transport at configure time.
+
+#ifdef HAVE_PWC_SHM
+# include "ShmTransport.h"
+#else
+# include "PhotonTransport.h"
+#endif
+
+namespace libhpx {
+namespace network {
+namespace pwc {
+#ifdef HAVE_PWC_SHM
+using Transport = ShmTransport;
+#else
+using Transport = PhotonTransport;
+#endif
+} // namespace pwc
+} // namespace network
+} // namespace libhpx
+
+#endif // LIBHPX_NETWORK_PWC_TRANSPORT_H
@@ -24,10 +24,10 @@
 namespace {
 using libhpx::self;
 using libhpx::network::pwc::Command;
-using libhpx::network::pwc::PhotonTransport;
+using libhpx::network::pwc::Transport;
 using libhpx::network::pwc::PWCNetwork;
-using Op = libhpx::network::pwc::PhotonTransport::Op;
-using Key = libhpx::network::pwc::PhotonTransport::Key;
+using Op = libhpx::network::pwc::Transport::Op;
+using Key = libhpx::network::pwc::Transport::Key;
 }
 
 /// This acts as a parcel_suspend transfer to allow _pwc_lco_get_request_handler
@@ -48,9 +48,18 @@ struct _pwc_lco_get_request_args_t {
   int reset;
   Key key;
   unsigned rank;
+  hpx_status_t *status;
 };
 }
 
+/// Report a failed get to the waiting parcel, instead of writing the value.
+static int
+_get_reply_error(_pwc_lco_get_request_args_t *args, int e)
+{
+  return hpx_call(HPX_THERE(args->rank), pwc_lco_resume_error, HPX_NULL,
+                  &args->p, &args->status, &e);
+}
+
 /// This function (*not* an action) consolidates the functionality to issue a
 /// synchronous get reply via put-with-completion using the scheduler_suspend
 /// interface.
@@ -68,7 +77,7 @@ _get_reply(_pwc_lco_get_request_args_t *args, const void *ref, Command remote)
   op.dest = args->out;
   op.dest_key = &args->key;
   op.src = ref;
-  op.src_key = PhotonTransport::FindKeyRef(ref, args->n);
+  op.src_key = Transport::FindKeyRef(ref, args->n);
   op.lop = Command();                          // set in _get_reply_continuation
   op.rop = remote;
   dbg_assert_str(op.src_key, "LCO reference must point to registered memory\n");
@@ -95,7 +104,7 @@ _get_reply_stack(_pwc_lco_get_request_args_t *args, hpx_addr_t lco)
   }
 
   if (e != HPX_SUCCESS) {
-    dbg_error("Cannot yet return an error from a remote get operation\n");
+    return _get_reply_error(args, e);
   }
 
   return _get_reply(args, ref, Command::ResumeParcel(args->p));
@@ -118,10 +127,11 @@ _get_reply_malloc(_pwc_lco_get_request_args_t *args, hpx_addr_t lco)
   }
 
   if (e != HPX_SUCCESS) {
-    dbg_error("Cannot yet return an error from a remote get operation\n");
+    e = _get_reply_error(args, e);
+  }
+  else {
+    e = _get_reply(args, ref, Command::ResumeParcel(args->p));
   }
-
-  e = _get_reply(args, ref, Command::ResumeParcel(args->p));
   registered_free(ref);
   return e;
 }
@@ -136,7 +146,7 @@ _get_reply_getref(_pwc_lco_get_request_args_t *args, hpx_addr_t lco)
   int e = hpx_lco_getref(lco, args->n, &ref);
 
   if (e != HPX_SUCCESS) {
-    dbg_error("Cannot yet return an error from a remote get operation\n");
+    return _get_reply_error(args, e);
   }
 
   // Send back the LCO data. This doesn't resume the remote thread because there
@@ -149,7 +159,7 @@ _get_reply_getref(_pwc_lco_get_request_args_t *args, hpx_addr_t lco)
   hpx_lco_release(lco, ref);
 
   // Wake the remote getter up.
-  PhotonTransport::Op op;
+  Transport::Op op;
   op.rank = args->rank;
   op.lop = Command::Nop();
   op.rop = Command::ResumeParcel(args->p);
@@ -223,22 +233,24 @@ _pwc_lco_get_continuation(struct hpx_parcel *p, void *env)
 int
 PWCNetwork::get(hpx_addr_t lco, size_t n, void *out, int reset)
 {
+  hpx_status_t status = HPX_SUCCESS;
   _pwc_lco_get_continuation_env_t env;
   env.request.p = nullptr;                   // set in _pwc_lco_get_continuation
   env.request.n = n;
   env.request.out = out;
   env.request.reset = reset;
   env.request.rank = here->rank;
+  env.request.status = &status;
   env.lco = lco;
 
   // If the output buffer is already registered, then we just need to copy the
   // key into the args structure, otherwise we need to register the region.
-  auto *key = PhotonTransport::FindKeyRef(out, n);
+  auto *key = Transport::FindKeyRef(out, n);
   if (key) {
     env.request.key = *key;
   }
   else {
-    PhotonTransport::Pin(out, n, &env.request.key);
+    Transport::Pin(out, n, &env.request.key);
   }
 
   // Perform the get operation synchronously.
@@ -247,7 +259,7 @@ PWCNetwork::get(hpx_addr_t lco, size_t n, void *out, int reset)
   // If we registered the output buffer dynamically, then we need to de-register
   // it now.
   if (!key) {
-    PhotonTransport::Unpin(out, n);
+    Transport::Unpin(out, n);
   }
-  return HPX_SUCCESS;
+  return status;
 }
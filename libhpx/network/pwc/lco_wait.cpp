@@ -17,6 +17,7 @@
 
 #include "PWCNetwork.h"
 #include "Commands.h"
+#include "libhpx/action.h"
 #include "libhpx/debug.h"
 #include "libhpx/memory.h"
 #include "libhpx/Worker.h"
@@ -24,38 +25,51 @@
 namespace {
 using libhpx::self;
 using libhpx::network::pwc::Command;
-using libhpx::network::pwc::PhotonTransport;
+using libhpx::network::pwc::Transport;
 using libhpx::network::pwc::PWCNetwork;
 }
 
+static int
+_pwc_lco_resume_error_handler(struct hpx_parcel *p, hpx_status_t *out,
+                              int status)
+{
+  *out = status;
+  parcel_launch(p);
+  return HPX_SUCCESS;
+}
+LIBHPX_ACTION(HPX_INTERRUPT, 0, pwc_lco_resume_error,
+              _pwc_lco_resume_error_handler, HPX_POINTER, HPX_POINTER, HPX_INT);
+
 /// Wait for an LCO to be set, and then resume a remote parcel.
 ///
 /// NB: We could do this through the normal parcel continuation infrastructure
 ///     without sending the parcel pointer as an argument.
 static int
-_pwc_lco_wait_handler(struct hpx_parcel *p, int reset)
+_pwc_lco_wait_handler(struct hpx_parcel *p, int reset, hpx_status_t *status)
 {
   const hpx_parcel_t *curr = self->getCurrentParcel();
   hpx_addr_t lco = curr->target;
   int e = (reset) ? hpx_lco_wait_reset(lco) : hpx_lco_wait(lco);
 
   if (e != HPX_SUCCESS) {
-    dbg_error("Cannot yet return an error from a remote wait operation\n");
+    return hpx_call(HPX_THERE(curr->src), pwc_lco_resume_error, HPX_NULL, &p,
+                    &status, &e);
   }
 
-  PhotonTransport::Op op;
+  Transport::Op op;
   op.rank = curr->src;
   op.lop = Command::Nop();
   op.rop = Command::ResumeParcel(p);
   return op.cmd();
 }
 static LIBHPX_ACTION(HPX_DEFAULT, 0, _pwc_lco_wait, _pwc_lco_wait_handler,
-                     HPX_POINTER, HPX_INT);
+                     HPX_POINTER, HPX_INT, HPX_POINTER);
 
 namespace {
 struct _pwc_lco_wait_env_t {
   hpx_addr_t lco;
   int reset;
+  hpx_status_t status;
 };
 }
 
@@ -64,8 +78,9 @@ _pwc_lco_wait_continuation(hpx_parcel_t *p, void *env)
 {
   auto e = static_cast<_pwc_lco_wait_env_t*>(env);
   uint64_t arg = (uint64_t)(uintptr_t)p;
+  hpx_status_t *status = &e->status;
   hpx_action_t act = _pwc_lco_wait;
-  dbg_check(action_call_lsync(act, e->lco, 0, 0, 2, &arg, &e->reset));
+  dbg_check(action_call_lsync(act, e->lco, 0, 0, 3, &arg, &e->reset, &status));
 }
 
 int
@@ -73,9 +88,9 @@ PWCNetwork::wait(hpx_addr_t lco, int reset)
 {
   _pwc_lco_wait_env_t env = {
     .lco = lco,
-    .reset = reset
+    .reset = reset,
+    .status = HPX_SUCCESS
   };
   self->suspend(_pwc_lco_wait_continuation, &env);
-  // NB: we could return self->current->error
-  return HPX_SUCCESS;
+  return env.status;
 }
@@ -30,10 +30,10 @@
 
 namespace {
 using libhpx::network::pwc::Command;
-using libhpx::network::pwc::PhotonTransport;
+using libhpx::network::pwc::Transport;
 using libhpx::network::pwc::PWCNetwork;
-using Op = libhpx::network::pwc::PhotonTransport::Op;
-using Key = libhpx::network::pwc::PhotonTransport::Key;
+using Op = libhpx::network::pwc::Transport::Op;
+using Key = libhpx::network::pwc::Transport::Key;
 }
 
 namespace {
@@ -63,7 +63,7 @@ _rendezvous_get_handler(_rendezvous_get_args_t *args, size_t size)
   op.rank = args->rank;
   op.n = args->n;
   op.dest = p;
-  op.dest_key = PhotonTransport::FindKeyRef(p, args->n);
+  op.dest_key = Transport::FindKeyRef(p, args->n);
   op.src = args->p;
   op.src_key = &args->key;
   op.lop = Command::RendezvousLaunch(p);
@@ -83,7 +83,7 @@ PWCNetwork::rendezvousSend(const hpx_parcel_t *p)
     .rank = here->rank,
     .p = p,
     .n = n,
-    .key = PhotonTransport::FindKey(p, n)
+    .key = Transport::FindKey(p, n)
   };
   return hpx_call(p->target, _rendezvous_get, HPX_NULL, &args, sizeof(args));
 }
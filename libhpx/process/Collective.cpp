@@ -0,0 +1,415 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "Collective.h"
+#include "libhpx/action.h"
+#include "libhpx/config.h"
+#include "libhpx/debug.h"
+#include "libhpx/locality.h"
+#include "libhpx/parcel.h"
+#include "libhpx/Network.h"
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+using libhpx::process::Collective;
+
+/// The number of bits in a message tag that we reserve for the step.
+constexpr unsigned STEP_BITS = 24;
+
+/// The step offset for the second phase of a two-phase algorithm.
+constexpr unsigned PHASE_STEPS = 32;
+}
+
+HPX_ACTION_DECL(Collective::Init);
+HPX_ACTION_DECL(Collective::Fini);
+HPX_ACTION_DECL(Collective::Deliver);
+
+void
+Collective::InitializeActions()
+{
+  LIBHPX_REGISTER_ACTION(HPX_DEFAULT, HPX_PINNED, Collective::Init,
+                         Collective::InitHandler, HPX_POINTER, HPX_ADDR);
+  LIBHPX_REGISTER_ACTION(HPX_DEFAULT, HPX_PINNED, Collective::Fini,
+                         Collective::FiniHandler, HPX_POINTER);
+  LIBHPX_REGISTER_ACTION(HPX_INTERRUPT, HPX_PINNED | HPX_MARSHALLED,
+                         Collective::Deliver, Collective::DeliverHandler,
+                         HPX_POINTER, HPX_POINTER, HPX_SIZE_T);
+}
+
+Collective::Collective(hpx_addr_t base)
+    : base_(base),
+      epoch_(0),
+      lock_(),
+      slots_(),
+      posted_(),
+      ctx_(nullptr)
+{
+  if (!here->config->coll_network) {
+    return;
+  }
+
+  // the network collectives always span the whole process
+  int n = here->ranks;
+  size_t group_bytes = sizeof(int32_t) * n;
+  void *ctx = calloc(1, sizeof(coll_t) + group_bytes);
+  ctx_ = static_cast<coll_t*>(ctx);
+  ctx_->group_sz = n;
+  ctx_->group_bytes = group_bytes;
+  ctx_->comm_bytes = 0;
+  int32_t *ranks = reinterpret_cast<int32_t*>(ctx_->data);
+  for (int i = 0; i < n; ++i) {
+    ranks[i] = i;
+  }
+  dbg_check( here->net->init(&ctx) );
+  ctx_ = static_cast<coll_t*>(ctx);
+}
+
+Collective::~Collective()
+{
+  for (auto&& slot : slots_) {
+    hpx_lco_delete_sync(slot.second);
+  }
+  free(ctx_);
+}
+
+int
+Collective::InitHandler(void *buffer, hpx_addr_t base)
+{
+  new(buffer) Collective(base);
+  return HPX_SUCCESS;
+}
+
+int
+Collective::DeliverHandler(Collective *c, void *args, size_t bytes)
+{
+  uint64_t tag;
+  memcpy(&tag, args, sizeof(tag));
+  bytes -= sizeof(tag);
+  const char *data = static_cast<const char*>(args) + sizeof(tag);
+
+  // if the receiver posted a destination we can copy directly into it,
+  // otherwise buffer the message in its slot
+  Posted posted = {nullptr, HPX_NULL};
+  hpx_addr_t f = HPX_NULL;
+  {
+    std::lock_guard<std::mutex> _(c->lock_);
+    auto i = c->posted_.find(tag);
+    if (i != c->posted_.end()) {
+      posted = i->second;
+      c->posted_.erase(i);
+    }
+    else {
+      f = c->slotLocked(tag, bytes);
+    }
+  }
+
+  if (posted.dest) {
+    memcpy(posted.dest, data, bytes);
+    hpx_lco_set(posted.done, 0, NULL, HPX_NULL, HPX_NULL);
+  }
+  else {
+    hpx_lco_set(f, bytes, data, HPX_NULL, HPX_NULL);
+  }
+  return HPX_SUCCESS;
+}
+
+bool
+Collective::sync(coll_type_t type, size_t bytes, const void *in, void *out,
+                 hpx_monoid_op_t op)
+{
+  if (!ctx_) {
+    return false;
+  }
+
+  ctx_->type = type;
+  ctx_->op = op;
+  ctx_->recv_count = bytes;
+  dbg_check( here->net->sync(const_cast<void*>(in), bytes, out, ctx_) );
+  return true;
+}
+
+uint64_t
+Collective::begin()
+{
+  dbg_assert(here->ranks < (1u << STEP_BITS));
+  return epoch_++ << STEP_BITS;
+}
+
+hpx_addr_t
+Collective::slot(uint64_t tag, size_t bytes)
+{
+  std::lock_guard<std::mutex> _(lock_);
+  return slotLocked(tag, bytes);
+}
+
+hpx_addr_t
+Collective::slotLocked(uint64_t tag, size_t bytes)
+{
+  auto i = slots_.find(tag);
+  if (i != slots_.end()) {
+    return i->second;
+  }
+  hpx_addr_t f = hpx_lco_future_new(bytes);
+  slots_.emplace(tag, f);
+  return f;
+}
+
+void
+Collective::send(unsigned rank, uint64_t tag, size_t bytes, const void *data)
+{
+  hpx_parcel_t *p = hpx_parcel_acquire(NULL, sizeof(tag) + bytes);
+  p->target = hpx_addr_add(base_, rank * sizeof(*this), sizeof(*this));
+  p->action = Deliver;
+  char *buffer = static_cast<char*>(hpx_parcel_get_data(p));
+  memcpy(buffer, &tag, sizeof(tag));
+  memcpy(buffer + sizeof(tag), data, bytes);
+  parcel_launch(p);
+}
+
+void
+Collective::recv(uint64_t tag, size_t bytes, void *data)
+{
+  hpx_addr_t f = slot(tag, bytes);
+  dbg_check( hpx_lco_get(f, bytes, data) );
+  {
+    std::lock_guard<std::mutex> _(lock_);
+    slots_.erase(tag);
+  }
+  hpx_lco_delete_sync(f);
+}
+
+void
+Collective::post(uint64_t tag, size_t bytes, void *dest, hpx_addr_t done)
+{
+  hpx_addr_t f = HPX_NULL;
+  {
+    std::lock_guard<std::mutex> _(lock_);
+    auto i = slots_.find(tag);
+    if (i == slots_.end()) {
+      posted_.emplace(tag, Posted{dest, done});
+      return;
+    }
+    f = i->second;
+    slots_.erase(i);
+  }
+
+  // the message arrived before we posted, so it is already buffered
+  dbg_check( hpx_lco_get(f, bytes, dest) );
+  hpx_lco_delete_sync(f);
+  hpx_lco_set(done, 0, NULL, HPX_NULL, HPX_NULL);
+}
+
+/// A ring allgather.
+///
+/// Each step forwards the block that we received in the previous step to our
+/// right neighbor, so every link carries exactly one block per step and the
+/// whole operation moves (P - 1) blocks per locality.
+void
+Collective::allgather(size_t bytes, const void *in, void *out)
+{
+  if (!sync(ALL_GATHER, bytes, in, out, nullptr)) {
+    allgather(begin(), bytes, in, out);
+  }
+}
+
+void
+Collective::allgather(uint64_t tag, size_t bytes, const void *in, void *out)
+{
+  unsigned n = here->ranks;
+  unsigned r = here->rank;
+  unsigned right = (r + 1) % n;
+  char *blocks = static_cast<char*>(out);
+  memmove(blocks + r * bytes, in, bytes);
+
+  for (unsigned s = 0; s + 1 < n; ++s) {
+    unsigned i = (r + n - s) % n;
+    unsigned j = (r + n - s - 1) % n;
+    send(right, tag + s, bytes, blocks + i * bytes);
+    recv(tag + s, bytes, blocks + j * bytes);
+  }
+}
+
+void
+Collective::allreduce(size_t bytes, const void *in, void *out,
+                      hpx_monoid_op_t op)
+{
+  if (!sync(ALL_REDUCE, bytes, in, out, op)) {
+    allreduce(begin(), bytes, in, out, op);
+  }
+}
+
+/// A binomial-tree allreduce.
+///
+/// The values are reduced up a binomial tree rooted at rank 0, and the result
+/// is broadcast back down the same tree, so the operation completes in
+/// 2 * ceil(log2 P) steps for any number of localities. A locality receives at
+/// most one message per step, so the step alone identifies each message.
+void
+Collective::allreduce(uint64_t tag, size_t bytes, const void *in, void *out,
+                      hpx_monoid_op_t op)
+{
+  unsigned n = here->ranks;
+  unsigned r = here->rank;
+  char *tmp = static_cast<char*>(malloc(bytes));
+  memmove(out, in, bytes);
+
+  // reduce phase, we send our partial to our parent at our lowest set bit
+  unsigned mask = 1;
+  unsigned s = 0;
+  for (; mask < n; mask <<= 1, ++s) {
+    if (r & mask) {
+      send(r - mask, tag + s, bytes, out);
+      break;
+    }
+    if (r + mask < n) {
+      recv(tag + s, bytes, tmp);
+      op(out, tmp, bytes);
+    }
+  }
+
+  // broadcast phase, we wait for the result from our parent and forward it to
+  // the children we received from
+  if (r) {
+    recv(tag + PHASE_STEPS + s, bytes, out);
+  }
+  while (mask >>= 1) {
+    --s;
+    if (r + mask < n) {
+      send(r + mask, tag + PHASE_STEPS + s, bytes, out);
+    }
+  }
+  free(tmp);
+}
+
+/// A pairwise-exchange alltoall.
+///
+/// At step s each locality sends its block for rank (r + s) directly to that
+/// rank, so every pair of localities exchanges exactly one block and no
+/// locality ever holds more than its own input and output. All of the receive
+/// destinations are posted before we start sending, so incoming blocks are
+/// copied straight from their parcels into @p out.
+void
+Collective::alltoall(size_t bytes, const void *in, void *out)
+{
+  if (sync(ALL_TO_ALL, bytes, in, out, nullptr)) {
+    return;
+  }
+
+  unsigned n = here->ranks;
+  unsigned r = here->rank;
+  const char *src = static_cast<const char*>(in);
+  char *dst = static_cast<char*>(out);
+  memcpy(dst + r * bytes, src + r * bytes, bytes);
+  if (n == 1) {
+    return;
+  }
+
+  uint64_t tag = begin();
+  hpx_addr_t done = hpx_lco_and_new(n - 1);
+  for (unsigned s = 1; s < n; ++s) {
+    unsigned from = (r + n - s) % n;
+    post(tag + s, bytes, dst + from * bytes, done);
+  }
+  for (unsigned s = 1; s < n; ++s) {
+    unsigned to = (r + s) % n;
+    send(to, tag + s, bytes, src + to * bytes);
+  }
+  dbg_check( hpx_lco_wait(done) );
+  hpx_lco_delete_sync(done);
+}
+
+/// A ring reduce-scatter.
+///
+/// At step s we forward the partial reduction for block (r - s - 1) to our
+/// right neighbor, and receive the partial reduction for block (r - s - 2)
+/// from our left neighbor, adding our own contribution. After P - 1 steps the
+/// partial we hold is the complete reduction for our own block.
+void
+Collective::reduceScatter(size_t bytes, const void *in, void *out,
+                          hpx_monoid_op_t op)
+{
+  if (sync(REDUCE_SCATTER, bytes, in, out, op)) {
+    return;
+  }
+
+  unsigned n = here->ranks;
+  unsigned r = here->rank;
+  unsigned right = (r + 1) % n;
+  const char *blocks = static_cast<const char*>(in);
+  char *partial = static_cast<char*>(malloc(bytes));
+  memcpy(partial, blocks + ((r + n - 1) % n) * bytes, bytes);
+
+  uint64_t tag = begin();
+  for (unsigned s = 0; s + 1 < n; ++s) {
+    unsigned j = (r + 2 * n - s - 2) % n;
+    send(right, tag + s, bytes, partial);
+    recv(tag + s, bytes, partial);
+    op(partial, blocks + j * bytes, bytes);
+  }
+
+  memcpy(out, partial, bytes);
+  free(partial);
+}
+
+/// A recursive-doubling scan.
+///
+/// At step s each locality sends its running prefix to the locality 2^s ranks
+/// above it, and folds in the prefix from the locality 2^s ranks below it, so
+/// the scan completes in ceil(log2 P) steps. The exclusive variant separately
+/// accumulates just the values that arrived from below.
+void
+Collective::scan(size_t bytes, const void *in, void *out, hpx_monoid_id_t id,
+                 hpx_monoid_op_t op, bool exclusive)
+{
+  unsigned n = here->ranks;
+  unsigned r = here->rank;
+
+  if (sync(exclusive ? EXSCAN : SCAN, bytes, in, out, op)) {
+    if (exclusive && r == 0) {
+      id(out, bytes);
+    }
+    return;
+  }
+
+  char *prefix = static_cast<char*>(malloc(bytes));
+  char *tmp = static_cast<char*>(malloc(bytes));
+  memcpy(prefix, in, bytes);
+  if (exclusive) {
+    id(out, bytes);
+  }
+
+  uint64_t tag = begin();
+  for (unsigned d = 1, s = 0; d < n; d <<= 1, ++s) {
+    if (r + d < n) {
+      send(r + d, tag + s, bytes, prefix);
+    }
+    if (r >= d) {
+      recv(tag + s, bytes, tmp);
+      op(prefix, tmp, bytes);
+      if (exclusive) {
+        op(out, tmp, bytes);
+      }
+    }
+  }
+
+  if (!exclusive) {
+    memcpy(out, prefix, bytes);
+  }
+  free(tmp);
+  free(prefix);
+}
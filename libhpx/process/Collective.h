@@ -0,0 +1,114 @@
+// ==================================================================-*- C++ -*-
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifndef LIBHPX_PROCESS_COLLECTIVE_H
+#define LIBHPX_PROCESS_COLLECTIVE_H
+
+#include "libhpx/collective.h"
+#include "hpx/hpx.h"
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+namespace libhpx {
+namespace process {
+/// A locality-level collective communicator.
+///
+/// The collective is a cyclic array with one element per locality. Each
+/// locality calls the same sequence of collective operations on its local
+/// element, and the elements exchange point-to-point messages with each other
+/// to implement them. Messages are tagged with the operation's epoch and step.
+/// A receiver may post a destination buffer for a tag in advance, in which case
+/// the message is copied straight from the parcel into it, otherwise the
+/// message is buffered until the receiver asks for it, so neighbors may run
+/// ahead. Operations that have begun may run concurrently, since each one
+/// uses its own tags.
+class Collective {
+ public:
+  Collective(hpx_addr_t base);
+  ~Collective();
+
+  void allgather(size_t bytes, const void *in, void *out);
+  void allreduce(size_t bytes, const void *in, void *out, hpx_monoid_op_t op);
+  void alltoall(size_t bytes, const void *in, void *out);
+  void reduceScatter(size_t bytes, const void *in, void *out,
+                     hpx_monoid_op_t op);
+  void scan(size_t bytes, const void *in, void *out, hpx_monoid_id_t id,
+            hpx_monoid_op_t op, bool exclusive);
+
+  /// Run an operation through the network's collective hooks, if enabled.
+  bool sync(coll_type_t type, size_t bytes, const void *in, void *out,
+            hpx_monoid_op_t op);
+
+  /// Start a new operation and return its message tag base.
+  ///
+  /// Operations are matched across localities by the order in which they
+  /// begin, so a non-blocking operation reserves its tag when it is started
+  /// and may then run concurrently with later operations.
+  uint64_t begin();
+
+  /// The point-to-point algorithms for operations that have already begun.
+  /// @{
+  void allgather(uint64_t tag, size_t bytes, const void *in, void *out);
+  void allreduce(uint64_t tag, size_t bytes, const void *in, void *out,
+                 hpx_monoid_op_t op);
+  /// @}
+
+  static HPX_ACTION_DECL(Init);
+  static HPX_ACTION_DECL(Fini);
+  static HPX_ACTION_DECL(Deliver);
+
+ private:
+  static int InitHandler(void *buffer, hpx_addr_t base);
+
+  static int FiniHandler(Collective *c) {
+    c->~Collective();
+    return HPX_SUCCESS;
+  }
+
+  static int DeliverHandler(Collective *c, void *args, size_t bytes);
+
+  [[ gnu::constructor ]] static void InitializeActions();
+
+  /// Send a tagged message to the element at @p rank.
+  void send(unsigned rank, uint64_t tag, size_t bytes, const void *data);
+
+  /// Wait for the tagged message and copy it to @p data.
+  void recv(uint64_t tag, size_t bytes, void *data);
+
+  /// Post a destination for a tagged message, and set @p done on arrival.
+  void post(uint64_t tag, size_t bytes, void *dest, hpx_addr_t done);
+
+  /// Find or allocate the future that buffers a tagged message.
+  hpx_addr_t slot(uint64_t tag, size_t bytes);
+
+  /// The slot lookup, with the lock already held.
+  hpx_addr_t slotLocked(uint64_t tag, size_t bytes);
+
+  /// A posted destination for a message.
+  struct Posted {
+    void       *dest;
+    hpx_addr_t  done;
+  };
+
+  const hpx_addr_t       base_;         // the collective array
+  std::atomic<uint64_t> epoch_;         // the number of operations started
+  std::mutex             lock_;         // protects the slot maps
+  std::unordered_map<uint64_t, hpx_addr_t> slots_;
+  std::unordered_map<uint64_t, Posted>    posted_;
+  coll_t                 *ctx_;         // network collective context
+};
+} // namespace process
+} // namespace libhpx
+
+#endif // LIBHPX_PROCESS_COLLECTIVE_H
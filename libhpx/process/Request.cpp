@@ -0,0 +1,132 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "Request.h"
+#include "libhpx/action.h"
+#include "libhpx/debug.h"
+#include "libhpx/locality.h"
+
+namespace {
+using libhpx::process::Collective;
+using libhpx::process::Request;
+constexpr size_t BSIZE = sizeof(Collective);
+}
+
+HPX_ACTION_DECL(Request::Run);
+
+void
+Request::InitializeActions()
+{
+  LIBHPX_REGISTER_ACTION(HPX_DEFAULT, 0, Request::Run, Request::RunHandler,
+                         HPX_POINTER);
+}
+
+Request::Request(hpx_addr_t collective, coll_type_t type, size_t bytes,
+                 const void *in, void *out, hpx_monoid_op_t op)
+    : proxy_(hpx_addr_add(collective, here->rank * BSIZE, BSIZE)),
+      c_(nullptr),
+      type_(type),
+      bytes_(bytes),
+      in_(in),
+      out_(out),
+      op_(op),
+      done_(hpx_lco_future_new(0)),
+      tag_(0),
+      active_(false),
+      finished_(false)
+{
+  if (!hpx_gas_try_pin(proxy_, reinterpret_cast<void**>(&c_))) {
+    dbg_error("could not pin local element for a collective\n");
+  }
+}
+
+Request::~Request()
+{
+  dbg_assert(!active_);
+  hpx_lco_delete_sync(done_);
+  hpx_gas_unpin(proxy_);
+}
+
+void
+Request::start()
+{
+  if (active_.exchange(true)) {
+    dbg_error("request started while it was still active\n");
+  }
+
+  if (c_->sync(type_, bytes_, in_, out_, op_)) {
+    finished_.store(true, std::memory_order_release);
+    hpx_lco_set(done_, 0, NULL, HPX_NULL, HPX_NULL);
+    return;
+  }
+
+  tag_ = c_->begin();
+  Request *r = this;
+  dbg_check( hpx_call(HPX_HERE, Run, HPX_NULL, &r) );
+}
+
+void
+Request::run()
+{
+  switch (type_) {
+   case ALL_REDUCE:
+    c_->allreduce(tag_, bytes_, in_, out_, op_);
+    break;
+   case ALL_GATHER:
+    c_->allgather(tag_, bytes_, in_, out_);
+    break;
+   default:
+    dbg_error("unsupported persistent collective %d\n", type_);
+  }
+  finished_.store(true, std::memory_order_release);
+  hpx_lco_set(done_, 0, NULL, HPX_NULL, HPX_NULL);
+}
+
+bool
+Request::test()
+{
+  if (!active_) {
+    return true;
+  }
+  if (!finished_.load(std::memory_order_acquire)) {
+    return false;
+  }
+  complete();
+  return true;
+}
+
+hpx_status_t
+Request::wait()
+{
+  if (!active_) {
+    return HPX_SUCCESS;
+  }
+  hpx_status_t status = hpx_lco_wait(done_);
+  complete();
+  return status;
+}
+
+void
+Request::complete()
+{
+  // the finished flag is set before the future, so make sure the set has
+  // landed before we reset it
+  dbg_check( hpx_lco_wait(done_) );
+  hpx_lco_reset_sync(done_);
+  finished_.store(false, std::memory_order_relaxed);
+  active_.store(false, std::memory_order_release);
+}
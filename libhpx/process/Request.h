@@ -0,0 +1,80 @@
+// ==================================================================-*- C++ -*-
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifndef LIBHPX_PROCESS_REQUEST_H
+#define LIBHPX_PROCESS_REQUEST_H
+
+#include "Collective.h"
+#include "hpx/hpx.h"
+#include <atomic>
+
+namespace libhpx {
+namespace process {
+/// A persistent non-blocking collective operation.
+///
+/// A request binds an operation to a collective and to its buffers once, and
+/// can then be started and completed any number of times. The collective's
+/// local element stays pinned and the completion LCO is allocated for the
+/// lifetime of the request, so each iteration only costs the operation itself.
+class Request {
+ public:
+  Request(hpx_addr_t collective, coll_type_t type, size_t bytes,
+          const void *in, void *out, hpx_monoid_op_t op);
+  ~Request();
+
+  /// Start the operation.
+  ///
+  /// The operation's tag is reserved here, so a started request is ordered
+  /// with respect to the other operations on the collective even though it
+  /// runs asynchronously. The network collectives can't be overlapped, so they
+  /// complete before this returns.
+  void start();
+
+  /// Check if the operation has completed, without blocking.
+  bool test();
+
+  /// Wait for the operation to complete.
+  hpx_status_t wait();
+
+  static HPX_ACTION_DECL(Run);
+
+ private:
+  static int RunHandler(Request *r) {
+    r->run();
+    return HPX_SUCCESS;
+  }
+
+  [[ gnu::constructor ]] static void InitializeActions();
+
+  /// Run the operation's algorithm, and signal completion.
+  void run();
+
+  /// Reset the request after we've observed its completion.
+  void complete();
+
+  const hpx_addr_t      proxy_;         // the collective's local element
+  Collective               *c_;         // the pinned local element
+  const coll_type_t      type_;         // the operation
+  const size_t          bytes_;         // the operation's size
+  const void              *in_;         // the input buffer
+  void                   *out_;         // the output buffer
+  const hpx_monoid_op_t    op_;         // the reduction, if any
+  const hpx_addr_t       done_;         // signaled when the operation finishes
+  uint64_t                tag_;         // the current operation's tag
+  std::atomic<bool>    active_;         // started and not yet completed
+  std::atomic<bool>  finished_;         // the operation has finished
+};
+} // namespace process
+} // namespace libhpx
+
+#endif // LIBHPX_PROCESS_REQUEST_H
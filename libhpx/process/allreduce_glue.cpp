@@ -26,27 +26,69 @@ using libhpx::process::Allreduce;
 constexpr size_t BSIZE = sizeof(Allreduce);
 }
 
+/// Get the fan-out of the allreduce tree.
+///
+/// A radix smaller than two selects the original flat tree, where every leaf
+/// joins a single root. The network-based collectives rely on that root to
+/// collect the participating ranks, so they always use the flat tree.
+static unsigned
+_radix(void)
+{
+  unsigned radix = here->config->coll_radix;
+  if (here->config->coll_network || radix < 2) {
+    return 0;
+  }
+  return radix;
+}
+
+/// Get the address of the parent for the element at @p rank.
+///
+/// The per-locality elements form a k-ary tree rooted at rank 0, so a join or
+/// broadcast crosses O(log_k P) levels instead of funneling through a root
+/// with P children. Each element's local Reduce already combines the inputs
+/// from its own locality before it joins its parent, and adjacent ranks, which
+/// are usually placed on the same node, are siblings in the tree.
+static hpx_addr_t
+_parent(hpx_addr_t base, unsigned rank, unsigned radix)
+{
+  if (rank == 0) {
+    return HPX_NULL;
+  }
+  return hpx_addr_add(base, ((rank - 1) / radix) * BSIZE, BSIZE);
+}
+
 hpx_addr_t
 hpx_process_collective_allreduce_new(size_t bytes, hpx_action_t reset,
                                      hpx_action_t op)
 {
-  // allocate and initialize a root node
-  hpx_addr_t root = hpx_gas_alloc_local(1, BSIZE, 0);
-  dbg_assert(root);
-  hpx_addr_t null = HPX_NULL;
-  dbg_check( hpx_call_sync(root, Allreduce::Init, nullptr, 0, &bytes, &null,
-                           &reset, &op) );
-
   // allocate an array of local elements for the process
   int n = here->ranks;
   hpx_addr_t base = hpx_gas_alloc_cyclic(n, BSIZE, 0);
   dbg_assert(base);
 
-  // initialize the array to point to the root as their parent (fat tree)
   hpx_addr_t done = hpx_lco_and_new(n);
-  dbg_check( hpx_gas_bcast_with_continuation(Allreduce::Init, base, n, 0, BSIZE,
-                                             hpx_lco_set_action, done, &bytes,
-                                             &root, &reset, &op) );
+  if (unsigned radix = _radix()) {
+    // initialize the array as a k-ary tree
+    for (int i = 0; i < n; ++i) {
+      hpx_addr_t leaf = hpx_addr_add(base, i * BSIZE, BSIZE);
+      hpx_addr_t parent = _parent(base, i, radix);
+      dbg_check( hpx_call(leaf, Allreduce::Init, done, &bytes, &parent, &reset,
+                          &op) );
+    }
+  }
+  else {
+    // allocate and initialize a root node
+    hpx_addr_t root = hpx_gas_alloc_local(1, BSIZE, 0);
+    dbg_assert(root);
+    hpx_addr_t null = HPX_NULL;
+    dbg_check( hpx_call_sync(root, Allreduce::Init, nullptr, 0, &bytes, &null,
+                             &reset, &op) );
+
+    // initialize the array to point to the root as their parent (fat tree)
+    dbg_check( hpx_gas_bcast_with_continuation(Allreduce::Init, base, n, 0,
+                                               BSIZE, hpx_lco_set_action, done,
+                                               &bytes, &root, &reset, &op) );
+  }
   hpx_lco_wait(done);
   hpx_lco_delete_sync(done);
 
@@ -58,23 +100,31 @@ hpx_process_collective_allreduce_new(size_t bytes, hpx_action_t reset,
 void
 hpx_process_collective_allreduce_delete(hpx_addr_t allreduce)
 {
-  Allreduce *r;
-  hpx_addr_t proxy = hpx_addr_add(allreduce, here->rank * BSIZE, BSIZE);
-  if (!hpx_gas_try_pin(proxy, reinterpret_cast<void**>(&r))) {
-    dbg_error("could not pin local element for an allreduce\n");
+  // the flat tree has an extra root node that isn't part of the array
+  hpx_addr_t root = HPX_NULL;
+  if (!_radix()) {
+    Allreduce *r;
+    hpx_addr_t proxy = hpx_addr_add(allreduce, here->rank * BSIZE, BSIZE);
+    if (!hpx_gas_try_pin(proxy, reinterpret_cast<void**>(&r))) {
+      dbg_error("could not pin local element for an allreduce\n");
+    }
+    root = r->getParent();
+    hpx_gas_unpin(proxy);
   }
-  hpx_addr_t root = r->getParent();
-  hpx_gas_unpin(proxy);
 
   int n = here->ranks;
-  hpx_addr_t done = hpx_lco_and_new(n + 1);
+  hpx_addr_t done = hpx_lco_and_new(n + (root != HPX_NULL));
   dbg_check( hpx_gas_bcast_with_continuation(Allreduce::Fini, allreduce, n, 0,
                                              BSIZE, hpx_lco_set_action, done) );
-  dbg_check( hpx_call(root, Allreduce::Fini, done) );
+  if (root) {
+    dbg_check( hpx_call(root, Allreduce::Fini, done) );
+  }
   hpx_lco_wait(done);
   hpx_lco_delete_sync(done);
 
-  hpx_gas_free_sync(root);
+  if (root) {
+    hpx_gas_free_sync(root);
+  }
   hpx_gas_free_sync(allreduce);
 }
 
@@ -15,43 +15,124 @@
 # include "config.h"
 #endif
 
+/// @file libhpx/process/broadcast.cpp
+/// @brief Implements the process broadcast.
+///
+/// Broadcasts travel down a k-ary spanning tree rooted at the calling
+/// locality, rather than having the root send one parcel to every rank. The
+/// action's arguments are marshalled once at the root, and each node in the
+/// tree forwards the same payload to its children before running the action
+/// locally. Remote completion is aggregated up the tree, so the root only ever
+/// waits for its own children.
+
 #include <hpx/hpx.h>
 #include <libhpx/action.h>
 #include <libhpx/debug.h>
 #include <libhpx/locality.h>
+#include <libhpx/parcel.h>
+#include <libhpx/process.h>
+#include <algorithm>
+#include <cstring>
 
-/// The core broadcast handler.
+namespace {
+/// The header that precedes the marshalled action arguments.
+struct Header {
+  hpx_action_t action;                          //!< the broadcast action
+  uint32_t       root;                          //!< the tree's root rank
+  uint32_t      vrank;                          //!< rank relative to root
+  uint32_t      rsync;                          //!< aggregate completion?
+  char      payload[];                          //!< the action's arguments
+};
+
+/// Allocate a serialized tree parcel and copy the header and payload into it.
+hpx_parcel_t*
+_tree_parcel(hpx_action_t tree, uint32_t rank, hpx_addr_t c_target,
+             const Header& h, const void *payload, size_t bytes)
+{
+  hpx_action_t c_action = (c_target) ? hpx_lco_set_action : HPX_ACTION_NULL;
+  hpx_pid_t pid = hpx_thread_current_pid();
+  hpx_parcel_t *p = parcel_new(HPX_THERE(rank), tree, c_target, c_action, pid,
+                               nullptr, sizeof(h) + bytes);
+  auto *to = static_cast<Header*>(hpx_parcel_get_data(p));
+  *to = h;
+  memcpy(to->payload, payload, bytes);
+  return p;
+}
+}
+
+static int _bcast_tree_handler(Header *h, size_t n);
+static LIBHPX_ACTION(HPX_DEFAULT, HPX_MARSHALLED, _bcast_tree,
+                     _bcast_tree_handler, HPX_POINTER, HPX_SIZE_T);
+
+/// Run one node of the broadcast tree.
+///
+/// We forward the payload to each of our children, and then run the action
+/// locally. When remote completion was requested we allocate an and gate for
+/// our subtree and continue to our parent once it triggers.
 static int
-_vabcast(hpx_action_t act, hpx_addr_t lsync, hpx_addr_t rsync, int n,
-         va_list *vargs)
+_bcast_tree_handler(Header *h, size_t n)
 {
-  int e = HPX_SUCCESS;
-  hpx_addr_t remote = HPX_NULL;
-  hpx_addr_t local = HPX_NULL;
-  if (rsync) {
-    remote = hpx_lco_and_new(here->ranks);
-    e = hpx_call_when_with_continuation(remote, rsync, hpx_lco_set_action,
-                                        remote, hpx_lco_delete_action, NULL, 0);
-    dbg_check(e, "could not chain LCO\n");
+  dbg_assert(n >= sizeof(*h));
+  uint32_t ranks = here->ranks;
+  size_t bytes = n - sizeof(*h);
+  uint32_t arity = process_tree_arity();
+  uint64_t first = uint64_t(h->vrank) * arity + 1;
+  uint64_t last = std::min<uint64_t>(first + arity, ranks);
+  uint32_t children = (first < last) ? last - first : 0;
+
+  hpx_addr_t done = HPX_NULL;
+  if (h->rsync) {
+    done = hpx_lco_and_new(children + 1);
   }
 
-  if (lsync) {
-    local = hpx_lco_and_new(here->ranks);
-    e = hpx_call_when_with_continuation(local, lsync, hpx_lco_set_action,
-                                        local, hpx_lco_delete_action, NULL, 0);
-    dbg_check(e, "could not chain LCO\n");
+  for (uint32_t i = 0; i < children; ++i) {
+    Header child = *h;
+    child.vrank = first + i;
+    uint32_t rank = (child.vrank + h->root) % ranks;
+    parcel_launch(_tree_parcel(_bcast_tree, rank, done, child, h->payload,
+                               bytes));
   }
 
-  for (int i = 0, e = here->ranks; i < e; ++i) {
-    va_list temp;
-    va_copy(temp, *vargs);
-    hpx_addr_t loc = HPX_THERE(i);
-    hpx_action_t set = hpx_lco_set_action;
-    int err = action_call_async_va(act, loc, local, set, remote, set, n, &temp);
-    dbg_check(err, "error generating parcel for bcast.\n");
-    va_end(temp);
+  hpx_action_t set = (done) ? hpx_lco_set_action : HPX_ACTION_NULL;
+  hpx_pid_t pid = hpx_thread_current_pid();
+  hpx_parcel_t *p = parcel_new(HPX_HERE, h->action, done, set, pid, nullptr,
+                               bytes);
+  if (bytes) {
+    memcpy(hpx_parcel_get_data(p), h->payload, bytes);
   }
-  return HPX_SUCCESS;
+  parcel_launch(p);
+
+  if (!done) {
+    return HPX_SUCCESS;
+  }
+  return hpx_call_when_cc(done, done, hpx_lco_delete_action);
+}
+
+/// The core broadcast handler.
+///
+/// This marshals the arguments once, and sends them to the root of the tree at
+/// the current locality. The @p lsync LCO is set once that parcel is sent,
+/// since the arguments have been captured by then.
+static int
+_vabcast(hpx_action_t act, hpx_addr_t lsync, hpx_addr_t rsync, int n,
+         va_list *vargs)
+{
+  hpx_parcel_t *args = action_new_parcel_va(act, HPX_HERE, 0, 0, n, vargs);
+  dbg_assert_str(args, "error generating parcel for bcast.\n");
+
+  Header h;
+  h.action = act;
+  h.root = here->rank;
+  h.vrank = 0;
+  h.rsync = (rsync != HPX_NULL);
+  void *payload = (args->size) ? hpx_parcel_get_data(args) : nullptr;
+  hpx_parcel_t *p = _tree_parcel(_bcast_tree, here->rank, rsync, h, payload,
+                                 args->size);
+  parcel_delete(args);
+
+  int e = hpx_parcel_send(p, lsync);
+  dbg_check(e, "error sending bcast parcel.\n");
+  return e;
 }
 
 int
@@ -0,0 +1,185 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "Collective.h"
+#include "Request.h"
+#include "libhpx/action.h"
+#include "libhpx/debug.h"
+#include "libhpx/events.h"
+#include "libhpx/locality.h"
+
+namespace {
+using libhpx::process::Collective;
+using libhpx::process::Request;
+constexpr size_t BSIZE = sizeof(Collective);
+
+/// Pin the calling locality's element of a collective.
+class LocalElement {
+ public:
+  LocalElement(hpx_addr_t collective)
+      : proxy_(hpx_addr_add(collective, here->rank * BSIZE, BSIZE)),
+        c_(nullptr)
+  {
+    if (!hpx_gas_try_pin(proxy_, reinterpret_cast<void**>(&c_))) {
+      dbg_error("could not pin local element for a collective\n");
+    }
+  }
+
+  ~LocalElement() {
+    hpx_gas_unpin(proxy_);
+  }
+
+  Collective* operator->() const {
+    return c_;
+  }
+
+ private:
+  const hpx_addr_t proxy_;
+  Collective *c_;
+};
+}
+
+hpx_addr_t
+hpx_process_collective_new(void)
+{
+  int n = here->ranks;
+  hpx_addr_t base = hpx_gas_alloc_cyclic(n, BSIZE, 0);
+  dbg_assert(base);
+
+  hpx_addr_t done = hpx_lco_and_new(n);
+  dbg_check( hpx_gas_bcast_with_continuation(Collective::Init, base, n, 0, BSIZE,
+                                             hpx_lco_set_action, done, &base) );
+  hpx_lco_wait(done);
+  hpx_lco_delete_sync(done);
+
+  EVENT_COLLECTIVE_NEW(base);
+  return base;
+}
+
+void
+hpx_process_collective_delete(hpx_addr_t collective)
+{
+  int n = here->ranks;
+  hpx_addr_t done = hpx_lco_and_new(n);
+  dbg_check( hpx_gas_bcast_with_continuation(Collective::Fini, collective, n, 0,
+                                             BSIZE, hpx_lco_set_action, done) );
+  hpx_lco_wait(done);
+  hpx_lco_delete_sync(done);
+  hpx_gas_free_sync(collective);
+}
+
+int
+hpx_process_allgather(hpx_addr_t collective, size_t bytes, const void *in,
+                      void *out)
+{
+  LocalElement c(collective);
+  c->allgather(bytes, in, out);
+  return HPX_SUCCESS;
+}
+
+int
+hpx_process_allreduce(hpx_addr_t collective, size_t bytes, const void *in,
+                      void *out, hpx_action_t op)
+{
+  hpx_monoid_op_t rop = (hpx_monoid_op_t)actions[op].handler;
+  LocalElement c(collective);
+  c->allreduce(bytes, in, out, rop);
+  return HPX_SUCCESS;
+}
+
+int
+hpx_process_alltoall(hpx_addr_t collective, size_t bytes, const void *in,
+                     void *out)
+{
+  LocalElement c(collective);
+  c->alltoall(bytes, in, out);
+  return HPX_SUCCESS;
+}
+
+int
+hpx_process_reduce_scatter(hpx_addr_t collective, size_t bytes, const void *in,
+                           void *out, hpx_action_t op)
+{
+  hpx_monoid_op_t rop = (hpx_monoid_op_t)actions[op].handler;
+  LocalElement c(collective);
+  c->reduceScatter(bytes, in, out, rop);
+  return HPX_SUCCESS;
+}
+
+int
+hpx_process_scan(hpx_addr_t collective, size_t bytes, const void *in,
+                 void *out, hpx_action_t id, hpx_action_t op)
+{
+  hpx_monoid_id_t rid = (hpx_monoid_id_t)actions[id].handler;
+  hpx_monoid_op_t rop = (hpx_monoid_op_t)actions[op].handler;
+  LocalElement c(collective);
+  c->scan(bytes, in, out, rid, rop, false);
+  return HPX_SUCCESS;
+}
+
+int
+hpx_process_exscan(hpx_addr_t collective, size_t bytes, const void *in,
+                   void *out, hpx_action_t id, hpx_action_t op)
+{
+  hpx_monoid_id_t rid = (hpx_monoid_id_t)actions[id].handler;
+  hpx_monoid_op_t rop = (hpx_monoid_op_t)actions[op].handler;
+  LocalElement c(collective);
+  c->scan(bytes, in, out, rid, rop, true);
+  return HPX_SUCCESS;
+}
+
+hpx_process_request_t *
+hpx_process_allreduce_init(hpx_addr_t collective, size_t bytes, const void *in,
+                           void *out, hpx_action_t op)
+{
+  hpx_monoid_op_t rop = (hpx_monoid_op_t)actions[op].handler;
+  auto r = new Request(collective, ALL_REDUCE, bytes, in, out, rop);
+  return reinterpret_cast<hpx_process_request_t*>(r);
+}
+
+hpx_process_request_t *
+hpx_process_allgather_init(hpx_addr_t collective, size_t bytes, const void *in,
+                           void *out)
+{
+  auto r = new Request(collective, ALL_GATHER, bytes, in, out, nullptr);
+  return reinterpret_cast<hpx_process_request_t*>(r);
+}
+
+int
+hpx_process_request_start(hpx_process_request_t *request)
+{
+  reinterpret_cast<Request*>(request)->start();
+  return HPX_SUCCESS;
+}
+
+int
+hpx_process_request_test(hpx_process_request_t *request)
+{
+  return reinterpret_cast<Request*>(request)->test();
+}
+
+int
+hpx_process_request_wait(hpx_process_request_t *request)
+{
+  return reinterpret_cast<Request*>(request)->wait();
+}
+
+void
+hpx_process_request_free(hpx_process_request_t *request)
+{
+  delete reinterpret_cast<Request*>(request);
+}
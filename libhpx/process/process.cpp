@@ -16,17 +16,29 @@
 #endif
 
 /// @file libhpx/scheduler/process.c
+///
+/// Credit returns are aggregated before they reach the process. Each worker
+/// caches the credit returned by finished parcels, combining sibling credits as
+/// it goes, and flushes the cache when the worker runs out of other work or
+/// after a batch of returns. Localities forward their flushed credit up a k-ary
+/// tree rooted at the process's home locality, where intermediate localities
+/// aggregate it again, so the home only hears from its children in the tree.
 #include "Bitmap.h"
 #include "libhpx/action.h"
 #include "libhpx/debug.h"
 #include "libhpx/events.h"
+#include "libhpx/GAS.h"
 #include "libhpx/locality.h"
 #include "libhpx/parcel.h"
 #include "libhpx/process.h"
+#include "libhpx/Worker.h"
 #include <cassert>
 #include <cstdlib>
 #include <cstring>
 #include <atomic>
+#include <mutex>
+#include <set>
+#include <unordered_map>
 
 namespace {
 constexpr auto ACQUIRE = std::memory_order_acquire;
@@ -35,11 +47,42 @@ constexpr auto ACQ_REL = std::memory_order_acq_rel;
 constexpr auto RELAXED = std::memory_order_relaxed;
 using libhpx::process::Bitmap;
 
+/// The number of returns a worker caches before it flushes eagerly.
+constexpr unsigned CREDIT_BATCH = 256;
+
 typedef struct {
   std::atomic<uint64_t> credit;                 // credit balance
   Bitmap                 *debt;                 // the credit that was recovered
   hpx_addr_t       termination;                 // the termination LCO
 } _process_t;
+
+/// A per-worker cache of returned credit.
+///
+/// Credit is stored as a sparse binary fraction, a set of the exponents i for
+/// which 2^-i has been returned, so that returning two sibling credits carries
+/// into their parent's credit and the cache stays small.
+struct CreditCache {
+  void add(hpx_addr_t process, uint64_t credit) {
+    std::set<uint64_t>& bits = credit_[process];
+    while (bits.erase(credit)) {
+      dbg_assert(credit > 1);
+      --credit;
+    }
+    bits.insert(credit);
+  }
+
+  std::mutex                                          lock;
+  std::unordered_map<hpx_addr_t, std::set<uint64_t>> credit_;
+  unsigned                                         pending = 0;
+  bool                                           scheduled = false;
+};
+
+/// Each worker's credit cache, constructed on first use and destroyed when the
+/// worker thread exits.
+///
+/// The flush action is passed a pointer to the cache since it may be stolen
+/// by a different worker, so this is always accessed under the cache's lock.
+thread_local CreditCache _cache;
 }
 
 static bool HPX_USED _is_tracked(_process_t *p) {
@@ -95,9 +138,10 @@ static LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED | HPX_MARSHALLED, _proc_delete,
                      _proc_delete_handler,
                      HPX_POINTER, HPX_POINTER, HPX_SIZE_T);
 
-static int _proc_return_credit_handler(_process_t *p, uint64_t *args, size_t size) {
+/// Return credit to the process, and check for termination.
+static void _return_credit(_process_t *p, uint64_t credit) {
   // add credit to the credit-accounting bitmap
-  uint64_t debt = p->debt->addAndTest(*args);
+  uint64_t debt = p->debt->addAndTest(credit);
   for (;;) {
     uint64_t credit = p->credit.load(ACQUIRE);
     if ((credit != 0) && ~(debt | ((UINT64_C(1) << (64-credit)) - 1)) == 0) {
@@ -110,12 +154,128 @@ static int _proc_return_credit_handler(_process_t *p, uint64_t *args, size_t siz
     }
     break;
   }
+}
+
+static int _proc_return_credit_handler(_process_t *p, uint64_t *args, size_t size) {
+  for (size_t i = 0, e = size / sizeof(*args); i < e; ++i) {
+    _return_credit(p, args[i]);
+  }
   return HPX_SUCCESS;
 }
 static LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED | HPX_MARSHALLED, _proc_return_credit,
                      _proc_return_credit_handler,
                      HPX_POINTER, HPX_POINTER, HPX_SIZE_T);
 
+unsigned
+process_tree_arity(void)
+{
+  unsigned radix = here->config->coll_radix;
+  return (radix < 2) ? here->ranks : radix;
+}
+
+/// Find our parent in the credit-return tree for a process.
+///
+/// The tree is rooted at the process's home locality, and we return HPX_NULL
+/// if we are the home.
+static hpx_addr_t _credit_parent(hpx_addr_t process) {
+  uint32_t ranks = here->ranks;
+  uint32_t home = here->gas->ownerOf(process);
+  uint32_t vrank = (here->rank + ranks - home) % ranks;
+  if (vrank == 0) {
+    return HPX_NULL;
+  }
+  uint32_t parent = (vrank - 1) / process_tree_arity();
+  return (parent == 0) ? process : HPX_THERE((parent + home) % ranks);
+}
+
+static int _proc_forward_credit_handler(void *args, size_t size);
+static LIBHPX_ACTION(HPX_DEFAULT, HPX_MARSHALLED, _proc_forward_credit,
+                     _proc_forward_credit_handler, HPX_POINTER, HPX_SIZE_T);
+
+/// Send a batch of credit for a process one step up the tree.
+static void _send_credit(hpx_addr_t process, const std::set<uint64_t>& bits) {
+  hpx_addr_t parent = _credit_parent(process);
+  size_t bytes = bits.size() * sizeof(uint64_t);
+  hpx_parcel_t *pp = NULL;
+  uint64_t *credit = NULL;
+  if (parent == process) {
+    pp = parcel_new(process, _proc_return_credit, 0, 0, 0, NULL, bytes);
+    credit = static_cast<uint64_t*>(hpx_parcel_get_data(pp));
+  }
+  else {
+    bytes += sizeof(process);
+    pp = parcel_new(parent, _proc_forward_credit, 0, 0, 0, NULL, bytes);
+    char *buffer = static_cast<char*>(hpx_parcel_get_data(pp));
+    memcpy(buffer, &process, sizeof(process));
+    credit = reinterpret_cast<uint64_t*>(buffer + sizeof(process));
+  }
+  if (!pp) {
+    dbg_error("parcel_recover_credit failed.\n");
+  }
+  pp->credit = 0;
+  std::copy(bits.begin(), bits.end(), credit);
+  hpx_parcel_send_sync(pp);
+}
+
+/// Flush a credit cache.
+static int _proc_flush_credit_handler(CreditCache *cache) {
+  std::unordered_map<hpx_addr_t, std::set<uint64_t>> credit;
+  {
+    std::lock_guard<std::mutex> _(cache->lock);
+    credit.swap(cache->credit_);
+    cache->pending = 0;
+    cache->scheduled = false;
+  }
+
+  for (auto&& i : credit) {
+    _send_credit(i.first, i.second);
+  }
+  return HPX_SUCCESS;
+}
+static LIBHPX_ACTION(HPX_DEFAULT, 0, _proc_flush_credit,
+                     _proc_flush_credit_handler, HPX_POINTER);
+
+/// Add credit to the current worker's cache.
+///
+/// The first addition to an empty cache schedules a flush on the worker's yield
+/// queue, which runs once the worker has drained its other work. If the cache
+/// fills up before then we flush it eagerly.
+static void _cache_credit(hpx_addr_t process, uint64_t credit) {
+  CreditCache *cache = &_cache;
+  bool flush = false;
+  bool schedule = false;
+  {
+    std::lock_guard<std::mutex> _(cache->lock);
+    cache->add(process, credit);
+    flush = (++cache->pending >= CREDIT_BATCH);
+    schedule = !flush && !cache->scheduled;
+    cache->scheduled |= schedule;
+  }
+
+  if (flush) {
+    _proc_flush_credit_handler(cache);
+  }
+  else if (schedule) {
+    hpx_parcel_t *p = action_new_parcel(_proc_flush_credit, HPX_HERE, 0, 0, 1,
+                                        &cache);
+    p->pid = 0;
+    libhpx::self->pushYield(p);
+  }
+}
+
+static int _proc_forward_credit_handler(void *args, size_t size) {
+  hpx_addr_t process;
+  memcpy(&process, args, sizeof(process));
+  const char *buffer = static_cast<const char*>(args) + sizeof(process);
+  size_t n = (size - sizeof(process)) / sizeof(uint64_t);
+  for (size_t i = 0; i < n; ++i) {
+    uint64_t credit;
+    memcpy(&credit, buffer + i * sizeof(credit), sizeof(credit));
+    _cache_credit(process, credit);
+  }
+  return HPX_SUCCESS;
+}
+
 int process_recover_credit(hpx_parcel_t *p) {
   hpx_addr_t process = p->pid;
   if (process == HPX_NULL) {
@@ -126,14 +286,15 @@ int process_recover_credit(hpx_parcel_t *p) {
     return HPX_SUCCESS;
   }
 
-  hpx_parcel_t *pp = parcel_new(process, _proc_return_credit, 0, 0, 0,
-                                &p->credit, sizeof(p->credit));
-  if (!pp) {
-    dbg_error("parcel_recover_credit failed.\n");
+  // at the home locality we can return the credit directly
+  _process_t *proc = NULL;
+  if (!_credit_parent(process) && hpx_gas_try_pin(process, (void**)&proc)) {
+    _return_credit(proc, p->credit);
+    hpx_gas_unpin(process);
+    return HPX_SUCCESS;
   }
-  pp->credit = 0;
 
-  hpx_parcel_send_sync(pp);
+  _cache_credit(process, p->credit);
   return HPX_SUCCESS;
 }
 
@@ -128,6 +128,25 @@ Condition::popAll()
   return top;
 }
 
+hpx_parcel_t *
+Condition::remove(bool (*match)(const hpx_parcel_t *, const void *),
+                  const void *arg)
+{
+  if (hasError()) {
+    return nullptr;
+  }
+
+  for (hpx_parcel_t **i = &top_; *i; i = &(*i)->next) {
+    hpx_parcel_t *p = *i;
+    if (match(p, arg)) {
+      *i = p->next;
+      p->next = nullptr;
+      return p;
+    }
+  }
+  return nullptr;
+}
+
 void
 Condition::reset()
 {
@@ -85,6 +85,16 @@ class Condition final {
   ///                       none).
   hpx_parcel_t *popAll();
 
+  /// Remove a parcel from a condition variable.
+  ///
+  /// @param        match A predicate that selects the parcel to remove.
+  /// @param          arg The argument passed to @p match.
+  ///
+  /// @return             The first waiting parcel that @p match selects, or
+  ///                       NULL if there is none or the condition has an error.
+  hpx_parcel_t *remove(bool (*match)(const hpx_parcel_t *, const void *),
+                       const void *arg);
+
   /// Signal a condition.
   ///
   /// The calling thread must hold the lock protecting the condition. This call is
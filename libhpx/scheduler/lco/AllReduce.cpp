@@ -17,6 +17,11 @@
 
 /// @file libhpx/scheduler/allreduce.c
 /// @brief Defines the all-reduction LCO.
+///
+/// The allreduce keeps two value buffers and alternates between them on each
+/// epoch. Readers of a completed epoch can hold a reference to its buffer
+/// while the next epoch accumulates in the other one, so hpx_lco_getref() on
+/// an allreduce doesn't need to copy the value out.
 
 #include "LCO.h"
 #include "Condition.h"
@@ -46,6 +51,8 @@ class AllReduce final : public LCO {
   }
 
   hpx_status_t attach(hpx_parcel_t *p);
+  hpx_parcel_t* detach(bool (*match)(const hpx_parcel_t*, const void*),
+                       const void* arg);
 
   int set(size_t size, const void *value) {
     //lock(TRACE_EVENT_LCO_SET);
@@ -64,17 +71,11 @@ class AllReduce final : public LCO {
     return getInner(size, value, reset);
   }
 
-  hpx_status_t getRef(size_t size, void **out, int *unpin) {
-    // We can't retain a pointer to their buffer due to implicit reset.
-    *out = registered_malloc(size);
-    *unpin = 1;
-    return get(size, *out, 0);
-  }
+  hpx_status_t getRef(size_t size, void **out, int *unpin);
 
   bool release(void *out) {
-    // We know that allreduce buffers were always copies.
-    registered_free(out);
-    return false;
+    dbg_assert(out == buffer(0) || out == buffer(1));
+    return true;
   }
 
   hpx_status_t wait(int reset) {
@@ -88,7 +89,12 @@ class AllReduce final : public LCO {
   }
 
   size_t size(size_t bytes) const {
-    return sizeof(AllReduce) + bytes;
+    return sizeof(AllReduce) + Buffers(bytes);
+  }
+
+  /// The number of bytes needed for the value buffers.
+  static size_t Buffers(size_t bytes) {
+    return 2 * Stride(bytes);
   }
 
   int join(size_t size, const void* value, void* out) {
@@ -119,12 +125,22 @@ class AllReduce final : public LCO {
   /// @}
 
  private:
+  /// The distance between the two value buffers, which keeps them aligned.
+  static size_t Stride(size_t bytes) {
+    return (bytes + 15) & ~size_t(15);
+  }
+
+  /// Get one of the value buffers.
+  char* buffer(unsigned i) {
+    return value_ + i * Stride(size_);
+  }
+
   /// Helper function that applies the stored operation.
   void op(size_t size, const void* from) {
     if (size) {
       dbg_assert(from && op_);
       hpx_monoid_op_t f = (hpx_monoid_op_t)actions[op_].handler;
-      f(value_, from, size);
+      f(buffer(current_), from, size);
     }
   }
 
@@ -132,7 +148,7 @@ class AllReduce final : public LCO {
   void id(size_t size) {
     if (id_) {
       hpx_monoid_id_t f = (hpx_monoid_id_t)actions[id_].handler;
-      f(value_, size);
+      f(buffer(current_), size);
     }
   }
 
@@ -158,8 +174,10 @@ class AllReduce final : public LCO {
   const size_t   writers_;
   const hpx_action_t  id_;
   const hpx_action_t  op_;
+  const size_t     size_;
   size_t           count_;
   volatile int     phase_;
+  unsigned       current_;                      // the epoch's buffer
   alignas(16) char value_[];
 };
 
@@ -218,17 +236,20 @@ AllReduce::getInner(size_t size, void *out, int reset)
 
   // copy out the value if the caller wants it
   if (size) {
-    memcpy(out, value_, size);
+    memcpy(out, buffer(current_), size);
   }
 
   // update the count, if I'm the last reader to arrive, switch the mode and
   // release all of the other readers, otherwise wait for the phase to change
   // back to reducing---this blocking behavior prevents gets from one "epoch"
-  // to satisfy earlier READING epochs because sets don't block
+  // to satisfy earlier READING epochs because sets don't block. The next
+  // epoch accumulates in the other buffer, so references to this one stay
+  // valid until the next epoch has been read.
   if (readers_ == ++count_) {
     count_ = writers_;
     phase_ = REDUCING;
-    id(size);
+    current_ ^= 1;
+    id(size_);
     epoch_.signalAll();
     return HPX_SUCCESS;
   }
@@ -242,6 +263,27 @@ AllReduce::getInner(size_t size, void *out, int reset)
   return HPX_SUCCESS;
 }
 
+/// Returns a reference to the reduced value, waiting for the reduction to
+/// complete.
+///
+/// The reference stays valid until the following epoch has been read, and the
+/// LCO stays pinned until it is released.
+hpx_status_t
+AllReduce::getRef(size_t size, void **out, int *unpin)
+{
+  dbg_assert(size && out);
+  std::lock_guard<LCO> _(*this);
+  while (phase_ != READING) {
+    if (auto status = waitFor(epoch_)) {
+      return status;
+    }
+  }
+
+  *out = buffer(current_);
+  *unpin = 0;
+  return getInner(0, nullptr, 0);
+}
+
 hpx_status_t
 AllReduce::attach(hpx_parcel_t *p)
 {
@@ -265,6 +307,14 @@ AllReduce::attach(hpx_parcel_t *p)
   return HPX_SUCCESS;
 }
 
+hpx_parcel_t*
+AllReduce::detach(bool (*match)(const hpx_parcel_t*, const void*),
+                  const void* arg)
+{
+  std::lock_guard<LCO> _(*this);
+  return epoch_.remove(match, arg);
+}
+
 
 AllReduce::AllReduce(size_t writers, size_t readers, size_t size,
                      hpx_action_t id, hpx_action_t op)
@@ -274,8 +324,10 @@ AllReduce::AllReduce(size_t writers, size_t readers, size_t size,
       writers_(writers),
       id_(id),
       op_(op),
+      size_(size),
       count_(writers),
-      phase_(REDUCING)
+      phase_(REDUCING),
+      current_(0)
 {
   if (size) {
     assert(id);
@@ -290,7 +342,8 @@ hpx_lco_allreduce_new(size_t inputs, size_t outputs, size_t size,
 {
   hpx_addr_t gva = HPX_NULL;
   try {
-    AllReduce* lva = new(size, gva) AllReduce(inputs, outputs, size, id, op);
+    size_t bytes = AllReduce::Buffers(size);
+    AllReduce* lva = new(bytes, gva) AllReduce(inputs, outputs, size, id, op);
     hpx_gas_unpin(gva);
     LCO_LOG_NEW(gva, lva);
   }
@@ -304,7 +357,7 @@ hpx_addr_t
 hpx_lco_allreduce_local_array_new(int n, size_t participants, size_t readers,
                                   size_t size, hpx_action_t id, hpx_action_t op)
 {
-  size_t bsize = sizeof(AllReduce) + size;
+  size_t bsize = sizeof(AllReduce) + AllReduce::Buffers(size);
   hpx_addr_t base = lco_alloc_local(n, bsize, 0);
   if (!base) {
     throw std::bad_alloc();
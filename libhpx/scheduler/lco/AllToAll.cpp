@@ -98,6 +98,8 @@ class AllToAll final : public LCO {
   hpx_status_t getId(unsigned offset, size_t size, void *out);
 
   hpx_status_t attach(hpx_parcel_t *p);
+  hpx_parcel_t* detach(bool (*match)(const hpx_parcel_t*, const void*),
+                       const void* arg);
 
   int set(size_t size, const void *value) {
     // @todo: why is this an LCO?
@@ -199,6 +201,14 @@ AllToAll::attach(hpx_parcel_t *p)
   return HPX_SUCCESS;
 }
 
+hpx_parcel_t*
+AllToAll::detach(bool (*match)(const hpx_parcel_t*, const void*),
+                 const void* arg)
+{
+  std::lock_guard<LCO> _(*this);
+  return wait_.remove(match, arg);
+}
+
 hpx_status_t
 AllToAll::getId(unsigned offset, size_t size, void *out)
 {
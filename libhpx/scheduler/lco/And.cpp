@@ -61,6 +61,8 @@ class And final : public LCO {
   int set(size_t size, const void *value);
   hpx_status_t wait(int reset);
   hpx_status_t attach(hpx_parcel_t *p);
+  hpx_parcel_t* detach(bool (*match)(const hpx_parcel_t*, const void*),
+                       const void* arg);
 
  public:
   /// Static action interface.
@@ -148,6 +150,14 @@ And::attach(hpx_parcel_t *p)
   return barrier_.push(p);
 }
 
+hpx_parcel_t*
+And::detach(bool (*match)(const hpx_parcel_t*, const void*),
+            const void* arg)
+{
+  std::lock_guard<LCO> _(*this);
+  return barrier_.remove(match, arg);
+}
+
 int
 And::set(size_t size, const void *from)
 {
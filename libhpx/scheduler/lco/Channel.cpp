@@ -0,0 +1,425 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+/// @file libhpx/scheduler/lco/Channel.cpp
+/// @brief Implements a bounded, multi-producer multi-consumer channel LCO.
+///
+/// A channel is a fixed-capacity ring of fixed-size items. Senders suspend
+/// while the ring is full and receivers suspend while it is empty. Closing the
+/// channel wakes everyone; receivers drain the remaining items and then see
+/// HPX_LCO_CHAN_EMPTY, and sends to a closed channel fail with HPX_LCO_ERROR.
+///
+/// Remote senders and receivers move batches of items in a single parcel, so
+/// the send_n() and recv_n() operations cost one message regardless of how
+/// many items they transfer.
+
+#include "LCO.h"
+#include "Condition.h"
+#include "libhpx/action.h"
+#include "libhpx/debug.h"
+#include "libhpx/parcel.h"
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+namespace {
+using libhpx::scheduler::Condition;
+using libhpx::scheduler::LCO;
+
+class Channel final : public LCO {
+ public:
+  Channel(unsigned capacity, size_t size);
+
+  ~Channel() {
+    lock();                                     // Released in ~LCO()
+  }
+
+  int set(size_t size, const void *value) {
+    dbg_assert(size == size_);
+    send(1, static_cast<const char*>(value));   // set() can't report that the
+    return 1;                                   // channel was closed
+  }
+
+  void error(hpx_status_t code) {
+    std::lock_guard<LCO> _(*this);
+    notEmpty_.signalError(code);
+    notFull_.signalError(code);
+    ready_.signalError(code);
+  }
+
+  hpx_status_t get(size_t size, void *value, int reset) {
+    dbg_assert(size == size_);
+    int count;
+    return recv(1, static_cast<char*>(value), true, count);
+  }
+
+  hpx_status_t wait(int reset);
+  hpx_status_t attach(hpx_parcel_t *p);
+  void reset();
+
+  size_t size(size_t) const {
+    return sizeof(Channel) + capacity_ * size_;
+  }
+
+  /// Insert @p n items into the channel, suspending while it is full.
+  ///
+  /// @returns          HPX_SUCCESS, HPX_LCO_ERROR if the channel was closed
+  ///                   before all of the items were sent, or the channel's
+  ///                   error code.
+  hpx_status_t send(int n, const char* items);
+
+  /// Remove up to @p n items from the channel.
+  ///
+  /// If @p block is set this suspends until at least one item is available.
+  ///
+  /// @returns          HPX_SUCCESS, HPX_LCO_CHAN_EMPTY if no item could be
+  ///                   received, or the channel's error code.
+  hpx_status_t recv(int n, char* items, bool block, int& count);
+
+  /// Close the channel, waking all of the senders and receivers.
+  void close();
+
+  size_t getSize() const {
+    return size_;
+  }
+
+ public:
+  /// Static action interface.
+  /// @{
+  static int NewHandler(void* buffer, unsigned capacity, size_t size) {
+    auto lco = new(buffer) Channel(capacity, size);
+    return HPX_THREAD_CONTINUE(lco);
+  }
+
+  static int SendHandler(Channel& lco, const char* items, size_t n) {
+    dbg_assert(n % lco.size_ == 0);
+    if (auto status = lco.send(n / lco.size_, items)) {
+      return ContinueError(status);
+    }
+    return HPX_SUCCESS;
+  }
+
+  /// The reply to a remote receive, items are written directly into the
+  /// continuation parcel.
+  struct RecvReply {
+    hpx_status_t status;
+    int           count;
+    char        items[];
+  };
+
+  static int RecvHandler(Channel& lco, int n, int block);
+
+  static int CloseHandler(Channel& lco) {
+    lco.close();
+    return HPX_SUCCESS;
+  }
+  /// @}
+
+ private:
+  char* slot(unsigned i) {
+    return ring_ + (i % capacity_) * size_;
+  }
+
+  Condition   notEmpty_;                        //!< receivers
+  Condition    notFull_;                        //!< senders
+  Condition      ready_;                        //!< wait() and attach()
+  const unsigned capacity_;
+  const size_t       size_;
+  unsigned           head_;
+  unsigned          count_;
+  bool             closed_;
+  char             ring_[];
+};
+
+LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED, New, Channel::NewHandler, HPX_POINTER,
+              HPX_UINT, HPX_SIZE_T);
+LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED | HPX_MARSHALLED, Send,
+              Channel::SendHandler, HPX_POINTER, HPX_POINTER, HPX_SIZE_T);
+LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED, Recv, Channel::RecvHandler,
+              HPX_POINTER, HPX_INT, HPX_INT);
+LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED, Close, Channel::CloseHandler,
+              HPX_POINTER);
+}
+
+Channel::Channel(unsigned capacity, size_t size)
+    : LCO(LCO_CHANNEL),
+      notEmpty_(),
+      notFull_(),
+      ready_(),
+      capacity_(capacity),
+      size_(size),
+      head_(0),
+      count_(0),
+      closed_(false)
+{
+}
+
+hpx_status_t
+Channel::send(int n, const char* items)
+{
+  std::lock_guard<LCO> _(*this);
+  for (int i = 0; i < n; ++i) {
+    while (count_ == capacity_ && !closed_) {
+      if (auto status = waitFor(notFull_)) {
+        return status;
+      }
+    }
+
+    if (closed_) {
+      return HPX_LCO_ERROR;
+    }
+
+    memcpy(slot(head_ + count_), items + i * size_, size_);
+    if (count_++ == 0) {
+      ready_.signalAll();
+    }
+    notEmpty_.signal();                         // one wakeup per item
+  }
+  return HPX_SUCCESS;
+}
+
+hpx_status_t
+Channel::recv(int n, char* items, bool block, int& count)
+{
+  std::lock_guard<LCO> _(*this);
+  count = 0;
+  while (count_ == 0) {
+    if (!block || closed_) {
+      if (auto status = notEmpty_.getError()) {
+        return status;
+      }
+      return HPX_LCO_CHAN_EMPTY;
+    }
+    if (auto status = waitFor(notEmpty_)) {
+      return status;
+    }
+  }
+
+  count = (static_cast<unsigned>(n) < count_) ? n : count_;
+  for (int i = 0; i < count; ++i) {
+    memcpy(items + i * size_, slot(head_ + i), size_);
+  }
+  head_ = (head_ + count) % capacity_;
+  count_ -= count;
+
+  // Wake one sender per slot we freed, and pass the baton on to the next
+  // receiver if there are still items left over.
+  for (int i = 0; i < count; ++i) {
+    notFull_.signal();
+  }
+  if (count_) {
+    notEmpty_.signal();
+  }
+  return HPX_SUCCESS;
+}
+
+void
+Channel::close()
+{
+  std::lock_guard<LCO> _(*this);
+  closed_ = true;
+  notEmpty_.signalAll();
+  notFull_.signalAll();
+  ready_.signalAll();
+}
+
+hpx_status_t
+Channel::wait(int reset)
+{
+  std::lock_guard<LCO> _(*this);
+  while (count_ == 0 && !closed_) {
+    if (auto status = waitFor(ready_)) {
+      return status;
+    }
+  }
+  return (count_) ? HPX_SUCCESS : HPX_LCO_CHAN_EMPTY;
+}
+
+hpx_status_t
+Channel::attach(hpx_parcel_t *p)
+{
+  std::lock_guard<LCO> _(*this);
+  if (count_ == 0 && !closed_) {
+    return ready_.push(p);
+  }
+
+  if (hpx_status_t status = ready_.getError()) {
+    hpx_parcel_release(p);
+    return status;
+  }
+
+  hpx_parcel_send(p, HPX_NULL);
+  return HPX_SUCCESS;
+}
+
+void
+Channel::reset()
+{
+  std::lock_guard<LCO> _(*this);
+  notEmpty_.reset();
+  notFull_.reset();
+  ready_.reset();
+  head_ = 0;
+  count_ = 0;
+  closed_ = false;
+}
+
+int
+Channel::RecvHandler(Channel& lco, int n, int block)
+{
+  size_t bytes = sizeof(RecvReply) + n * lco.size_;
+  hpx_parcel_t *cont = hpx_thread_generate_continuation(NULL, bytes);
+  auto reply = static_cast<RecvReply*>(hpx_parcel_get_data(cont));
+  reply->status = lco.recv(n, reply->items, block, reply->count);
+  parcel_launch(cont);
+  return HPX_SUCCESS;
+}
+
+/// Receive up to @p n items from a channel, shared by all of the receive
+/// operations.
+static hpx_status_t
+_chan_recv(hpx_addr_t chan, int n, size_t size, void *values, int block,
+           int *count)
+{
+  dbg_assert(n > 0);
+  int scratch;
+  int& c = (count) ? *count : scratch;
+
+  Channel* lco = nullptr;
+  if (hpx_gas_try_pin(chan, (void**)&lco)) {
+    dbg_assert(size == lco->getSize());
+    auto status = lco->recv(n, static_cast<char*>(values), block, c);
+    hpx_gas_unpin(chan);
+    return status;
+  }
+
+  // The remote receive returns its items inline in a single reply parcel.
+  size_t bytes = sizeof(Channel::RecvReply) + n * size;
+  std::unique_ptr<char[]> buffer(new char[bytes]);
+  auto reply = reinterpret_cast<Channel::RecvReply*>(buffer.get());
+  dbg_check( hpx_call_sync(chan, Recv, reply, bytes, &n, &block) );
+  c = reply->count;
+  memcpy(values, reply->items, c * size);
+  return reply->status;
+}
+
+hpx_addr_t
+hpx_lco_chan_new(unsigned capacity, size_t size)
+{
+  dbg_assert(capacity > 0);
+  hpx_addr_t gva = HPX_NULL;
+  size_t bytes = capacity * size;
+  try {
+    Channel* lco = new(bytes, gva) Channel(capacity, size);
+    hpx_gas_unpin(gva);
+    LCO_LOG_NEW(gva, lco);
+  }
+  catch (const LCO::NonLocalMemory&) {
+    hpx_call_sync(gva, New, nullptr, 0, &capacity, &size);
+  }
+  return gva;
+}
+
+void
+hpx_lco_chan_send_n(hpx_addr_t chan, int n, size_t size, const void *values,
+                    hpx_addr_t lsync, hpx_addr_t rsync)
+{
+  dbg_assert(n > 0);
+  Channel* lco = nullptr;
+  if (hpx_gas_try_pin(chan, (void**)&lco)) {
+    dbg_assert(size == lco->getSize());
+    auto status = lco->send(n, static_cast<const char*>(values));
+    hpx_gas_unpin(chan);
+    hpx_lco_set(lsync, 0, NULL, HPX_NULL, HPX_NULL);
+    if (status) {
+      hpx_lco_error(rsync, status, HPX_NULL);
+    }
+    else {
+      hpx_lco_set(rsync, 0, NULL, HPX_NULL, HPX_NULL);
+    }
+    return;
+  }
+
+  // Coalesce all of the items into a single parcel.
+  size_t bytes = n * size;
+  hpx_parcel_t *p = action_new_parcel(Send,               // action
+                                      chan,               // target
+                                      rsync,              // continuation target
+                                      hpx_lco_set_action, // continuation action
+                                      2,                  // number of args
+                                      values,             // buffer
+                                      bytes);             // bytes
+  hpx_parcel_send(p, lsync);
+}
+
+void
+hpx_lco_chan_send(hpx_addr_t chan, size_t size, const void *value,
+                  hpx_addr_t lsync, hpx_addr_t rsync)
+{
+  hpx_lco_chan_send_n(chan, 1, size, value, lsync, rsync);
+}
+
+hpx_status_t
+hpx_lco_chan_send_sync(hpx_addr_t chan, size_t size, const void *value)
+{
+  Channel* lco = nullptr;
+  if (hpx_gas_try_pin(chan, (void**)&lco)) {
+    dbg_assert(size == lco->getSize());
+    auto status = lco->send(1, static_cast<const char*>(value));
+    hpx_gas_unpin(chan);
+    return status;
+  }
+
+  hpx_addr_t rsync = hpx_lco_future_new(0);
+  hpx_lco_chan_send_n(chan, 1, size, value, HPX_NULL, rsync);
+  hpx_status_t status = hpx_lco_wait(rsync);
+  hpx_lco_delete(rsync, HPX_NULL);
+  return status;
+}
+
+hpx_status_t
+hpx_lco_chan_recv(hpx_addr_t chan, size_t size, void *value)
+{
+  return _chan_recv(chan, 1, size, value, 1, nullptr);
+}
+
+hpx_status_t
+hpx_lco_chan_try_recv(hpx_addr_t chan, size_t size, void *value)
+{
+  return _chan_recv(chan, 1, size, value, 0, nullptr);
+}
+
+hpx_status_t
+hpx_lco_chan_recv_n(hpx_addr_t chan, int n, size_t size, void *values,
+                    int *count)
+{
+  return _chan_recv(chan, n, size, values, 1, count);
+}
+
+void
+hpx_lco_chan_close(hpx_addr_t chan, hpx_addr_t rsync)
+{
+  Channel* lco = nullptr;
+  if (hpx_gas_try_pin(chan, (void**)&lco)) {
+    lco->close();
+    hpx_gas_unpin(chan);
+    hpx_lco_set(rsync, 0, NULL, HPX_NULL, HPX_NULL);
+    return;
+  }
+
+  dbg_check( hpx_call(chan, Close, rsync) );
+}
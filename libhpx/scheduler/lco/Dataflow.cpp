@@ -17,12 +17,27 @@
 
 /// @file libhpx/scheduler/dataflow.c
 /// @brief A dataflow LCO.
+///
+/// Each node added to a dataflow LCO is a small heap record that counts its
+/// outstanding inputs. Rather than running a thread that blocks in
+/// hpx_lco_get_all(), the node attaches a fetch parcel to each of its inputs.
+/// When an input triggers the fetch runs at the input, and its reply copies the
+/// value into the node's buffer. The last reply spawns the user action. Pending
+/// nodes therefore cost only the bytes in their record.
+///
+/// The dataflow LCO itself counts the nodes that haven't run yet, and it is
+/// triggered whenever that count is zero.
 #include "LCO.h"
 #include "Condition.h"
 #include "libhpx/action.h"
 #include "libhpx/debug.h"
+#include "libhpx/parcel.h"
 #include "hpx/hpx.h"
+#include <atomic>
+#include <cstddef>
+#include <cstring>
 #include <mutex>
+#include <new>
 
 namespace {
 using libhpx::scheduler::Condition;
@@ -30,7 +45,8 @@ using libhpx::scheduler::LCO;
 
 class Dataflow final : public LCO {
  public:
-  Dataflow() : LCO(LCO_DATAFLOW), cvar_() {
+  Dataflow() : LCO(LCO_DATAFLOW), cvar_(), pending_(0) {
+    setTriggered();
   }
 
   ~Dataflow() {
@@ -39,15 +55,32 @@ class Dataflow final : public LCO {
 
   hpx_status_t get(size_t size, void *value, int reset);
   hpx_status_t attach(hpx_parcel_t *p);
+  hpx_parcel_t* detach(bool (*match)(const hpx_parcel_t*, const void*),
+                       const void* arg);
 
+  /// Record that a node has been added.
+  void add() {
+    std::lock_guard<LCO> _(*this);
+    if (pending_++ == 0) {
+      resetTriggered();
+    }
+  }
+
+  /// Record that a node has run.
   int set(size_t size, const void *value) {
-    // @todo: why doesn't this do anything at all?
     std::lock_guard<LCO> _(*this);
-    return HPX_SUCCESS;
+    dbg_assert(pending_ > 0);
+    if (--pending_) {
+      return 0;
+    }
+    setTriggered();
+    cvar_.signalAll();
+    return 1;
   }
 
   void error(hpx_status_t code) {
     std::lock_guard<LCO> _(*this);
+    setTriggered();
     cvar_.signalError(code);
   }
 
@@ -71,42 +104,110 @@ class Dataflow final : public LCO {
     auto lco = new(buffer) Dataflow();
     return HPX_THREAD_CONTINUE(lco);
   }
+
+  static int AddHandler(Dataflow& lco) {
+    lco.add();
+    return HPX_SUCCESS;
+  }
   /// @}
 
  private:
   void resetCondition() {
     log_lco("resetting dataflow LCO %p\n", this);
-    resetTriggered();
     cvar_.reset();
+    if (pending_) {
+      resetTriggered();
+    }
   }
 
   Condition cvar_;
+  unsigned pending_;
 };
 
-/// Class that manages the dataflow run operation.
-class RunOp {
+/// A dataflow node waiting for its inputs.
+///
+/// The node, its array of value pointers, and its value buffer are all
+/// allocated as one block.
+class Node {
  public:
-  static hpx_parcel_t* Create(hpx_addr_t lco, hpx_action_t action,
-                              hpx_addr_t out, int n, va_list& args);
+  static Node* Create(hpx_addr_t lco, hpx_action_t action, hpx_addr_t out,
+                      int n, va_list& args);
+
+  /// Attach a fetch parcel to each input.
+  void registerInputs();
+
+  /// Deliver the value of the @p i th input.
+  void deliver(int i, hpx_status_t status, const void *value, size_t bytes);
 
-  static int Handler(const RunOp& run, size_t) {
-    return run();
+  /// Run the user's action, and then release the node.
+  int operator()();
+
+  /// The reply from an input's fetch operation.
+  struct Reply {
+    Node*           node;
+    int                i;
+    hpx_status_t status;
+    char        value[];
+  };
+
+  /// Attach a fetch parcel for the @p i th input to the pinned @p input.
+  ///
+  /// @returns          HPX_SUCCESS, or the error if the input has already
+  ///                   failed, in which case the fetch will not run.
+  static hpx_status_t Attach(LCO& input, hpx_addr_t addr, Node* node, int i,
+                             size_t size, hpx_addr_t at);
+
+  static int RegisterHandler(LCO& input, Node* node, int i, size_t size,
+                             hpx_addr_t at);
+
+  static int FetchHandler(LCO& lco, Node* node, int i, size_t size);
+
+  static int DeliverHandler(const Reply& reply, size_t n) {
+    reply.node->deliver(reply.i, reply.status, reply.value,
+                        n - sizeof(reply));
+    return HPX_SUCCESS;
   }
 
- private:
-  void init(hpx_action_t action, int n, va_list& args);
-  int operator()() const;
+  static int RunHandler(Node* node) {
+    return (*node)();
+  }
 
-  size_t n_;
-  hpx_action_t action_;
+ private:
   struct Record {
-    size_t     size;
     hpx_addr_t addr;
-  } data_[];
+    size_t     size;
+  };
+
+  Node(hpx_addr_t lco, hpx_action_t action, hpx_addr_t out, int n);
+
+  /// Round value sizes up so that every value in the buffer is aligned.
+  static size_t Pad(size_t bytes) {
+    constexpr size_t align = alignof(std::max_align_t);
+    return (bytes + align - 1) & ~(align - 1);
+  }
+
+  /// Release the node's memory.
+  void destroy();
+
+  const hpx_addr_t       lco_;
+  const hpx_action_t  action_;
+  const hpx_addr_t       out_;
+  const int                n_;
+  std::atomic<int> remaining_;
+  std::atomic<hpx_status_t> status_;
+  void**              values_;
+  Record             inputs_[];
 };
 
 LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED, New, Dataflow::NewHandler, HPX_POINTER);
-LIBHPX_ACTION(HPX_DEFAULT, HPX_MARSHALLED, Run, RunOp::Handler, HPX_POINTER, HPX_SIZE_T);
+LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED, Add, Dataflow::AddHandler, HPX_POINTER);
+LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED, Register, Node::RegisterHandler,
+              HPX_POINTER, HPX_POINTER, HPX_INT, HPX_SIZE_T, HPX_ADDR);
+LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED, Fetch, Node::FetchHandler, HPX_POINTER,
+              HPX_POINTER, HPX_INT, HPX_SIZE_T);
+LIBHPX_ACTION(HPX_INTERRUPT, HPX_MARSHALLED, Deliver, Node::DeliverHandler,
+              HPX_POINTER, HPX_SIZE_T);
+LIBHPX_ACTION(HPX_DEFAULT, 0, Run, Node::RunHandler, HPX_POINTER);
 }
 
 hpx_status_t
@@ -123,16 +224,27 @@ Dataflow::attach(hpx_parcel_t *p) {
   return cvar_.push(p);
 }
 
+hpx_parcel_t*
+Dataflow::detach(bool (*match)(const hpx_parcel_t*, const void*),
+                 const void* arg) {
+  std::lock_guard<LCO> _(*this);
+  return cvar_.remove(match, arg);
+}
+
 /// Invoke a get operation on the dataflow LCO.
+///
+/// This waits until all of the nodes that have been added have run.
 hpx_status_t
 Dataflow::get(size_t size, void *out, int reset)
 {
   std::lock_guard<LCO> _(*this);
-  if (getTriggered()) {
-    return cvar_.getError();
+  while (!getTriggered()) {
+    if (hpx_status_t status = waitFor(cvar_)) {
+      return status;
+    }
   }
 
-  if (hpx_status_t status = waitFor(cvar_)) {
+  if (hpx_status_t status = cvar_.getError()) {
     return status;
   }
 
@@ -143,54 +255,167 @@ Dataflow::get(size_t size, void *out, int reset)
   return HPX_SUCCESS;
 }
 
+Node::Node(hpx_addr_t lco, hpx_action_t action, hpx_addr_t out, int n)
+    : lco_(lco),
+      action_(action),
+      out_(out),
+      n_(n),
+      remaining_(n),
+      status_(HPX_SUCCESS),
+      values_(nullptr)
+{
+}
+
+Node*
+Node::Create(hpx_addr_t lco, hpx_action_t action, hpx_addr_t out, int n,
+             va_list& args)
+{
+  // Read the inputs once to find out how much space we need for the buffer,
+  // and then again to initialize the node.
+  va_list copy;
+  va_copy(copy, args);
+  size_t bytes = 0;
+  for (int i = 0; i < n; ++i) {
+    va_arg(copy, hpx_addr_t);
+    bytes += Pad(va_arg(copy, size_t));
+  }
+  va_end(copy);
+
+  size_t records = sizeof(Node) + n * sizeof(Record);
+  size_t header = Pad(records + n * sizeof(void*));
+  void* block = ::operator new(header + bytes);
+  Node* node = new(block) Node(lco, action, out, n);
+  node->values_ = reinterpret_cast<void**>(static_cast<char*>(block) + records);
+
+  char* value = static_cast<char*>(block) + header;
+  for (int i = 0; i < n; ++i) {
+    node->inputs_[i].addr = va_arg(args, hpx_addr_t);
+    node->inputs_[i].size = va_arg(args, size_t);
+    node->values_[i] = value;
+    value += Pad(node->inputs_[i].size);
+  }
+  return node;
+}
+
 void
-RunOp::init(hpx_action_t action, int n, va_list& args)
+Node::destroy()
 {
-  action_ = action;
-  n_ = n;
+  this->~Node();
+  ::operator delete(this);
+}
+
+void
+Node::registerInputs()
+{
+  // We can't touch the node after the last registration because its reply may
+  // have already run it, so the loop bound is kept on the stack.
+  Node* node = this;
   for (int i = 0, e = n_; i < e; ++i) {
-    data_[i].addr = va_arg(args, hpx_addr_t);
-    data_[i].size = va_arg(args, size_t);
+    hpx_addr_t addr = inputs_[i].addr;
+    size_t size = inputs_[i].size;
+    dbg_assert(addr);
+
+    // Attach directly to the inputs, locally or at their localities, so that
+    // an error that has already been reported is delivered to us rather than
+    // dropping the fetch parcel.
+    hpx_addr_t here = HPX_HERE;
+    LCO* input = nullptr;
+    if (hpx_gas_try_pin(addr, (void**)&input)) {
+      hpx_status_t status = Attach(*input, addr, node, i, size, here);
+      hpx_gas_unpin(addr);
+      if (status) {
+        deliver(i, status, nullptr, 0);
+      }
+      continue;
+    }
+
+    dbg_check( hpx_call(addr, Register, HPX_NULL, &node, &i, &size, &here) );
   }
 }
 
+hpx_status_t
+Node::Attach(LCO& input, hpx_addr_t addr, Node* node, int i, size_t size,
+             hpx_addr_t at)
+{
+  hpx_parcel_t *p = action_new_parcel(Fetch, addr, at, Deliver, 3, &node, &i,
+                                      &size);
+  parcel_prepare(p);
+  return input.attach(p);
+}
+
+/// The remote half of registerInputs(), which reports an input that has
+/// already failed with a reply rather than through the action's status.
 int
-RunOp::operator()() const
+Node::RegisterHandler(LCO& input, Node* node, int i, size_t size,
+                      hpx_addr_t at)
 {
-  std::unique_ptr<hpx_addr_t[]> inputs(new hpx_addr_t[n_]);
-  std::unique_ptr<size_t[]> sizes(new size_t[n_]);
-  std::unique_ptr<void*[]> values(new void*[n_]);
+  hpx_addr_t addr = hpx_thread_current_target();
+  if (hpx_status_t status = Attach(input, addr, node, i, size, at)) {
+    Reply reply;
+    reply.node = node;
+    reply.i = i;
+    reply.status = status;
+    return hpx_call(at, Deliver, HPX_NULL, &reply, sizeof(reply));
+  }
+  return HPX_SUCCESS;
+}
 
-  for (unsigned i = 0; i < n_; ++i) {
-    sizes[i] = data_[i].size;
-    inputs[i] = data_[i].addr;
-    values[i] = new char[sizes[i]];
+/// The fetch runs at an input LCO once it has been triggered, so the get won't
+/// block, and it serializes the value directly into the reply parcel.
+int
+Node::FetchHandler(LCO& lco, Node* node, int i, size_t size)
+{
+  size_t bytes = sizeof(Reply) + size;
+  hpx_parcel_t *cont = hpx_thread_generate_continuation(NULL, bytes);
+  auto reply = static_cast<Reply*>(hpx_parcel_get_data(cont));
+  reply->node = node;
+  reply->i = i;
+  reply->status = (size) ? lco.get(size, reply->value, 0) : lco.wait(0);
+  parcel_launch(cont);
+  return HPX_SUCCESS;
+}
+
+void
+Node::deliver(int i, hpx_status_t status, const void *value, size_t bytes)
+{
+  if (status != HPX_SUCCESS) {
+    status_.store(status, std::memory_order_relaxed);
+  }
+  else if (bytes) {
+    dbg_assert(bytes == inputs_[i].size);
+    memcpy(values_[i], value, bytes);
   }
 
-  // fetch all of the inputs and run the handler
-  hpx_action_handler_t handler = hpx_action_get_handler(action_);
-  dbg_check(hpx_lco_get_all(n_, &inputs[0], &sizes[0], &values[0], nullptr));
-  return handler(&values[0], n_);
+  if (remaining_.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+    return;
+  }
+
+  // That was the last input, spawn the node's action. If any of the inputs
+  // failed then the run will forward the error to the output instead.
+  Node* node = this;
+  bool ok = (status_.load(std::memory_order_relaxed) == HPX_SUCCESS);
+  hpx_addr_t rsync = (ok) ? out_ : HPX_NULL;
+  hpx_action_t rop = (ok) ? hpx_lco_set_action : HPX_ACTION_NULL;
+  hpx_parcel_t *p = action_new_parcel(Run, HPX_HERE, rsync, rop, 1, &node);
+  parcel_launch(p);
 }
 
-hpx_parcel_t*
-RunOp::Create(hpx_addr_t lco, hpx_action_t action, hpx_addr_t out, int n,
-              va_list& vargs)
+int
+Node::operator()()
 {
-  dbg_assert(n > 0);
-  dbg_assert(~(n & 1));
-  size_t size = sizeof(RunOp) + n / 2 * sizeof(Record);
-  hpx_parcel_t *p = action_new_parcel(Run,                // action
-                                      out,                // target
-                                      out,                // continuation target
-                                      hpx_lco_set_action, // continuation action
-                                      2,                  // number of args
-                                      nullptr,            // marshalled buffer
-                                      size);              // buffer size
-
-  auto& args = *static_cast<RunOp*>(hpx_parcel_get_data(p));
-  args.init(action, n / 2, vargs);
-  return p;
+  int e = HPX_SUCCESS;
+  if (hpx_status_t status = status_.load(std::memory_order_relaxed)) {
+    // Forward the input's error to the output rather than running the action.
+    hpx_lco_error(out_, status, HPX_NULL);
+  }
+  else {
+    hpx_action_handler_t handler = hpx_action_get_handler(action_);
+    e = handler(values_, n_);
+  }
+
+  hpx_lco_set(lco_, 0, NULL, HPX_NULL, HPX_NULL);
+  destroy();
+  return e;
 }
 
 hpx_addr_t
@@ -213,10 +438,23 @@ int
 _hpx_lco_dataflow_add(hpx_addr_t lco, hpx_action_t action, hpx_addr_t out,
                       int n, ...)
 {
+  dbg_assert(n > 0);
+  dbg_assert(!(n & 1));
+
+  // Count the node before it can possibly run.
+  Dataflow* df = nullptr;
+  if (hpx_gas_try_pin(lco, (void**)&df)) {
+    df->add();
+    hpx_gas_unpin(lco);
+  }
+  else {
+    dbg_check( hpx_call_sync(lco, Add, nullptr, 0) );
+  }
+
   va_list vargs;
   va_start(vargs, n);
-  hpx_parcel_t* p = RunOp::Create(lco, action, out, n, vargs);
+  Node* node = Node::Create(lco, action, out, n / 2, vargs);
   va_end(vargs);
-  hpx_parcel_send(p, HPX_NULL);
+  node->registerInputs();
   return HPX_SUCCESS;
 }
@@ -46,6 +46,8 @@ class Future final : public LCO
   hpx_status_t getRef(size_t size, void **out, int *unpin);
   bool release(void *out);
   hpx_status_t attach(hpx_parcel_t *p);
+  hpx_parcel_t* detach(bool (*match)(const hpx_parcel_t*, const void*),
+                       const void* arg);
 
   void error(hpx_status_t code) {
     std::lock_guard<LCO> _(*this);
@@ -220,6 +222,14 @@ Future::attach(hpx_parcel_t *p)
   return HPX_SUCCESS;
 }
 
+hpx_parcel_t*
+Future::detach(bool (*match)(const hpx_parcel_t*, const void*),
+               const void* arg)
+{
+  std::lock_guard<LCO> _(*this);
+  return full_.remove(match, arg);
+}
+
 int
 Future::NewBlockHandler(char* blocks, unsigned n, size_t size)
 {
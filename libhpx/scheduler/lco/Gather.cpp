@@ -14,6 +14,10 @@
 /// Given a set of buffers distributed across processes, gather will
 /// collect all of the elements to.
 ///
+/// Readers may take a reference to the gathered buffer with hpx_lco_getref(),
+/// which avoids copying the whole gathered array out of the LCO. Remote
+/// readers are served by the network directly from the LCO's buffer.
+///
 
 #ifdef HAVE_CONFIG_H
 # include "config.h"
@@ -41,6 +45,8 @@ class Gather final : public LCO {
 
   hpx_status_t get(size_t size, void *value, int reset);
   hpx_status_t attach(hpx_parcel_t *p);
+  hpx_parcel_t* detach(bool (*match)(const hpx_parcel_t*, const void*),
+                       const void* arg);
   hpx_status_t setId(unsigned offset, size_t size, const void* buffer);
 
   int set(size_t size, const void *value) {
@@ -53,16 +59,8 @@ class Gather final : public LCO {
     cvar_.signalError(code);
   }
 
-  hpx_status_t getRef(size_t size, void **out, int *unpin) {
-    *out = registered_malloc(size);             // clone the buffer because
-    *unpin = 1;                                 // it is reset between rounds
-    return get(size, *out, 0);
-  }
-
-  bool release(void *out) {
-    registered_free(out);                       // free the clone
-    return 0;
-  }
+  hpx_status_t getRef(size_t size, void **out, int *unpin);
+  bool release(void *out);
 
   hpx_status_t wait(int reset) {
     return get(0, NULL, reset);
@@ -95,6 +93,13 @@ class Gather final : public LCO {
   /// @}
 
  private:
+  /// Wait for the gathering phase to complete.
+  hpx_status_t waitForReading();
+
+  /// Record that a reader is done with the value, and switch back to the
+  /// gathering phase if it was the last one.
+  void finishReading();
+
   Condition           cvar_;
   const unsigned   writers_;
   const unsigned   readers_;
@@ -141,25 +146,28 @@ Gather::attach(hpx_parcel_t *p)
   return HPX_SUCCESS;
 }
 
-/// Get the value of the gather LCO. This operation will wait if the
-/// writers have not finished gathering.
-hpx_status_t
-Gather::get(size_t size, void *out, int reset)
+hpx_parcel_t*
+Gather::detach(bool (*match)(const hpx_parcel_t*, const void*),
+               const void* arg)
 {
   std::lock_guard<LCO> _(*this);
+  return cvar_.remove(match, arg);
+}
 
-  // Wait until we're reading, and watch for errors.
+hpx_status_t
+Gather::waitForReading()
+{
   while (wcount_ < writers_) {
     if (auto status = waitFor(cvar_)) {
       return status;
     }
   }
+  return HPX_SUCCESS;
+}
 
-  // We're in a reading phase, and if the user wants the data, copy it out.
-  if (size && out) {
-    memcpy(out, value_, size);
-  }
-
+void
+Gather::finishReading()
+{
   // Update the count, if I'm the last reader to arrive, switch the mode and
   // release all of the other readers, otherwise wait for the phase to change
   // back to gathering---this blocking behavior prevents gets from one "epoch"
@@ -168,10 +176,62 @@ Gather::get(size_t size, void *out, int reset)
     wcount_ = 0;
     cvar_.signalAll();
   }
+}
+
+/// Get the value of the gather LCO. This operation will wait if the
+/// writers have not finished gathering.
+hpx_status_t
+Gather::get(size_t size, void *out, int reset)
+{
+  std::lock_guard<LCO> _(*this);
+
+  // Wait until we're reading, and watch for errors.
+  if (auto status = waitForReading()) {
+    return status;
+  }
 
+  // We're in a reading phase, and if the user wants the data, copy it out.
+  if (size && out) {
+    memcpy(out, value_, size);
+  }
+
+  finishReading();
   return HPX_SUCCESS;
 }
 
+/// Returns a reference to the gathered value, waiting if the writers have not
+/// finished gathering.
+///
+/// The reference points directly at the LCO's buffer, so we don't count the
+/// read until the reference is released. Writers can't start the next round
+/// until then, which keeps the buffer stable while it is being read, and lets
+/// the network reply to a remote get straight from the buffer.
+hpx_status_t
+Gather::getRef(size_t size, void **out, int *unpin)
+{
+  dbg_assert(size && out);
+
+  std::lock_guard<LCO> _(*this);
+  if (auto status = waitForReading()) {
+    return status;
+  }
+
+  *out = value_;
+  *unpin = 0;
+  return HPX_SUCCESS;
+}
+
+/// Release a reference to the gathered value, and return true to indicate that
+/// the caller should unpin the LCO that we left pinned in getRef().
+bool
+Gather::release(void *out)
+{
+  dbg_assert(out && out == value_);
+  std::lock_guard<LCO> _(*this);
+  finishReading();
+  return true;
+}
+
 // Local set id function.
 hpx_status_t
 Gather::setId(unsigned offset, size_t size, const void* buffer)
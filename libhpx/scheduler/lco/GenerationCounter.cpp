@@ -16,13 +16,21 @@
 #endif
 
 /// @file libhpx/scheduler/sema.c
-/// @brief Implements the semaphore LCO.
+/// @brief Implements the generation counter LCO.
+///
+/// Threads waiting for a generation within @p ninplace of the current count
+/// wait on the in-place condition for that generation. Threads waiting further
+/// ahead are kept in a min-heap ordered by generation, so an increment wakes
+/// exactly the threads whose generation has arrived instead of broadcasting to
+/// every far-ahead waiter. Heap nodes live on the waiting threads' own stacks,
+/// so the LCO stays a fixed size no matter how many generations are waited for.
 
 #include "LCO.h"
 #include "Condition.h"
 #include "libhpx/action.h"
 #include "libhpx/debug.h"
 #include "libhpx/memory.h"
+#include <algorithm>
 #include <mutex>
 #include <cstring>
 
@@ -35,16 +43,18 @@ struct GenerationCounter final : public LCO {
   GenerationCounter(unsigned ninplace);
   ~GenerationCounter();
 
-  /// Wait for the specified generation.
+  /// Wait for the specified generation, or any later one.
   hpx_status_t waitForGeneration(unsigned long i);
 
+  /// Increment the counter, by the unsigned long @p value if it is provided.
   int set(size_t size, const void *value) {
-    std::lock_guard<LCO> _(*this);
-    unsigned long i = ++gen_;
-    oflow_.signalAll();
-    if (ninplace_) {
-      conditionAt(i % ninplace_).signalAll();
+    unsigned long n = 1;
+    if (size) {
+      dbg_assert(size == sizeof(n));
+      memcpy(&n, value, sizeof(n));
     }
+    std::lock_guard<LCO> _(*this);
+    increment(n);
     return 1;
   }
 
@@ -53,7 +63,10 @@ struct GenerationCounter final : public LCO {
     for (unsigned i = 0, e = ninplace_; i < e; ++i) {
       conditionAt(i).signalError(code);
     }
-    oflow_.signalError(code);
+    while (Waiter* w = pop()) {
+      w->cond.signalError(code);
+    }
+    next_.signalError(code);
   }
 
   hpx_status_t get(size_t size, void *out, int reset) {
@@ -68,20 +81,21 @@ struct GenerationCounter final : public LCO {
 
   hpx_status_t wait(int reset) {
     std::lock_guard<LCO> _(*this);
-    return waitFor(oflow_);
+    return waitFor(next_);
   }
 
   hpx_status_t attach(hpx_parcel_t *p) {
     std::lock_guard<LCO> _(*this);
-    return oflow_.push(p);
+    return next_.push(p);
   }
 
   void reset() {
     std::lock_guard<LCO> _(*this);
+    dbg_assert(!heap_);
     for (unsigned i = 0, e = ninplace_; i < e; ++i) {
       conditionAt(i).reset();
     }
-    oflow_.reset();
+    next_.reset();
   }
 
   size_t size(size_t size) const {
@@ -95,6 +109,15 @@ struct GenerationCounter final : public LCO {
     return lco.waitForGeneration(i);
   }
 
+  static int WaitForGenerationGetHandler(GenerationCounter& lco,
+                                         unsigned long i) {
+    if (auto status = lco.waitForGeneration(i)) {
+      return status;
+    }
+    unsigned long gen = lco.gen_;
+    return HPX_THREAD_CONTINUE(gen);
+  }
+
   static int NewHandler(void* buffer, unsigned ninplace) {
     auto lco = new(buffer) GenerationCounter(ninplace);
     return HPX_THREAD_CONTINUE(lco);
@@ -102,11 +125,43 @@ struct GenerationCounter final : public LCO {
   /// @}
 
  private:
+  /// A node in the heap of far-ahead waiters.
+  ///
+  /// The heap is a skew heap, which needs no balance information and merges
+  /// iteratively, so it's cheap to maintain with nodes that are allocated on
+  /// the stacks of the waiting threads.
+  struct Waiter {
+    Waiter(unsigned long i) : gen(i), left(nullptr), right(nullptr), cond() {
+    }
+
+    const unsigned long gen;
+    Waiter            *left;
+    Waiter           *right;
+    Condition          cond;
+  };
+
   Condition& conditionAt(size_t i) {
     return *reinterpret_cast<Condition*>(inplace_ + i * sizeof(Condition));
   }
 
-  Condition            oflow_;
+  /// Advance the counter, and wake the threads waiting for the generations
+  /// that it passes.
+  void increment(unsigned long n);
+
+  /// Merge two skew heaps.
+  static Waiter* merge(Waiter* a, Waiter* b);
+
+  /// Remove the waiter with the smallest generation from the heap.
+  Waiter* pop() {
+    Waiter* w = heap_;
+    if (w) {
+      heap_ = merge(w->left, w->right);
+    }
+    return w;
+  }
+
+  Condition             next_;          // signaled on every increment
+  Waiter               *heap_;          // waiters beyond the in-place window
   volatile unsigned long gen_;
   const unsigned    ninplace_;
   char               inplace_[];
@@ -117,10 +172,15 @@ LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED, New, GenerationCounter::NewHandler,
 LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED, WaitForGeneration,
               GenerationCounter::WaitForGenerationHandler, HPX_POINTER,
               HPX_ULONG);
+LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED, WaitForGenerationGet,
+              GenerationCounter::WaitForGenerationGetHandler, HPX_POINTER,
+              HPX_ULONG);
 }
 
 GenerationCounter::GenerationCounter(unsigned ninplace)
     : LCO(LCO_GENCOUNT),
+      next_(),
+      heap_(nullptr),
       gen_(),
       ninplace_(ninplace),
       inplace_()
@@ -133,23 +193,77 @@ GenerationCounter::GenerationCounter(unsigned ninplace)
 GenerationCounter::~GenerationCounter()
 {
   lock();
+  dbg_assert(!heap_);
   for (unsigned i = 0, e = ninplace_; i < e; ++i) {
     conditionAt(i).~Condition();
   }
 }
 
+GenerationCounter::Waiter*
+GenerationCounter::merge(Waiter* a, Waiter* b)
+{
+  Waiter* root = nullptr;
+  Waiter** link = &root;
+  while (a && b) {
+    if (b->gen < a->gen) {
+      std::swap(a, b);
+    }
+    // a is the smaller root, swap its children and merge b into its old right
+    // subtree, which is now on its left
+    *link = a;
+    std::swap(a->left, a->right);
+    link = &a->left;
+    a = *link;
+  }
+  *link = (a) ? a : b;
+  return root;
+}
+
+void
+GenerationCounter::increment(unsigned long n)
+{
+  unsigned long prev = gen_;
+  unsigned long gen = prev + n;
+  gen_ = gen;
+  next_.signalAll();
+
+  // wake the in-place waiters for each generation we passed, each slot only
+  // needs to be signaled once
+  for (unsigned long i = prev + 1, e = std::min(gen, prev + ninplace_);
+       i <= e; ++i) {
+    conditionAt(i % ninplace_).signalAll();
+  }
+
+  // wake the far-ahead waiters whose generation has arrived
+  while (heap_ && heap_->gen <= gen) {
+    pop()->cond.signalAll();
+  }
+}
+
 hpx_status_t
 GenerationCounter::waitForGeneration(unsigned long i)
 {
   std::lock_guard<LCO> _(*this);
   while (gen_ < i) {
-    bool inplace = i < (gen_ + ninplace_);
-    Condition& cond = (inplace) ? conditionAt(i % ninplace_) : oflow_;
-    if (auto status = waitFor(cond)) {
+    if (auto status = next_.getError()) {
+      return status;
+    }
+
+    if (i < gen_ + ninplace_) {
+      if (auto status = waitFor(conditionAt(i % ninplace_))) {
+        return status;
+      }
+      continue;
+    }
+
+    // the waiter is removed from the heap before we are woken
+    Waiter w(i);
+    heap_ = merge(heap_, &w);
+    if (auto status = waitFor(w.cond)) {
       return status;
     }
   }
-  return oflow_.getError();
+  return next_.getError();
 }
 
 hpx_addr_t
@@ -174,6 +288,12 @@ hpx_lco_gencount_inc(hpx_addr_t gencnt, hpx_addr_t rsync)
   hpx_lco_set(gencnt, 0, NULL, HPX_NULL, rsync);
 }
 
+void
+hpx_lco_gencount_inc_by(hpx_addr_t gencnt, unsigned long n, hpx_addr_t rsync)
+{
+  hpx_lco_set(gencnt, sizeof(n), &n, HPX_NULL, rsync);
+}
+
 
 hpx_status_t
 hpx_lco_gencount_wait(hpx_addr_t gva, unsigned long i)
@@ -186,3 +306,24 @@ hpx_lco_gencount_wait(hpx_addr_t gva, unsigned long i)
   }
   return hpx_call_sync(gva, WaitForGeneration, NULL, 0, &i);
 }
+
+hpx_status_t
+hpx_lco_gencount_wait_get(hpx_addr_t gva, unsigned long i, unsigned long *gen)
+{
+  GenerationCounter *lva = nullptr;
+  if (hpx_gas_try_pin(gva, (void**)&lva)) {
+    hpx_status_t status = lva->waitForGeneration(i);
+    if (gen) {
+      lva->get(sizeof(*gen), gen, 0);
+    }
+    hpx_gas_unpin(gva);
+    return status;
+  }
+  unsigned long current;
+  hpx_status_t status = hpx_call_sync(gva, WaitForGenerationGet, &current,
+                                      sizeof(current), &i);
+  if (gen && status == HPX_SUCCESS) {
+    *gen = current;
+  }
+  return status;
+}
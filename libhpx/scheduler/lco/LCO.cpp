@@ -18,6 +18,7 @@
 /// @file libhpx/scheduler/lco.cpp
 
 #include "LCO.h"
+#include "Condition.h"
 #include "Thread.h"                             //<! struct ustack
 #include "libhpx/action.h"
 #include "libhpx/attach.h"
@@ -27,20 +28,57 @@
 #include "libhpx/Network.h"
 #include "libhpx/Worker.h"
 #include "libhpx/parcel.h"
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <vector>
 
 namespace {
+using libhpx::scheduler::Condition;
 using libhpx::scheduler::LCO;
 }
 
 static constexpr short TRIGGERED_MASK = (0x2);
 static constexpr short      USER_MASK = (0x4);
+static constexpr short      POOL_MASK = (0x38);
+static constexpr int       POOL_SHIFT = 3;
+
+/// The per-worker LCO block pool.
+///
+/// Local LCO allocations are binned into power-of-two size classes starting at
+/// POOL_MIN_BYTES. The class of a block is kept in the LCO's state bits
+/// (offset by one so that 0 means unpooled), and deleted LCOs push their block
+/// onto the deleting worker's pool rather than freeing it. Pooled blocks are
+/// simply abandoned when the runtime shuts down, along with the global heap.
+namespace {
+constexpr int      POOL_CLASSES = 4;
+constexpr int        POOL_DEPTH = 64;
+constexpr size_t POOL_MIN_BYTES = 64;
+
+struct BlockPool {
+  hpx_addr_t blocks[POOL_CLASSES][POOL_DEPTH];
+  int             n[POOL_CLASSES];
+};
+}
+
+static __thread BlockPool _pool;
+
+/// Find the pool size class for an allocation, or -1 if it is too large.
+static int
+_pool_class(size_t bytes)
+{
+  size_t limit = POOL_MIN_BYTES;
+  for (int i = 0; i < POOL_CLASSES; ++i, limit <<= 1) {
+    if (bytes <= limit) {
+      return i;
+    }
+  }
+  return -1;
+}
 
 static LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED, _lco_size,
                      LCO::SizeHandler, HPX_POINTER, HPX_SIZE_T);
-static LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED, _lco_get, LCO::GetHandler,
-                     HPX_POINTER, HPX_INT);
-static LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED, _lco_wait, LCO::WaitHandler,
-                     HPX_POINTER, HPX_INT);
 
 LIBHPX_ACTION(HPX_INTERRUPT, HPX_PINNED, hpx_lco_delete_action,
               LCO::DeleteHandler, HPX_POINTER);
@@ -73,23 +111,52 @@ LCO::operator new(size_t, void * ptr)
 void*
 LCO::operator new(size_t bytes, hpx_addr_t& gva)
 {
-  if ((gva = lco_alloc_local(1, bytes, 0))) {
-    return TryPin(gva);
-  }
-  else {
-    throw std::bad_alloc();
-  }
+  return operator new(bytes, size_t(0), gva);
 }
 
 void*
 LCO::operator new(size_t size, size_t bytes, hpx_addr_t& gva)
 {
-  if ((gva = lco_alloc_local(1, size + bytes, 0))) {
-    return TryPin(gva);
+  int c = _pool_class(size + bytes);
+  if (c < 0) {
+    gva = lco_alloc_local(1, size + bytes, 0);
+  }
+  else if (_pool.n[c]) {
+    gva = _pool.blocks[c][--_pool.n[c]];
   }
   else {
+    gva = lco_alloc_local(1, POOL_MIN_BYTES << c, 0);
+  }
+
+  if (!gva) {
     throw std::bad_alloc();
   }
+
+  // Release the block if pinning it fails unexpectedly, so that we leak
+  // neither the block nor a pool class meant for the next constructor. A
+  // NonLocalMemory exception tells the caller to construct the LCO remotely in
+  // this block, so it propagates with the block still allocated.
+  struct Guard {
+    hpx_addr_t gva;
+    ~Guard() {
+      if (gva) {
+        PoolClassPassthrough_ = 0;
+        hpx_gas_free(gva, HPX_NULL);
+      }
+    }
+  } guard = { gva };
+
+  void* lva = nullptr;
+  try {
+    lva = TryPin(gva);
+  }
+  catch (const NonLocalMemory&) {
+    guard.gva = HPX_NULL;
+    throw;
+  }
+  guard.gva = HPX_NULL;
+  PoolClassPassthrough_ = (c < 0) ? 0 : short((c + 1) << POOL_SHIFT);
+  return lva;
 }
 
 void
@@ -99,8 +166,14 @@ LCO::operator delete(void* obj)
 }
 
 
-LCO::LCO(enum Type type) : lock_(), state_(), type_(type)
+__thread short LCO::PoolClassPassthrough_;
+
+LCO::LCO(enum Type type)
+    : lock_(),
+      state_(PoolClassPassthrough_),
+      type_(type)
 {
+  PoolClassPassthrough_ = 0;
   trace_append(HPX_TRACE_LCO, TRACE_EVENT_LCO_INIT, this, state_);
 }
 
@@ -141,6 +214,12 @@ LCO::release(void *out)
   return true;                                     // unpin the LCO
 }
 
+hpx_parcel_t*
+LCO::detach(bool (*)(const hpx_parcel_t*, const void*), const void*)
+{
+  return nullptr;
+}
+
 /// Action LCO event handler wrappers.
 ///
 /// These try and pin the LCO, and then forward to the local event handler
@@ -151,8 +230,10 @@ LCO::release(void *out)
 int
 LCO::DeleteHandler(LCO *lco)
 {
-  lco->~LCO();
   hpx_addr_t target = hpx_thread_current_target();
+  if (Recycle(target, lco)) {
+    return HPX_SUCCESS;
+  }
   return hpx_call_cc(target, hpx_gas_free_action);
 }
 
@@ -172,40 +253,28 @@ LCO::ErrorHandler(LCO *lco, void *args, size_t n)
 }
 
 int
-LCO::ResetHandler(LCO *lco)
+LCO::ContinueError(hpx_status_t status)
 {
-  lco->reset();
+  // *take* the current continuation
+  hpx_parcel_t *p = self->getCurrentParcel();
+  hpx_addr_t target = p->c_target;
+  p->c_target = HPX_NULL;
+  p->c_action = HPX_ACTION_NULL;
+  hpx_lco_error(target, status, HPX_NULL);
   return HPX_SUCCESS;
 }
 
 int
-LCO::SizeHandler(const LCO *lco, int arg)
-{
-  return lco->size(arg);
-}
-
-int
-LCO::GetHandler(LCO *lco, int n)
+LCO::ResetHandler(LCO *lco)
 {
-  dbg_assert(n > 0);
-
-  // Use the getref handler, no need to worry about pinning here because we
-  // _release() in the continuation.
-  void *buffer;
-  int ignore_unpin;
-  hpx_status_t status = lco->getRef(n, &buffer, &ignore_unpin);
-  if (status != HPX_SUCCESS) {
-    return status;
-  }
-  int e = hpx_thread_continue(buffer, n);
-  lco->release(buffer);
-  return e;
+  lco->reset();
+  return HPX_SUCCESS;
 }
 
 int
-LCO::WaitHandler(LCO *lco, int reset)
+LCO::SizeHandler(const LCO *lco, int arg)
 {
-  return lco->wait(reset);
+  return lco->size(arg);
 }
 
 int
@@ -215,7 +284,7 @@ LCO::AttachHandler(LCO *lco, hpx_parcel_t *p, size_t size)
   dbg_assert(hpx_parcel_get_data(parent) == p);
   log_lco("pinning %p, nesting %p\n", (void*)parent, (void*)p);
   parcel_pin(parent);
-  parcel_nest(p);
+  parcel_nest(parent, p);
   return lco->attach(p);
 }
 
@@ -247,6 +316,13 @@ LCO::unlock()
   unlock(self->getCurrentParcel());
 }
 
+bool
+LCO::isTriggerable() const
+{
+  return (type_ != LCO_SEMA && type_ != LCO_GENCOUNT && type_ != LCO_CHANNEL &&
+          type_ != LCO_RWLOCK);
+}
+
 short
 LCO::setTriggered()
 {
@@ -280,6 +356,18 @@ LCO::getUser() const
   return (state_ & USER_MASK);
 }
 
+bool
+LCO::Recycle(hpx_addr_t gva, LCO* lco)
+{
+  int c = ((lco->state_ & POOL_MASK) >> POOL_SHIFT) - 1;
+  lco->~LCO();
+  if (c < 0 || _pool.n[c] == POOL_DEPTH) {
+    return false;
+  }
+  _pool.blocks[c][_pool.n[c]++] = gva;
+  return true;
+}
+
 hpx_status_t
 LCO::waitFor(Condition& cond)
 {
@@ -296,9 +384,11 @@ hpx_lco_delete(hpx_addr_t target, hpx_addr_t rsync)
   }
   else {
     log_lco("deleting lco %" PRIu64 " (%p)\n", target, (void*)lco);
-    lco->~LCO();
+    bool recycled = LCO::Recycle(target, lco);
     hpx_gas_unpin(target);
-    hpx_gas_free(target, HPX_NULL);
+    if (!recycled) {
+      hpx_gas_free(target, HPX_NULL);
+    }
     hpx_lco_error(rsync, HPX_SUCCESS, HPX_NULL);
   }
 }
@@ -484,8 +574,7 @@ hpx_lco_wait(hpx_addr_t target)
     return status;
   }
 
-  int zero = 0;
-  return hpx_call_sync(target, _lco_wait, NULL, 0, &zero);
+  return here->net->wait(target, 0);
 }
 
 hpx_status_t
@@ -498,8 +587,7 @@ hpx_lco_wait_reset(hpx_addr_t target)
     return status;
   }
 
-  int one = 0;
-  return hpx_call_sync(target, _lco_wait, NULL, 0, &one);
+  return here->net->wait(target, 1);
 }
 
 size_t
@@ -589,139 +677,786 @@ hpx_lco_release(hpx_addr_t target, void *out)
   hpx_gas_unpin(target);
 }
 
-int
-hpx_lco_wait_all(int n, hpx_addr_t lcos[], hpx_status_t statuses[])
+namespace {
+/// A counting waiter for the hpx_lco_*_all operations.
+///
+/// The waiter is a purely local LCO that never lives in the global address
+/// space. It is registered with each input LCO, either by attaching a signal
+/// parcel to a local LCO or by sending a single request parcel to a remote
+/// LCO, and it triggers once @p count of those inputs have signaled. This lets
+/// the calling thread suspend exactly once, no matter how many LCOs it is
+/// waiting for. Every signal must arrive before the caller can resume, so the
+/// waiter lives on the caller's stack.
+class Waiter final : public LCO {
+ public:
+  Waiter(int count, void *values[], hpx_status_t statuses[]);
+
+  ~Waiter() {
+    lock();                                     // released in ~LCO()
+  }
+
+  /// Account for a registration before it is made.
+  void addInput() {
+    std::lock_guard<LCO> _(*this);
+    ++count_;
+  }
+
+  /// Record that input @p i is ready.
+  ///
+  /// If @p bytes is non-zero then @p value is copied into the output buffer
+  /// for input @p i.
+  void signal(int i, hpx_status_t status, const void *value, size_t bytes);
+
+  /// Release the extra input that keeps the waiter from triggering while it
+  /// is being registered.
+  void arm();
+
+  int set(size_t size, const void *value) {
+    dbg_error("the multi-LCO waiter can only be signaled internally\n");
+  }
+
+  void error(hpx_status_t code) {
+    std::lock_guard<LCO> _(*this);
+    setTriggered();
+    cond_.signalError(code);
+  }
+
+  hpx_status_t get(size_t size, void *value, int reset) {
+    dbg_assert(!size && !value);
+    return wait(reset);
+  }
+
+  hpx_status_t wait(int reset) {
+    std::lock_guard<LCO> _(*this);
+    return (getTriggered()) ? cond_.getError() : waitFor(cond_);
+  }
+
+  hpx_status_t attach(hpx_parcel_t *p) {
+    dbg_error("cannot attach to the multi-LCO waiter\n");
+  }
+
+  void reset() {
+    dbg_error("cannot reset the multi-LCO waiter\n");
+  }
+
+  size_t size(size_t) const {
+    return sizeof(Waiter);
+  }
+
+ private:
+  Condition               cond_;                //!< the waiting thread
+  int                    count_;                //!< the outstanding inputs
+  void**                values_;                //!< output buffers (or null)
+  hpx_status_t*       statuses_;                //!< output statuses (or null)
+};
+
+/// The reply from a remote LCO to the multi-LCO request action.
+struct MultiReply {
+  Waiter*         waiter;
+  int                  i;
+  hpx_status_t    status;
+  char           value[];
+};
+
+/// A waiter for the hpx_lco_*_any operations.
+///
+/// Like the Waiter, this registers with each of its inputs, but it triggers on
+/// the first signal, so the other registrations outlive the call. They are
+/// detached once the waiter triggers, so registrations are tracked to know
+/// which ones are left over. A registration attaches a parcel to its LCO, to a
+/// local LCO directly and to a remote LCO through a request that acknowledges
+/// the attach. The waiter doesn't trigger until every request has been
+/// acknowledged, so the caller can detach all of the losers before it returns.
+///
+/// Signals can arrive after the caller has returned, so the waiter is
+/// allocated from the heap and reference counted by the registrations that
+/// may still signal it.
+class AnyWaiter final : public LCO {
+ public:
+  AnyWaiter(int n, void *values[]);
+
+  ~AnyWaiter() {
+    lock();                                     // released in ~LCO()
+  }
+
+  static AnyWaiter* New(int n, void *values[]) {
+    void *buffer = ::operator new(sizeof(AnyWaiter));
+    return new(buffer) AnyWaiter(n, values);
+  }
+
+  /// Add a reference for a registration that may signal the waiter.
+  void addRef() {
+    refs_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// Drop a reference, deleting the waiter with the last one.
+  void drop() {
+    if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      this->~AnyWaiter();
+      ::operator delete(this);
+    }
+  }
+
+  /// Account for a remote registration that will be acknowledged.
+  void expect() {
+    std::lock_guard<LCO> _(*this);
+    ++pending_;
+  }
+
+  /// Record that the @p i th input is attached.
+  void attached(int i) {
+    std::lock_guard<LCO> _(*this);
+    attached_[i] = true;
+  }
+
+  /// Record that an input doesn't support waiting for any.
+  void unsupported();
+
+  /// Acknowledge a remote registration.
+  ///
+  /// @returns          True if the registration's reference should be
+  ///                   dropped because the registration failed.
+  bool ack(int i, hpx_status_t status, bool supported);
+
+  /// Record that input @p i is ready, and drop the registration's reference.
+  ///
+  /// If @p bytes is non-zero then @p value is copied into the output buffer
+  /// for input @p i, unless the waiter has already picked its first input.
+  static void Signal(AnyWaiter* w, int i, hpx_status_t status,
+                     const void *value, size_t bytes) {
+    w->signal(i, status, value, bytes);
+    w->drop();
+  }
+
+  /// Release the extra acknowledgment that keeps the waiter from triggering
+  /// while it is being registered.
+  void arm();
+
+  /// Detach the registrations that didn't trigger the waiter.
+  void detachLosers(const hpx_addr_t lcos[]);
+
+  /// Get the first input to signal, or -1 if an input wasn't supported.
+  int getFirst() const {
+    return (unsupported_) ? -1 : first_;
+  }
+
+  hpx_status_t getStatus() const {
+    return (unsupported_) ? HPX_ERROR : status_;
+  }
+
+  int set(size_t size, const void *value) {
+    dbg_error("the multi-LCO waiter can only be signaled internally\n");
+  }
+
+  void error(hpx_status_t code) {
+    dbg_error("the multi-LCO waiter can only be signaled internally\n");
+  }
+
+  hpx_status_t get(size_t size, void *value, int reset) {
+    dbg_assert(!size && !value);
+    return wait(reset);
+  }
+
+  hpx_status_t wait(int reset) {
+    std::lock_guard<LCO> _(*this);
+    return (getTriggered()) ? cond_.getError() : waitFor(cond_);
+  }
+
+  hpx_status_t attach(hpx_parcel_t *p) {
+    dbg_error("cannot attach to the multi-LCO waiter\n");
+  }
+
+  void reset() {
+    dbg_error("cannot reset the multi-LCO waiter\n");
+  }
+
+  size_t size(size_t) const {
+    return sizeof(AnyWaiter);
+  }
+
+ private:
+  void signal(int i, hpx_status_t status, const void *value, size_t bytes);
+
+  /// Trigger if we have an answer and every registration has been
+  /// acknowledged, the caller must hold the lock.
+  void tryTrigger();
+
+  Condition               cond_;                //!< the waiting thread
+  int                        n_;                //!< the number of inputs
+  int                  pending_;                //!< the outstanding acks
+  int                    first_;                //!< the first input to signal
+  hpx_status_t          status_;                //!< the first input's status
+  bool             unsupported_;                //!< saw an unsupported input
+  void**                values_;                //!< output buffers (or null)
+  std::unique_ptr<bool[]> attached_;            //!< the attached inputs
+  std::atomic<int>        refs_;                //!< outstanding references
+};
+
+/// Identifies a registration with an any-waiter.
+///
+/// Every parcel that an any-waiter attaches to an LCO starts with its key, so
+/// that a losing registration can be found again and detached.
+struct AnyKey {
+  AnyWaiter*      waiter;
+  int                  i;
+};
+
+/// The request to register with a remote LCO, which is also the data for the
+/// probe parcel that it attaches, and for the request to detach it.
+struct AnyProbe {
+  AnyKey             key;
+  size_t            size;                       //!< the value size
+  hpx_addr_t          at;                       //!< the waiter's locality
+};
+
+/// The acknowledgment of a remote registration.
+struct AnyAck {
+  AnyKey             key;
+  hpx_status_t    status;                       //!< the attach status
+  int          supported;                       //!< was the LCO triggerable
+};
+
+/// The reply from a remote probe, carrying the value if there is one.
+struct AnyReply {
+  AnyKey             key;
+  hpx_status_t    status;
+  char           value[];
+};
+}
+
+Waiter::Waiter(int count, void *values[], hpx_status_t statuses[])
+    : LCO(LCO_WAITER),
+      cond_(),
+      count_(count),
+      values_(values),
+      statuses_(statuses)
 {
-  dbg_assert(n > 0);
+  if (!count_) {
+    setTriggered();
+  }
+}
+
+void
+Waiter::signal(int i, hpx_status_t status, const void *value, size_t bytes)
+{
+  std::lock_guard<LCO> _(*this);
 
-  // Will partition the lcos up into local and remote LCOs. We waste some
-  // space here, since, for each lco in lcos, we either have a local mapping or
-  // a remote address. We don't use the stack because we can't control how big
-  // @p n gets.
-  LCO **locals = new LCO*[n]();
-  dbg_assert_str(locals, "failed to allocate array for %d elements", n);
-  hpx_addr_t *remotes = new hpx_addr_t[n]();
-  dbg_assert_str(remotes, "failed to allocate array for %d elements", n);
+  if (bytes && status == HPX_SUCCESS) {
+    memcpy(values_[i], value, bytes);
+  }
 
-  int zero = 0;
+  if (statuses_) {
+    statuses_[i] = status;
+  }
 
-  // Try and translate (and pin) all of the lcos, for any of the lcos that
-  // aren't local, allocate a proxy future and initiate the remote wait. This
-  // two-phase approach achieves some parallelism.
-  for (int i = 0; i < n; ++i) {
-    // We neither issue a remote proxy for HPX_NULL, nor wait locally on
-    // HPX_NULL. We manually set the status output for these elements to
-    // indicate success.
-    if (lcos[i] == HPX_NULL) {
-      locals[i] = NULL;
-      remotes[i] = HPX_NULL;
+  if (--count_ == 0) {
+    setTriggered();
+    cond_.signalAll();
+  }
+}
+
+void
+Waiter::arm()
+{
+  std::lock_guard<LCO> _(*this);
+  if (--count_ == 0) {
+    setTriggered();
+    cond_.signalAll();
+  }
+}
+
+/// The signal parcel attached to local LCOs.
+static int
+_multi_signal_handler(Waiter* w, int i)
+{
+  w->signal(i, HPX_SUCCESS, nullptr, 0);
+  return HPX_SUCCESS;
+}
+static LIBHPX_ACTION(HPX_INTERRUPT, 0, _multi_signal, _multi_signal_handler,
+                     HPX_POINTER, HPX_INT);
+
+/// The reply to a remote multi-LCO request, carries the value if there is one.
+static int
+_multi_reply_handler(MultiReply* reply, size_t n)
+{
+  size_t bytes = n - sizeof(*reply);
+  reply->waiter->signal(reply->i, reply->status, reply->value, bytes);
+  return HPX_SUCCESS;
+}
+static LIBHPX_ACTION(HPX_INTERRUPT, HPX_MARSHALLED, _multi_reply,
+                     _multi_reply_handler, HPX_POINTER, HPX_SIZE_T);
+
+/// The request sent to remote LCOs, which serializes the value directly into
+/// the reply parcel.
+///
+/// This waits for the LCO, which is what the _all operations need from every
+/// input anyway.
+static int
+_multi_request_handler(LCO* lco, Waiter* w, int i, size_t n)
+{
+  size_t bytes = sizeof(MultiReply) + n;
+  hpx_parcel_t *cont = hpx_thread_generate_continuation(NULL, bytes);
+  auto reply = static_cast<MultiReply*>(hpx_parcel_get_data(cont));
+  reply->waiter = w;
+  reply->i = i;
+  reply->status = (n) ? lco->get(n, reply->value, 0) : lco->wait(0);
+  parcel_launch(cont);
+  return HPX_SUCCESS;
+}
+static LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED, _multi_request,
+                     _multi_request_handler, HPX_POINTER, HPX_POINTER, HPX_INT,
+                     HPX_SIZE_T);
+
+/// Register a waiter with the @p i th LCO.
+///
+/// Local LCOs are pinned and returned in @p local, the caller is responsible
+/// for unpinning them. Local LCOs that don't have a triggered state are not
+/// registered, the caller must wait for them directly.
+static void
+_multi_register(Waiter* w, int i, hpx_addr_t lco, size_t size, LCO*& local)
+{
+  local = nullptr;
+  if (lco == HPX_NULL) {
+    return;
+  }
+
+  if (!hpx_gas_try_pin(lco, (void**)&local)) {
+    w->addInput();
+    hpx_action_t rop = _multi_reply;
+    dbg_check( action_call_lsync(_multi_request, lco, HPX_HERE, rop, 3, &w,
+                                 &i, &size) );
+    return;
+  }
+
+  if (!local->isTriggerable()) {
+    return;
+  }
+
+  w->addInput();
+  hpx_parcel_t *p = action_new_parcel(_multi_signal, HPX_HERE, 0, 0, 2, &w, &i);
+  parcel_prepare(p);
+  if (hpx_status_t status = local->attach(p)) {
+    w->signal(i, status, nullptr, 0);
+  }
+}
+
+AnyWaiter::AnyWaiter(int n, void *values[])
+    : LCO(LCO_WAITER),
+      cond_(),
+      n_(n),
+      pending_(1),
+      first_(-1),
+      status_(HPX_SUCCESS),
+      unsupported_(false),
+      values_(values),
+      attached_(new bool[n]()),
+      refs_(1)
+{
+}
+
+void
+AnyWaiter::tryTrigger()
+{
+  if (!pending_ && (first_ >= 0 || unsupported_)) {
+    setTriggered();
+    cond_.signalAll();
+  }
+}
+
+void
+AnyWaiter::unsupported()
+{
+  std::lock_guard<LCO> _(*this);
+  unsupported_ = true;
+  tryTrigger();
+}
+
+bool
+AnyWaiter::ack(int i, hpx_status_t status, bool supported)
+{
+  std::lock_guard<LCO> _(*this);
+  --pending_;
+  if (!supported) {
+    unsupported_ = true;
+  }
+  else if (status == HPX_SUCCESS) {
+    attached_[i] = true;
+  }
+  else if (first_ < 0) {
+    first_ = i;
+    status_ = status;
+  }
+  tryTrigger();
+  return (!supported || status != HPX_SUCCESS);
+}
+
+void
+AnyWaiter::signal(int i, hpx_status_t status, const void *value, size_t bytes)
+{
+  std::lock_guard<LCO> _(*this);
+
+  // Late signals just drop their reference.
+  if (getTriggered() || first_ >= 0) {
+    return;
+  }
+
+  if (bytes && status == HPX_SUCCESS) {
+    memcpy(values_[i], value, bytes);
+  }
+
+  first_ = i;
+  status_ = status;
+  tryTrigger();
+}
+
+void
+AnyWaiter::arm()
+{
+  std::lock_guard<LCO> _(*this);
+  --pending_;
+  tryTrigger();
+}
+
+/// Select the parcel that an any-waiter attached for a registration.
+static bool _any_match(const hpx_parcel_t *p, const void *key);
+
+/// Detach a registration from a pinned LCO, dropping its reference.
+static void
+_any_detach(LCO* lco, const AnyKey& key)
+{
+  if (hpx_parcel_t *p = lco->detach(_any_match, &key)) {
+    parcel_delete(p);
+    key.waiter->drop();
+  }
+}
+
+/// The signal parcel attached to local LCOs.
+static int
+_any_signal_handler(AnyKey* key, size_t)
+{
+  AnyWaiter::Signal(key->waiter, key->i, HPX_SUCCESS, nullptr, 0);
+  return HPX_SUCCESS;
+}
+static LIBHPX_ACTION(HPX_INTERRUPT, HPX_MARSHALLED, _any_signal,
+                     _any_signal_handler, HPX_POINTER, HPX_SIZE_T);
+
+/// The reply to a remote probe, carries the value if there is one.
+static int
+_any_reply_handler(AnyReply* reply, size_t n)
+{
+  size_t bytes = n - sizeof(*reply);
+  AnyWaiter::Signal(reply->key.waiter, reply->key.i, reply->status,
+                    reply->value, bytes);
+  return HPX_SUCCESS;
+}
+static LIBHPX_ACTION(HPX_INTERRUPT, HPX_MARSHALLED, _any_reply,
+                     _any_reply_handler, HPX_POINTER, HPX_SIZE_T);
+
+/// The parcel attached to remote LCOs, which runs once the LCO has triggered
+/// and so reads its value without blocking.
+static int
+_any_probe_handler(LCO* lco, AnyProbe* probe, size_t)
+{
+  size_t n = probe->size;
+  hpx_pid_t pid = hpx_thread_current_pid();
+  hpx_parcel_t *p = parcel_new(probe->at, _any_reply, 0, 0, pid, nullptr,
+                               sizeof(AnyReply) + n);
+  auto reply = static_cast<AnyReply*>(hpx_parcel_get_data(p));
+  reply->key = probe->key;
+  reply->status = (n) ? lco->get(n, reply->value, 0) : lco->wait(0);
+  parcel_launch(p);
+  return HPX_SUCCESS;
+}
+static LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED | HPX_MARSHALLED, _any_probe,
+                     _any_probe_handler, HPX_POINTER, HPX_POINTER, HPX_SIZE_T);
+
+/// The acknowledgment of a remote registration.
+static int
+_any_ack_handler(AnyAck* ack, size_t)
+{
+  AnyWaiter* w = ack->key.waiter;
+  if (w->ack(ack->key.i, ack->status, ack->supported)) {
+    w->drop();
+  }
+  return HPX_SUCCESS;
+}
+static LIBHPX_ACTION(HPX_INTERRUPT, HPX_MARSHALLED, _any_ack, _any_ack_handler,
+                     HPX_POINTER, HPX_SIZE_T);
+
+/// The registration request sent to remote LCOs, which attaches a probe and
+/// acknowledges the attach.
+static int
+_any_request_handler(LCO* lco, AnyProbe* probe, size_t)
+{
+  AnyAck ack;
+  ack.key = probe->key;
+  ack.status = HPX_SUCCESS;
+  ack.supported = lco->isTriggerable();
+  if (ack.supported) {
+    hpx_addr_t target = hpx_thread_current_target();
+    hpx_parcel_t *p = action_new_parcel(_any_probe, target, 0, 0, 2, probe,
+                                        sizeof(*probe));
+    parcel_prepare(p);
+    ack.status = lco->attach(p);
+  }
+  return hpx_thread_continue(&ack, sizeof(ack));
+}
+static LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED | HPX_MARSHALLED, _any_request,
+                     _any_request_handler, HPX_POINTER, HPX_POINTER,
+                     HPX_SIZE_T);
+
+/// Drop the reference held by a registration that was detached remotely.
+static int
+_any_drop_handler(AnyKey* key, size_t)
+{
+  key->waiter->drop();
+  return HPX_SUCCESS;
+}
+static LIBHPX_ACTION(HPX_INTERRUPT, HPX_MARSHALLED, _any_drop,
+                     _any_drop_handler, HPX_POINTER, HPX_SIZE_T);
+
+/// Detach a losing registration from a remote LCO.
+static int
+_any_cancel_handler(LCO* lco, AnyProbe* probe, size_t)
+{
+  if (hpx_parcel_t *p = lco->detach(_any_match, &probe->key)) {
+    parcel_delete(p);
+    return hpx_call(probe->at, _any_drop, HPX_NULL, &probe->key,
+                    sizeof(probe->key));
+  }
+  return HPX_SUCCESS;
+}
+static LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED | HPX_MARSHALLED, _any_cancel,
+                     _any_cancel_handler, HPX_POINTER, HPX_POINTER,
+                     HPX_SIZE_T);
+
+static bool
+_any_match(const hpx_parcel_t *p, const void *arg)
+{
+  if (p->action != _any_signal && p->action != _any_probe) {
+    return false;
+  }
+  auto key = static_cast<const AnyKey*>(arg);
+  auto data = static_cast<const AnyKey*>(hpx_parcel_get_data(
+      const_cast<hpx_parcel_t*>(p)));
+  return (data->waiter == key->waiter && data->i == key->i);
+}
+
+void
+AnyWaiter::detachLosers(const hpx_addr_t lcos[])
+{
+  // Every registration has been acknowledged by the time we trigger, so the
+  // attached inputs won't change. Local losers are detached directly, and we
+  // wait for the remote ones so that the caller can delete the LCOs as soon
+  // as we return.
+  int first = getFirst();
+  std::vector<int> remote;
+  for (int i = 0; i < n_; ++i) {
+    if (!attached_[i] || i == first) {
+      continue;
     }
-    else if (hpx_gas_try_pin(lcos[i], (void**)&locals[i])) {
-      remotes[i] = HPX_NULL;
+
+    LCO *lco = nullptr;
+    if (hpx_gas_try_pin(lcos[i], (void**)&lco)) {
+      AnyKey key = { this, i };
+      _any_detach(lco, key);
+      hpx_gas_unpin(lcos[i]);
     }
     else {
-      locals[i] = NULL;
-      remotes[i] = hpx_lco_future_new(0);
-      hpx_call_async(lcos[i], _lco_wait, HPX_NULL, remotes[i], &zero);
+      remote.push_back(i);
     }
   }
 
-  // Wait on all of the lcos sequentially. If the lco is local (i.e., we have a
-  // local translation for it) we use the local get operation, otherwise we wait
-  // for the completion of the remote proxy.
-  int errors = 0;
-  for (int i = 0; i < n; ++i) {
-    hpx_status_t status = HPX_SUCCESS;
-    if (locals[i] != NULL) {
-      status = locals[i]->wait(0);
-      hpx_gas_unpin(lcos[i]);
+  if (remote.empty()) {
+    return;
+  }
+
+  hpx_addr_t done = hpx_lco_and_new(remote.size());
+  for (int i : remote) {
+    AnyProbe probe;
+    probe.key.waiter = this;
+    probe.key.i = i;
+    probe.size = 0;
+    probe.at = HPX_HERE;
+    dbg_check( hpx_call(lcos[i], _any_cancel, done, &probe, sizeof(probe)) );
+  }
+  dbg_check( hpx_lco_wait(done) );
+  hpx_lco_delete(done, HPX_NULL);
+}
+
+/// Register an any-waiter with the @p i th LCO.
+///
+/// Each registration that may signal the waiter holds a reference to it. LCOs
+/// that don't have a triggered state are not supported, and trigger the waiter
+/// with an error.
+static void
+_any_register(AnyWaiter* w, int i, hpx_addr_t lco, size_t size)
+{
+  LCO *local = nullptr;
+  if (!hpx_gas_try_pin(lco, (void**)&local)) {
+    w->expect();
+    w->addRef();
+    AnyProbe probe;
+    probe.key.waiter = w;
+    probe.key.i = i;
+    probe.size = size;
+    probe.at = HPX_HERE;
+    if (action_call_lsync(_any_request, lco, HPX_HERE, _any_ack, 2, &probe,
+                          sizeof(probe))) {
+      log_error("failed to register with LCO %d\n", i);
+      if (w->ack(i, HPX_ERROR, true)) {
+        w->drop();
+      }
     }
-    else if (remotes[i] != HPX_NULL) {
-      status = hpx_lco_wait(remotes[i]);
-      hpx_lco_delete(remotes[i], HPX_NULL);
+    return;
+  }
+
+  if (!local->isTriggerable()) {
+    w->unsupported();
+  }
+  else {
+    w->addRef();
+    AnyKey key = { w, i };
+    hpx_parcel_t *p = action_new_parcel(_any_signal, HPX_HERE, 0, 0, 2, &key,
+                                        sizeof(key));
+    parcel_prepare(p);
+    if (hpx_status_t status = local->attach(p)) {
+      AnyWaiter::Signal(w, i, status, nullptr, 0);
     }
     else {
-      status = HPX_SUCCESS;
+      w->attached(i);
     }
+  }
+  hpx_gas_unpin(lco);
+}
 
-    if (status != HPX_SUCCESS) {
-      ++errors;
-    }
+/// Wait for or get all of the LCOs, with a single suspension.
+static int
+_multi_all(int n, hpx_addr_t lcos[], size_t sizes[], void *values[],
+           hpx_status_t statuses[])
+{
+  dbg_assert(n > 0);
 
-    if (statuses) {
-      statuses[i] = status;
+  // We use the stack for the local translations and the statuses when we can,
+  // but we can't control how big @p n gets.
+  static constexpr int N = 32;
+  LCO *stack[N];
+  std::unique_ptr<LCO*[]> heap((n > N) ? new LCO*[n] : nullptr);
+  LCO **locals = (n > N) ? heap.get() : stack;
+
+  hpx_status_t stack_statuses[N];
+  std::unique_ptr<hpx_status_t[]> heap_statuses;
+  if (!statuses) {
+    heap_statuses.reset((n > N) ? new hpx_status_t[n] : nullptr);
+    statuses = (n > N) ? heap_statuses.get() : stack_statuses;
+  }
+
+  // Initialize the waiter with one extra input to keep it from triggering
+  // during registration.
+  Waiter w(1, values, statuses);
+  for (int i = 0; i < n; ++i) {
+    statuses[i] = HPX_SUCCESS;
+    size_t size = (sizes) ? sizes[i] : 0;
+    _multi_register(&w, i, lcos[i], size, locals[i]);
+  }
+  w.arm();
+
+  // This is the only point where the calling thread suspends for the
+  // registered LCOs.
+  dbg_check( w.wait(0) );
+
+  // Pick up the values and statuses from the local LCOs, which overwrite any
+  // status the waiter recorded for them (e.g., when attaching to an LCO that
+  // was already in an error state). Triggerable LCOs will not block here, the
+  // others are waited for directly.
+  for (int i = 0; i < n; ++i) {
+    if (LCO* lco = locals[i]) {
+      size_t size = (sizes) ? sizes[i] : 0;
+      void *value = (size) ? values[i] : nullptr;
+      statuses[i] = (size) ? lco->get(size, value, 0) : lco->wait(0);
+      hpx_gas_unpin(lcos[i]);
     }
   }
 
-  delete [] remotes;
-  delete [] locals;
+  // Count the errors once, after every input has reported its final status.
+  int errors = 0;
+  for (int i = 0; i < n; ++i) {
+    if (statuses[i] != HPX_SUCCESS) {
+      ++errors;
+    }
+  }
   return errors;
 }
 
-int
-hpx_lco_get_all(int n, hpx_addr_t lcos[], size_t sizes[], void *values[],
-                hpx_status_t statuses[])
+/// Wait for or get any one of the LCOs, with a single suspension.
+static int
+_multi_any(int n, hpx_addr_t lcos[], size_t sizes[], void *values[],
+           hpx_status_t *status)
 {
   dbg_assert(n > 0);
 
-  // Will partition the lcos up into local and remote LCOs. We waste some
-  // space here, since, for each lco in lcos, we either have a local mapping or
-  // a remote address. We don't use the stack because we can't control how big
-  // @p n gets.
-  LCO **locals = new LCO*[n]();
-  dbg_assert_str(locals, "failed to allocate array for %d elements", n);
-  hpx_addr_t *remotes = new hpx_addr_t[n]();
-  dbg_assert_str(remotes, "failed to allocate array for %d elements", n);
-
-  // Try and translate (and pin) all of the lcos, for any of the lcos that
-  // aren't local, allocate a proxy future and initiate the remote get. This
-  // two-phase approach achieves some parallelism.
+  // The waiter is shared with the registrations, each of which holds a
+  // reference, along with the calling thread.
+  AnyWaiter* w = AnyWaiter::New(n, values);
+  int registered = 0;
   for (int i = 0; i < n; ++i) {
-    if (lcos[i] == HPX_NULL) {
-      locals[i] = NULL;
-      remotes[i] = HPX_NULL;
-    }
-    else if (hpx_gas_try_pin(lcos[i], (void**)&locals[i])) {
-      remotes[i] = HPX_NULL;
-    }
-    else {
-      locals[i] = NULL;
-      remotes[i] = hpx_lco_future_new(sizes[i]);
-      hpx_call_async(lcos[i], _lco_get, HPX_NULL, remotes[i], &sizes[i],
-                     sizeof(sizes[i]));
+    if (lcos[i]) {
+      size_t size = (sizes) ? sizes[i] : 0;
+      _any_register(w, i, lcos[i], size);
+      ++registered;
     }
   }
 
-  // Wait on all of the lcos sequentially. If the lco is local (i.e., we have a
-  // local translation for it) we use the local get operation, otherwise we wait
-  // for the completion of the remote proxy.
-  int errors = 0;
-  for (int i = 0; i < n; ++i) {
-    hpx_status_t status = HPX_SUCCESS;
-    if (locals[i] != NULL) {
-      status = locals[i]->get(sizes[i], values[i], 0);
+  int i = -1;
+  hpx_status_t e = HPX_ERROR;
+  if (registered) {
+    w->arm();
+    dbg_check( w->wait(0) );
+    i = w->getFirst();
+    e = w->getStatus();
+    w->detachLosers(lcos);
+
+    // A local LCO signals without a value, so read it out here. This won't
+    // block because the LCO has triggered.
+    LCO *lco = nullptr;
+    if (i >= 0 && e == HPX_SUCCESS && hpx_gas_try_pin(lcos[i], (void**)&lco)) {
+      size_t size = (sizes) ? sizes[i] : 0;
+      e = (size) ? lco->get(size, values[i], 0) : lco->wait(0);
       hpx_gas_unpin(lcos[i]);
     }
-    else if (remotes[i] != HPX_NULL) {
-      status = hpx_lco_get(remotes[i], sizes[i], values[i]);
-      hpx_lco_delete(remotes[i], HPX_NULL);
-    }
-    else {
-      status = HPX_SUCCESS;
-    }
-
-    if (status != HPX_SUCCESS) {
-      ++errors;
-    }
+  }
+  w->drop();
 
-    if (statuses) {
-      statuses[i] = status;
-    }
+  if (status) {
+    *status = e;
   }
+  return i;
+}
 
-  delete [] remotes;
-  delete [] locals;
-  return errors;
+int
+hpx_lco_wait_all(int n, hpx_addr_t lcos[], hpx_status_t statuses[])
+{
+  return _multi_all(n, lcos, nullptr, nullptr, statuses);
+}
+
+int
+hpx_lco_get_all(int n, hpx_addr_t lcos[], size_t sizes[], void *values[],
+                hpx_status_t statuses[])
+{
+  return _multi_all(n, lcos, sizes, values, statuses);
+}
+
+int
+hpx_lco_wait_any(int n, hpx_addr_t lcos[], hpx_status_t *status)
+{
+  return _multi_any(n, lcos, nullptr, nullptr, status);
+}
+
+int
+hpx_lco_get_any(int n, hpx_addr_t lcos[], size_t sizes[], void *values[],
+                hpx_status_t *status)
+{
+  return _multi_any(n, lcos, sizes, values, status);
 }
 
 int
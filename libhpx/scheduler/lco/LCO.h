@@ -65,6 +65,19 @@ class LCO {
   static void operator delete(void* obj);       // does nothing
   /// @}
 
+  /// Destroy a local LCO and release its global memory.
+  ///
+  /// LCOs allocated through the operator new() overloads are recycled into a
+  /// per-worker pool of blocks when possible, so that short-lived LCOs don't
+  /// need to go through the global allocator and block translation table.
+  ///
+  /// @param        gva The global address of the LCO.
+  /// @param        lco The pinned local address of the LCO.
+  ///
+  /// @returns          True if the block was recycled, false if the caller
+  ///                   needs to free @p gva.
+  static bool Recycle(hpx_addr_t gva, LCO* lco);
+
   /// The abstract LCO interface that needs to be implemented by all
   /// subclasses.
   /// @{
@@ -84,6 +97,19 @@ class LCO {
   virtual bool release(void *out);
   /// @}
 
+  /// Detach a parcel that was attached to the LCO but hasn't been launched.
+  ///
+  /// Only triggerable LCOs keep their attached parcels where they can be
+  /// found, the default implementation never finds anything.
+  ///
+  /// @param      match A predicate that selects the parcel to detach.
+  /// @param        arg The argument passed to @p match.
+  ///
+  /// @returns          The detached parcel, which the caller now owns, or
+  ///                   nullptr if no attached parcel matched.
+  virtual hpx_parcel_t* detach(bool (*match)(const hpx_parcel_t*, const void*),
+                               const void* arg);
+
   /// Static action entry points for remote procedure call handling.
   /// @{
   static int DeleteHandler(LCO* lco);
@@ -91,8 +117,6 @@ class LCO {
   static int ErrorHandler(LCO* lco, void* args, size_t n);
   static int ResetHandler(LCO* lco);
   static int SizeHandler(const LCO* lco, int arg);
-  static int GetHandler(LCO* lco, int n);
-  static int WaitHandler(LCO *lco, int reset);
   static int AttachHandler(LCO *lco, hpx_parcel_t *p, size_t size);
   /// @}
 
@@ -110,6 +134,14 @@ class LCO {
   void unlock();
   /// @}
 
+  /// Check to see if this LCO has a monotonic triggered state.
+  ///
+  /// Most LCOs will launch a parcel passed to attach() exactly when a
+  /// subsequent wait() would complete without blocking. Semaphores,
+  /// generation counters, channels and locks do not behave this way, so the
+  /// multi-LCO wait operations must wait for them directly.
+  bool isTriggerable() const;
+
  protected:
   /// The enumeration used for dynamically typing LCOs.
   enum Type : unsigned {
@@ -123,6 +155,9 @@ class LCO {
     LCO_SEMA,
     LCO_USER,
     LCO_DATAFLOW,
+    LCO_WAITER,
+    LCO_CHANNEL,
+    LCO_RWLOCK,
     LCO_MAX
   };
 
@@ -148,7 +183,21 @@ class LCO {
   static void* TryPin(hpx_addr_t gva);
   /// @}
 
+  /// Used in action handlers to report a failure through the continuation.
+  ///
+  /// The worker treats any status other than HPX_SUCCESS or HPX_LCO_ERROR as
+  /// fatal, so a handler takes its continuation and sets the error there.
+  ///
+  /// @param     status The error to report.
+  ///
+  /// @returns          HPX_SUCCESS, which the handler should return.
+  static int ContinueError(hpx_status_t status);
+
  private:
+  /// This thread local is used to pass the pool size class of a block from
+  /// operator new() through to the LCO constructor.
+  static __thread short PoolClassPassthrough_;
+
   TatasLock<short> lock_;                       //<! The LCO's lock
   short           state_;                       //<! State bits
   Type             type_;                       //<! The LCO's dynamic type
@@ -0,0 +1,288 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+/// @file libhpx/scheduler/lco/RWLock.cpp
+/// @brief Implements the reader-writer lock LCO.
+///
+/// Any number of readers may hold the lock at the same time, or a single
+/// writer. Blocked threads suspend on one of two conditions. With writer
+/// preference enabled, new readers queue behind any waiting writer so that
+/// writers can't be starved by a steady stream of readers.
+
+#include "LCO.h"
+#include "Condition.h"
+#include "libhpx/action.h"
+#include "libhpx/debug.h"
+#include <mutex>
+
+namespace {
+using libhpx::scheduler::Condition;
+using libhpx::scheduler::LCO;
+
+class RWLock final : public LCO
+{
+ public:
+  RWLock(int writerPreference);
+
+  ~RWLock() {
+    lock();                                     // Released in ~LCO()
+  }
+
+  int set(size_t size, const void *value) {
+    dbg_error("Setting a reader-writer lock is unsupported.\n");
+  }
+
+  void error(hpx_status_t code) {
+    std::lock_guard<LCO> _(*this);
+    readers_.signalError(code);
+    writers_.signalError(code);
+  }
+
+  hpx_status_t get(size_t size, void *value, int reset) {
+    dbg_error("Getting a reader-writer lock is unsupported.\n");
+  }
+
+  hpx_status_t wait(int reset) {
+    dbg_error("Waiting for a reader-writer lock is unsupported.\n");
+  }
+
+  hpx_status_t attach(hpx_parcel_t *p) {
+    dbg_error("Attaching to a reader-writer lock is unsupported.\n");
+  }
+
+  void reset() {
+    std::lock_guard<LCO> _(*this);
+    dbg_assert(!nReaders_ && !writer_ && !nWaitingWriters_);
+    readers_.reset();
+    writers_.reset();
+  }
+
+  size_t size(size_t) const {
+    return sizeof(*this);
+  }
+
+  /// Acquire and release the lock.
+  /// @{
+  hpx_status_t acquireShared();
+  hpx_status_t acquireExclusive();
+  void releaseShared();
+  void releaseExclusive();
+  /// @}
+
+ public:
+  /// Static action interface.
+  /// @{
+  static int NewHandler(void* buffer, int writerPreference) {
+    auto lco = new(buffer) RWLock(writerPreference);
+    return HPX_THREAD_CONTINUE(lco);
+  }
+
+  static int AcquireSharedHandler(RWLock& lco) {
+    if (auto status = lco.acquireShared()) {
+      return ContinueError(status);
+    }
+    return HPX_SUCCESS;
+  }
+
+  static int AcquireExclusiveHandler(RWLock& lco) {
+    if (auto status = lco.acquireExclusive()) {
+      return ContinueError(status);
+    }
+    return HPX_SUCCESS;
+  }
+
+  static int ReleaseSharedHandler(RWLock& lco) {
+    lco.releaseShared();
+    return HPX_SUCCESS;
+  }
+
+  static int ReleaseExclusiveHandler(RWLock& lco) {
+    lco.releaseExclusive();
+    return HPX_SUCCESS;
+  }
+  /// @}
+
+ private:
+  /// Wake the next set of waiters after the lock becomes free.
+  void handoff();
+
+  Condition         readers_;                   //!< waiting readers
+  Condition         writers_;                   //!< waiting writers
+  unsigned         nReaders_;                   //!< active readers
+  unsigned  nWaitingWriters_;                   //!< suspended writers
+  bool               writer_;                   //!< active writer
+  const bool writerPreference_;
+};
+
+LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED, New, RWLock::NewHandler, HPX_POINTER,
+              HPX_INT);
+LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED, AcquireShared,
+              RWLock::AcquireSharedHandler, HPX_POINTER);
+LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED, AcquireExclusive,
+              RWLock::AcquireExclusiveHandler, HPX_POINTER);
+LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED, ReleaseShared,
+              RWLock::ReleaseSharedHandler, HPX_POINTER);
+LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED, ReleaseExclusive,
+              RWLock::ReleaseExclusiveHandler, HPX_POINTER);
+} // namespace
+
+RWLock::RWLock(int writerPreference)
+    : LCO(LCO_RWLOCK),
+      readers_(),
+      writers_(),
+      nReaders_(0),
+      nWaitingWriters_(0),
+      writer_(false),
+      writerPreference_(writerPreference)
+{
+}
+
+hpx_status_t
+RWLock::acquireShared()
+{
+  std::lock_guard<LCO> _(*this);
+  while (writer_ || (writerPreference_ && nWaitingWriters_)) {
+    if (auto status = waitFor(readers_)) {
+      return status;
+    }
+  }
+  ++nReaders_;
+  return HPX_SUCCESS;
+}
+
+hpx_status_t
+RWLock::acquireExclusive()
+{
+  std::lock_guard<LCO> _(*this);
+  while (writer_ || nReaders_) {
+    ++nWaitingWriters_;
+    auto status = waitFor(writers_);
+    --nWaitingWriters_;
+    if (status) {
+      return status;
+    }
+  }
+  writer_ = true;
+  return HPX_SUCCESS;
+}
+
+void
+RWLock::releaseShared()
+{
+  std::lock_guard<LCO> _(*this);
+  dbg_assert(nReaders_ && !writer_);
+  if (--nReaders_ == 0) {
+    handoff();
+  }
+}
+
+void
+RWLock::releaseExclusive()
+{
+  std::lock_guard<LCO> _(*this);
+  dbg_assert(writer_ && !nReaders_);
+  writer_ = false;
+  handoff();
+}
+
+void
+RWLock::handoff()
+{
+  if (nWaitingWriters_) {
+    writers_.signal();                          // just wake one writer
+  }
+
+  // With writer preference readers would just suspend again behind the writer
+  // we just woke, so leave them alone.
+  if (!writerPreference_ || !nWaitingWriters_) {
+    readers_.signalAll();
+  }
+}
+
+hpx_addr_t
+hpx_lco_rwlock_new(int writer_preference)
+{
+  hpx_addr_t gva = HPX_NULL;
+  RWLock* lco = nullptr;
+  try {
+    lco = new(gva) RWLock(writer_preference);
+    hpx_gas_unpin(gva);
+  }
+  catch (const LCO::NonLocalMemory&) {
+    hpx_call_sync(gva, New, &lco, sizeof(lco), &writer_preference);
+  }
+  LCO_LOG_NEW(gva, lco);
+  return gva;
+}
+
+/// Acquire a reader-writer lock.
+///
+/// If the lock is local we acquire it directly without a parcel, otherwise we
+/// acquire it remotely and wait for the acknowledgment.
+hpx_status_t
+hpx_lco_rwlock_rdlock(hpx_addr_t rwlock)
+{
+  RWLock* lco = nullptr;
+  if (hpx_gas_try_pin(rwlock, (void**)&lco)) {
+    auto status = lco->acquireShared();
+    hpx_gas_unpin(rwlock);
+    return status;
+  }
+  return hpx_call_sync(rwlock, AcquireShared, nullptr, 0);
+}
+
+hpx_status_t
+hpx_lco_rwlock_wrlock(hpx_addr_t rwlock)
+{
+  RWLock* lco = nullptr;
+  if (hpx_gas_try_pin(rwlock, (void**)&lco)) {
+    auto status = lco->acquireExclusive();
+    hpx_gas_unpin(rwlock);
+    return status;
+  }
+  return hpx_call_sync(rwlock, AcquireExclusive, nullptr, 0);
+}
+
+/// Release a reader-writer lock.
+///
+/// Remote releases are asynchronous, the @p rsync LCO can be used to wait for
+/// the release to complete.
+void
+hpx_lco_rwlock_rdunlock(hpx_addr_t rwlock, hpx_addr_t rsync)
+{
+  RWLock* lco = nullptr;
+  if (hpx_gas_try_pin(rwlock, (void**)&lco)) {
+    lco->releaseShared();
+    hpx_gas_unpin(rwlock);
+    hpx_lco_set(rsync, 0, NULL, HPX_NULL, HPX_NULL);
+    return;
+  }
+  dbg_check( hpx_call(rwlock, ReleaseShared, rsync) );
+}
+
+void
+hpx_lco_rwlock_wrunlock(hpx_addr_t rwlock, hpx_addr_t rsync)
+{
+  RWLock* lco = nullptr;
+  if (hpx_gas_try_pin(rwlock, (void**)&lco)) {
+    lco->releaseExclusive();
+    hpx_gas_unpin(rwlock);
+    hpx_lco_set(rsync, 0, NULL, HPX_NULL, HPX_NULL);
+    return;
+  }
+  dbg_check( hpx_call(rwlock, ReleaseExclusive, rsync) );
+}
@@ -39,6 +39,8 @@ struct Reduce final : public LCO {
   }
 
   hpx_status_t attach(hpx_parcel_t *p);
+  hpx_parcel_t* detach(bool (*match)(const hpx_parcel_t*, const void*),
+                       const void* arg);
   hpx_status_t get(size_t size, void *value, int reset);
   hpx_status_t getRef(size_t size, void **out, int *unpin);
   bool release(void *out);
@@ -142,6 +144,14 @@ Reduce::attach(hpx_parcel_t *p)
   return HPX_SUCCESS;
 }
 
+hpx_parcel_t*
+Reduce::detach(bool (*match)(const hpx_parcel_t*, const void*),
+               const void* arg)
+{
+  std::lock_guard<LCO> _(*this);
+  return barrier_.remove(match, arg);
+}
+
 /// Update the reduction.
 int
 Reduce::set(size_t size, const void *from)
@@ -69,6 +69,8 @@ class UserLCO final : public LCO {
 
   /// Attach a continuation parcel to the user lco.
   hpx_status_t attach(hpx_parcel_t *p);
+  hpx_parcel_t* detach(bool (*match)(const hpx_parcel_t*, const void*),
+                       const void* arg);
 
   /// Wait for the lco.
   hpx_status_t wait(int reset) {
@@ -274,6 +276,14 @@ UserLCO::attach(hpx_parcel_t *p)
   return HPX_SUCCESS;
 }
 
+hpx_parcel_t*
+UserLCO::detach(bool (*match)(const hpx_parcel_t*, const void*),
+                const void* arg)
+{
+  std::lock_guard<LCO> _(*this);
+  return cvar_.remove(match, arg);
+}
+
 int
 NewOp::operator()(hpx_addr_t gva) const
 {
@@ -432,17 +432,20 @@ void config_print(const config_t *cfg, FILE *f) {
   }
   fprintf(f, "\n");
 
-#ifdef HAVE_PHOTON
+#ifdef HAVE_PWC
   fprintf(f, "\nPWC\n");
   fprintf(f, "  parcelbuffersize\t%lu\n", cfg->pwc_parcelbuffersize);
   fprintf(f, "  parceleagerlimit\t%lu\n", cfg->pwc_parceleagerlimit);
+  fprintf(f, "  ptraceany\t\t%d\n", cfg->pwc_ptraceany);
 #endif
 
-#ifdef HAVE_MPI
+#ifdef HAVE_ISIR
   fprintf(f, "\nIsend/Irecv\n");
   fprintf(f, "  testwindow\t\t%u\n", cfg->isir_testwindow);
   fprintf(f, "  sendlimit\t\t%u\n", cfg->isir_sendlimit);
   fprintf(f, "  recvlimit\t\t%u\n", cfg->isir_recvlimit);
+  fprintf(f, "  connections\t\t%u\n", cfg->isir_connections);
+  fprintf(f, "  multiple\t\t%d\n", cfg->isir_multiple);
 #endif
 
 #ifdef HAVE_PHOTON
@@ -460,11 +463,17 @@ void config_print(const config_t *cfg, FILE *f) {
   fprintf(f, "  ethdev\t\t\"%s\"\n", cfg->photon_ethdev);
   fprintf(f, "  ibdev\t\t\t\"%s\"\n", cfg->photon_ibdev);
 #endif
+  fprintf(f, "\nCollectives\n");
+  fprintf(f, "  network\t\t%d\n", cfg->coll_network);
+  fprintf(f, "  radix\t\t\t%u\n", cfg->coll_radix);
+
   fprintf(f, "\nOptimization\n");
   fprintf(f, "  smp\t\t\t%d\n", cfg->opt_smp);
 
   fprintf(f, "\nCoalescing parameters\n");
   fprintf(f, " Coalescing buffer size\t\t%d\n", cfg->coalescing_buffersize);
+  fprintf(f, " Coalescing bytes\t\t%d\n", cfg->coalescing_bytes);
+  fprintf(f, " Coalescing deadline (us)\t\t%d\n", cfg->coalescing_usecs);
 
 
   fprintf(f, "------------------------\n");
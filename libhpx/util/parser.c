@@ -39,9 +39,9 @@ const char *hpx_options_t_help[] = {
   "      --hpx-version             print HPX version  (default=off)",
   "      --hpx-heapsize=bytes      set HPX per-PE global heap size",
   "      --hpx-gas=type            type of Global Address Space (GAS)  (possible\n                                  values=\"default\", \"smp\", \"pgas\",\n                                  \"agas\")",
-  "      --hpx-boot=type           HPX bootstrap method to use  (possible\n                                  values=\"default\", \"smp\", \"mpi\",\n                                  \"pmi\")",
+  "      --hpx-boot=type           HPX bootstrap method to use  (possible\n                                  values=\"default\", \"smp\", \"mpi\",\n                                  \"pmi\", \"tcp\")",
   "      --hpx-transport=type      type of transport to use  (possible\n                                  values=\"default\", \"mpi\", \"photon\")",
-  "      --hpx-network=type        type of network to use  (possible\n                                  values=\"default\", \"smp\", \"pwc\",\n                                  \"isir\")",
+  "      --hpx-network=type        type of network to use  (possible\n                                  values=\"default\", \"smp\", \"pwc\",\n                                  \"isir\", \"shm\")",
   "      --hpx-configfile=file     HPX runtime configuration file",
   "\nScheduler Options:",
   "      --hpx-threads=threads     number of scheduler threads",
@@ -74,11 +74,15 @@ const char *hpx_options_t_help[] = {
   "      --hpx-isir-testwindow=requests\n                                number of ISIR requests to test in progress\n                                  loop",
   "      --hpx-isir-sendlimit=requests\n                                ISIR network send limit",
   "      --hpx-isir-recvlimit=requests\n                                ISIR network recv limit",
+  "      --hpx-isir-connections=count\n                                ISIR TCP connections per peer",
+  "      --hpx-isir-multiple       give each worker its own ISIR send and receive\n                                  path (MPI_THREAD_MULTIPLE)  (default=off)",
   "\nPWC Network Options:",
   "      --hpx-pwc-parcelbuffersize=bytes\n                                set the size of p2p recv buffers for parcel\n                                  sends",
   "      --hpx-pwc-parceleagerlimit=bytes\n                                set the largest eager parcel size (header\n                                  inclusive)",
+  "      --hpx-pwc-ptraceany       let any process on the host ptrace this one\n                                  (pwc shm transport)  (default=off)",
   "\nCollectives Options:",
   "      --hpx-coll-network        set collective implementation to network based\n                                  version (override parcel collectives)\n                                  (default=off)",
+  "      --hpx-coll-radix=radix    fan-out of the process collective trees (0\n                                  selects a flat tree)",
   "\nPhoton Transport Options:",
   "      --hpx-photon-comporder=type\n                                request completion ordering mode  (possible\n                                  values=\"default\", \"none\", \"strict\")",
   "      --hpx-photon-backend=type set the underlying network API to use\n                                  (possible values=\"default\", \"verbs\",\n                                  \"ugni\", \"fi\")",
@@ -103,6 +107,8 @@ const char *hpx_options_t_help[] = {
   "      --hpx-opt-smp[=0 off]     optimize for SMP execution",
   "      --hpx-parcel-compression  enable parcel compression  (default=off)",
   "      --hpx-coalescing-buffersize=Integer\n                                set coalescing buffer size",
+  "      --hpx-coalescing-bytes=Integer\n                                flush a destination at this many coalesced bytes",
+  "      --hpx-coalescing-usecs=Integer\n                                flush coalesced parcels after this many microseconds",
     0
 };
 
@@ -151,9 +157,9 @@ free_cmd_list(void)
 
 
 const char *hpx_option_parser_hpx_gas_values[] = {"default", "smp", "pgas", "agas", 0}; /*< Possible values for hpx-gas. */
-const char *hpx_option_parser_hpx_boot_values[] = {"default", "smp", "mpi", "pmi", 0}; /*< Possible values for hpx-boot. */
+const char *hpx_option_parser_hpx_boot_values[] = {"default", "smp", "mpi", "pmi", "tcp", 0}; /*< Possible values for hpx-boot. */
 const char *hpx_option_parser_hpx_transport_values[] = {"default", "mpi", "photon", 0}; /*< Possible values for hpx-transport. */
-const char *hpx_option_parser_hpx_network_values[] = {"default", "smp", "pwc", "isir", 0}; /*< Possible values for hpx-network. */
+const char *hpx_option_parser_hpx_network_values[] = {"default", "smp", "pwc", "isir", "shm", 0}; /*< Possible values for hpx-network. */
 const char *hpx_option_parser_hpx_thread_affinity_values[] = {"default", "hwthread", "core", "numa", "none", 0}; /*< Possible values for hpx-thread-affinity. */
 const char *hpx_option_parser_hpx_sched_policy_values[] = {"default", "random", "hier", 0}; /*< Possible values for hpx-sched-policy. */
 const char *hpx_option_parser_hpx_gas_affinity_values[] = {"none", "urcu", "cuckoo", 0}; /*< Possible values for hpx-gas-affinity. */
@@ -203,9 +209,13 @@ void clear_given (struct hpx_options_t *args_info)
   args_info->hpx_isir_testwindow_given = 0 ;
   args_info->hpx_isir_sendlimit_given = 0 ;
   args_info->hpx_isir_recvlimit_given = 0 ;
+  args_info->hpx_isir_connections_given = 0 ;
+  args_info->hpx_isir_multiple_given = 0 ;
   args_info->hpx_pwc_parcelbuffersize_given = 0 ;
   args_info->hpx_pwc_parceleagerlimit_given = 0 ;
+  args_info->hpx_pwc_ptraceany_given = 0 ;
   args_info->hpx_coll_network_given = 0 ;
+  args_info->hpx_coll_radix_given = 0 ;
   args_info->hpx_photon_comporder_given = 0 ;
   args_info->hpx_photon_backend_given = 0 ;
   args_info->hpx_photon_coll_given = 0 ;
@@ -228,6 +238,8 @@ void clear_given (struct hpx_options_t *args_info)
   args_info->hpx_opt_smp_given = 0 ;
   args_info->hpx_parcel_compression_given = 0 ;
   args_info->hpx_coalescing_buffersize_given = 0 ;
+  args_info->hpx_coalescing_bytes_given = 0 ;
+  args_info->hpx_coalescing_usecs_given = 0 ;
 }
 
 static
@@ -282,9 +294,13 @@ void clear_args (struct hpx_options_t *args_info)
   args_info->hpx_isir_testwindow_orig = NULL;
   args_info->hpx_isir_sendlimit_orig = NULL;
   args_info->hpx_isir_recvlimit_orig = NULL;
+  args_info->hpx_isir_connections_orig = NULL;
+  args_info->hpx_isir_multiple_flag = 0;
   args_info->hpx_pwc_parcelbuffersize_orig = NULL;
   args_info->hpx_pwc_parceleagerlimit_orig = NULL;
+  args_info->hpx_pwc_ptraceany_flag = 0;
   args_info->hpx_coll_network_flag = 0;
+  args_info->hpx_coll_radix_orig = NULL;
   args_info->hpx_photon_comporder_arg = hpx_photon_comporder__NULL;
   args_info->hpx_photon_comporder_orig = NULL;
   args_info->hpx_photon_backend_arg = hpx_photon_backend__NULL;
@@ -314,6 +330,8 @@ void clear_args (struct hpx_options_t *args_info)
   args_info->hpx_opt_smp_orig = NULL;
   args_info->hpx_parcel_compression_flag = 0;
   args_info->hpx_coalescing_buffersize_orig = NULL;
+  args_info->hpx_coalescing_bytes_orig = NULL;
+  args_info->hpx_coalescing_usecs_orig = NULL;
   
 }
 
@@ -366,31 +384,37 @@ void init_args_info(struct hpx_options_t *args_info)
   args_info->hpx_isir_testwindow_help = hpx_options_t_help[38] ;
   args_info->hpx_isir_sendlimit_help = hpx_options_t_help[39] ;
   args_info->hpx_isir_recvlimit_help = hpx_options_t_help[40] ;
-  args_info->hpx_pwc_parcelbuffersize_help = hpx_options_t_help[42] ;
-  args_info->hpx_pwc_parceleagerlimit_help = hpx_options_t_help[43] ;
-  args_info->hpx_coll_network_help = hpx_options_t_help[45] ;
-  args_info->hpx_photon_comporder_help = hpx_options_t_help[47] ;
-  args_info->hpx_photon_backend_help = hpx_options_t_help[48] ;
-  args_info->hpx_photon_coll_help = hpx_options_t_help[49] ;
-  args_info->hpx_photon_ibdev_help = hpx_options_t_help[50] ;
-  args_info->hpx_photon_ethdev_help = hpx_options_t_help[51] ;
-  args_info->hpx_photon_ibport_help = hpx_options_t_help[52] ;
-  args_info->hpx_photon_usecma_help = hpx_options_t_help[53] ;
-  args_info->hpx_photon_ibsrq_help = hpx_options_t_help[54] ;
-  args_info->hpx_photon_btethresh_help = hpx_options_t_help[55] ;
-  args_info->hpx_photon_fiprov_help = hpx_options_t_help[56] ;
-  args_info->hpx_photon_fidev_help = hpx_options_t_help[57] ;
-  args_info->hpx_photon_ledgersize_help = hpx_options_t_help[58] ;
-  args_info->hpx_photon_pwcbufsize_help = hpx_options_t_help[59] ;
-  args_info->hpx_photon_eagerbufsize_help = hpx_options_t_help[60] ;
-  args_info->hpx_photon_smallpwcsize_help = hpx_options_t_help[61] ;
-  args_info->hpx_photon_maxrd_help = hpx_options_t_help[62] ;
-  args_info->hpx_photon_defaultrd_help = hpx_options_t_help[63] ;
-  args_info->hpx_photon_numcq_help = hpx_options_t_help[64] ;
-  args_info->hpx_photon_usercq_help = hpx_options_t_help[65] ;
-  args_info->hpx_opt_smp_help = hpx_options_t_help[67] ;
-  args_info->hpx_parcel_compression_help = hpx_options_t_help[68] ;
-  args_info->hpx_coalescing_buffersize_help = hpx_options_t_help[69] ;
+  args_info->hpx_isir_connections_help = hpx_options_t_help[41] ;
+  args_info->hpx_isir_multiple_help = hpx_options_t_help[42] ;
+  args_info->hpx_pwc_parcelbuffersize_help = hpx_options_t_help[44] ;
+  args_info->hpx_pwc_parceleagerlimit_help = hpx_options_t_help[45] ;
+  args_info->hpx_pwc_ptraceany_help = hpx_options_t_help[46] ;
+  args_info->hpx_coll_network_help = hpx_options_t_help[48] ;
+  args_info->hpx_coll_radix_help = hpx_options_t_help[49] ;
+  args_info->hpx_photon_comporder_help = hpx_options_t_help[51] ;
+  args_info->hpx_photon_backend_help = hpx_options_t_help[52] ;
+  args_info->hpx_photon_coll_help = hpx_options_t_help[53] ;
+  args_info->hpx_photon_ibdev_help = hpx_options_t_help[54] ;
+  args_info->hpx_photon_ethdev_help = hpx_options_t_help[55] ;
+  args_info->hpx_photon_ibport_help = hpx_options_t_help[56] ;
+  args_info->hpx_photon_usecma_help = hpx_options_t_help[57] ;
+  args_info->hpx_photon_ibsrq_help = hpx_options_t_help[58] ;
+  args_info->hpx_photon_btethresh_help = hpx_options_t_help[59] ;
+  args_info->hpx_photon_fiprov_help = hpx_options_t_help[60] ;
+  args_info->hpx_photon_fidev_help = hpx_options_t_help[61] ;
+  args_info->hpx_photon_ledgersize_help = hpx_options_t_help[62] ;
+  args_info->hpx_photon_pwcbufsize_help = hpx_options_t_help[63] ;
+  args_info->hpx_photon_eagerbufsize_help = hpx_options_t_help[64] ;
+  args_info->hpx_photon_smallpwcsize_help = hpx_options_t_help[65] ;
+  args_info->hpx_photon_maxrd_help = hpx_options_t_help[66] ;
+  args_info->hpx_photon_defaultrd_help = hpx_options_t_help[67] ;
+  args_info->hpx_photon_numcq_help = hpx_options_t_help[68] ;
+  args_info->hpx_photon_usercq_help = hpx_options_t_help[69] ;
+  args_info->hpx_opt_smp_help = hpx_options_t_help[71] ;
+  args_info->hpx_parcel_compression_help = hpx_options_t_help[72] ;
+  args_info->hpx_coalescing_buffersize_help = hpx_options_t_help[73] ;
+  args_info->hpx_coalescing_bytes_help = hpx_options_t_help[74] ;
+  args_info->hpx_coalescing_usecs_help = hpx_options_t_help[75] ;
   
 }
 
@@ -554,8 +578,10 @@ hpx_option_parser_release (struct hpx_options_t *args_info)
   free_string_field (&(args_info->hpx_isir_testwindow_orig));
   free_string_field (&(args_info->hpx_isir_sendlimit_orig));
   free_string_field (&(args_info->hpx_isir_recvlimit_orig));
+  free_string_field (&(args_info->hpx_isir_connections_orig));
   free_string_field (&(args_info->hpx_pwc_parcelbuffersize_orig));
   free_string_field (&(args_info->hpx_pwc_parceleagerlimit_orig));
+  free_string_field (&(args_info->hpx_coll_radix_orig));
   free_string_field (&(args_info->hpx_photon_comporder_orig));
   free_string_field (&(args_info->hpx_photon_backend_orig));
   free_string_field (&(args_info->hpx_photon_coll_orig));
@@ -580,6 +606,8 @@ hpx_option_parser_release (struct hpx_options_t *args_info)
   free_string_field (&(args_info->hpx_photon_usercq_orig));
   free_string_field (&(args_info->hpx_opt_smp_orig));
   free_string_field (&(args_info->hpx_coalescing_buffersize_orig));
+  free_string_field (&(args_info->hpx_coalescing_bytes_orig));
+  free_string_field (&(args_info->hpx_coalescing_usecs_orig));
   
   
 
@@ -717,12 +745,20 @@ hpx_option_parser_dump(FILE *outfile, struct hpx_options_t *args_info)
     write_into_file(outfile, "hpx-isir-sendlimit", args_info->hpx_isir_sendlimit_orig, 0);
   if (args_info->hpx_isir_recvlimit_given)
     write_into_file(outfile, "hpx-isir-recvlimit", args_info->hpx_isir_recvlimit_orig, 0);
+  if (args_info->hpx_isir_connections_given)
+    write_into_file(outfile, "hpx-isir-connections", args_info->hpx_isir_connections_orig, 0);
+  if (args_info->hpx_isir_multiple_given)
+    write_into_file(outfile, "hpx-isir-multiple", 0, 0 );
   if (args_info->hpx_pwc_parcelbuffersize_given)
     write_into_file(outfile, "hpx-pwc-parcelbuffersize", args_info->hpx_pwc_parcelbuffersize_orig, 0);
   if (args_info->hpx_pwc_parceleagerlimit_given)
     write_into_file(outfile, "hpx-pwc-parceleagerlimit", args_info->hpx_pwc_parceleagerlimit_orig, 0);
+  if (args_info->hpx_pwc_ptraceany_given)
+    write_into_file(outfile, "hpx-pwc-ptraceany", 0, 0 );
   if (args_info->hpx_coll_network_given)
     write_into_file(outfile, "hpx-coll-network", 0, 0 );
+  if (args_info->hpx_coll_radix_given)
+    write_into_file(outfile, "hpx-coll-radix", args_info->hpx_coll_radix_orig, 0);
   if (args_info->hpx_photon_comporder_given)
     write_into_file(outfile, "hpx-photon-comporder", args_info->hpx_photon_comporder_orig, hpx_option_parser_hpx_photon_comporder_values);
   if (args_info->hpx_photon_backend_given)
@@ -767,6 +803,10 @@ hpx_option_parser_dump(FILE *outfile, struct hpx_options_t *args_info)
     write_into_file(outfile, "hpx-parcel-compression", 0, 0 );
   if (args_info->hpx_coalescing_buffersize_given)
     write_into_file(outfile, "hpx-coalescing-buffersize", args_info->hpx_coalescing_buffersize_orig, 0);
+  if (args_info->hpx_coalescing_bytes_given)
+    write_into_file(outfile, "hpx-coalescing-bytes", args_info->hpx_coalescing_bytes_orig, 0);
+  if (args_info->hpx_coalescing_usecs_given)
+    write_into_file(outfile, "hpx-coalescing-usecs", args_info->hpx_coalescing_usecs_orig, 0);
   
 
   i = EXIT_SUCCESS;
@@ -1995,9 +2035,13 @@ hpx_option_parser_internal (
         { "hpx-isir-testwindow",	1, NULL, 0 },
         { "hpx-isir-sendlimit",	1, NULL, 0 },
         { "hpx-isir-recvlimit",	1, NULL, 0 },
+        { "hpx-isir-connections",	1, NULL, 0 },
+        { "hpx-isir-multiple",	0, NULL, 0 },
         { "hpx-pwc-parcelbuffersize",	1, NULL, 0 },
         { "hpx-pwc-parceleagerlimit",	1, NULL, 0 },
+        { "hpx-pwc-ptraceany",	0, NULL, 0 },
         { "hpx-coll-network",	0, NULL, 0 },
+        { "hpx-coll-radix",	1, NULL, 0 },
         { "hpx-photon-comporder",	1, NULL, 0 },
         { "hpx-photon-backend",	1, NULL, 0 },
         { "hpx-photon-coll",	1, NULL, 0 },
@@ -2020,6 +2064,8 @@ hpx_option_parser_internal (
         { "hpx-opt-smp",	2, NULL, 0 },
         { "hpx-parcel-compression",	0, NULL, 0 },
         { "hpx-coalescing-buffersize",	1, NULL, 0 },
+        { "hpx-coalescing-bytes",	1, NULL, 0 },
+        { "hpx-coalescing-usecs",	1, NULL, 0 },
         { 0,  0, 0, 0 }
       };
 
@@ -2458,6 +2504,32 @@ hpx_option_parser_internal (
                 additional_error))
               goto failure;
           
+          }
+          /* ISIR TCP connections per peer.  */
+          else if (strcmp (long_options[option_index].name, "hpx-isir-connections") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_isir_connections_arg), 
+                 &(args_info->hpx_isir_connections_orig), &(args_info->hpx_isir_connections_given),
+                &(local_args_info.hpx_isir_connections_given), optarg, 0, 0, ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "hpx-isir-connections", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* give each worker its own ISIR send and receive path (MPI_THREAD_MULTIPLE).  */
+          else if (strcmp (long_options[option_index].name, "hpx-isir-multiple") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->hpx_isir_multiple_flag), 0, &(args_info->hpx_isir_multiple_given),
+                &(local_args_info.hpx_isir_multiple_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "hpx-isir-multiple", '-',
+                additional_error))
+              goto failure;
+          
           }
           /* set the size of p2p recv buffers for parcel sends.  */
           else if (strcmp (long_options[option_index].name, "hpx-pwc-parcelbuffersize") == 0)
@@ -2486,6 +2558,18 @@ hpx_option_parser_internal (
                 additional_error))
               goto failure;
           
+          }
+          /* let any process on the host ptrace this one (pwc shm transport).  */
+          else if (strcmp (long_options[option_index].name, "hpx-pwc-ptraceany") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->hpx_pwc_ptraceany_flag), 0, &(args_info->hpx_pwc_ptraceany_given),
+                &(local_args_info.hpx_pwc_ptraceany_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "hpx-pwc-ptraceany", '-',
+                additional_error))
+              goto failure;
+          
           }
           /* set collective implementation to network based version (override parcel collectives).  */
           else if (strcmp (long_options[option_index].name, "hpx-coll-network") == 0)
@@ -2498,6 +2582,20 @@ hpx_option_parser_internal (
                 additional_error))
               goto failure;
           
+          }
+          /* fan-out of the process collective trees (0 selects a flat tree).  */
+          else if (strcmp (long_options[option_index].name, "hpx-coll-radix") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_coll_radix_arg), 
+                 &(args_info->hpx_coll_radix_orig), &(args_info->hpx_coll_radix_given),
+                &(local_args_info.hpx_coll_radix_given), optarg, 0, 0, ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "hpx-coll-radix", '-',
+                additional_error))
+              goto failure;
+          
           }
           /* request completion ordering mode.  */
           else if (strcmp (long_options[option_index].name, "hpx-photon-comporder") == 0)
@@ -2802,6 +2900,34 @@ hpx_option_parser_internal (
                 additional_error))
               goto failure;
           
+          }
+          /* flush a destination at this many coalesced bytes.  */
+          else if (strcmp (long_options[option_index].name, "hpx-coalescing-bytes") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_coalescing_bytes_arg), 
+                 &(args_info->hpx_coalescing_bytes_orig), &(args_info->hpx_coalescing_bytes_given),
+                &(local_args_info.hpx_coalescing_bytes_given), optarg, 0, 0, ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "hpx-coalescing-bytes", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* flush coalesced parcels after this many microseconds.  */
+          else if (strcmp (long_options[option_index].name, "hpx-coalescing-usecs") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_coalescing_usecs_arg), 
+                 &(args_info->hpx_coalescing_usecs_orig), &(args_info->hpx_coalescing_usecs_given),
+                &(local_args_info.hpx_coalescing_usecs_given), optarg, 0, 0, ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "hpx-coalescing-usecs", '-',
+                additional_error))
+              goto failure;
+          
           }
           
           break;
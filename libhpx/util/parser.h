@@ -39,9 +39,9 @@ extern "C" {
 #endif
 
 enum enum_hpx_gas { hpx_gas__NULL = -1, hpx_gas_arg_default = 0, hpx_gas_arg_smp, hpx_gas_arg_pgas, hpx_gas_arg_agas };
-enum enum_hpx_boot { hpx_boot__NULL = -1, hpx_boot_arg_default = 0, hpx_boot_arg_smp, hpx_boot_arg_mpi, hpx_boot_arg_pmi };
+enum enum_hpx_boot { hpx_boot__NULL = -1, hpx_boot_arg_default = 0, hpx_boot_arg_smp, hpx_boot_arg_mpi, hpx_boot_arg_pmi, hpx_boot_arg_tcp };
 enum enum_hpx_transport { hpx_transport__NULL = -1, hpx_transport_arg_default = 0, hpx_transport_arg_mpi, hpx_transport_arg_photon };
-enum enum_hpx_network { hpx_network__NULL = -1, hpx_network_arg_default = 0, hpx_network_arg_smp, hpx_network_arg_pwc, hpx_network_arg_isir };
+enum enum_hpx_network { hpx_network__NULL = -1, hpx_network_arg_default = 0, hpx_network_arg_smp, hpx_network_arg_pwc, hpx_network_arg_isir, hpx_network_arg_shm };
 enum enum_hpx_thread_affinity { hpx_thread_affinity__NULL = -1, hpx_thread_affinity_arg_default = 0, hpx_thread_affinity_arg_hwthread, hpx_thread_affinity_arg_core, hpx_thread_affinity_arg_numa, hpx_thread_affinity_arg_none };
 enum enum_hpx_sched_policy { hpx_sched_policy__NULL = -1, hpx_sched_policy_arg_default = 0, hpx_sched_policy_arg_random, hpx_sched_policy_arg_hier };
 enum enum_hpx_gas_affinity { hpx_gas_affinity__NULL = -1, hpx_gas_affinity_arg_none = 0, hpx_gas_affinity_arg_urcu, hpx_gas_affinity_arg_cuckoo };
@@ -158,14 +158,24 @@ struct hpx_options_t
   long hpx_isir_recvlimit_arg;	/**< @brief ISIR network recv limit.  */
   char * hpx_isir_recvlimit_orig;	/**< @brief ISIR network recv limit original value given at command line.  */
   const char *hpx_isir_recvlimit_help; /**< @brief ISIR network recv limit help description.  */
+  long hpx_isir_connections_arg;	/**< @brief ISIR TCP connections per peer.  */
+  char * hpx_isir_connections_orig;	/**< @brief ISIR TCP connections per peer original value given at command line.  */
+  const char *hpx_isir_connections_help; /**< @brief ISIR TCP connections per peer help description.  */
+  int hpx_isir_multiple_flag;	/**< @brief give each worker its own ISIR send and receive path (MPI_THREAD_MULTIPLE) (default=off).  */
+  const char *hpx_isir_multiple_help; /**< @brief give each worker its own ISIR send and receive path (MPI_THREAD_MULTIPLE) help description.  */
   long hpx_pwc_parcelbuffersize_arg;	/**< @brief set the size of p2p recv buffers for parcel sends.  */
   char * hpx_pwc_parcelbuffersize_orig;	/**< @brief set the size of p2p recv buffers for parcel sends original value given at command line.  */
   const char *hpx_pwc_parcelbuffersize_help; /**< @brief set the size of p2p recv buffers for parcel sends help description.  */
   long hpx_pwc_parceleagerlimit_arg;	/**< @brief set the largest eager parcel size (header inclusive).  */
   char * hpx_pwc_parceleagerlimit_orig;	/**< @brief set the largest eager parcel size (header inclusive) original value given at command line.  */
   const char *hpx_pwc_parceleagerlimit_help; /**< @brief set the largest eager parcel size (header inclusive) help description.  */
+  int hpx_pwc_ptraceany_flag;	/**< @brief let any process on the host ptrace this one (pwc shm transport) (default=off).  */
+  const char *hpx_pwc_ptraceany_help; /**< @brief let any process on the host ptrace this one (pwc shm transport) help description.  */
   int hpx_coll_network_flag;	/**< @brief set collective implementation to network based version (override parcel collectives) (default=off).  */
   const char *hpx_coll_network_help; /**< @brief set collective implementation to network based version (override parcel collectives) help description.  */
+  long hpx_coll_radix_arg;	/**< @brief fan-out of the process collective trees (0 selects a flat tree).  */
+  char * hpx_coll_radix_orig;	/**< @brief fan-out of the process collective trees (0 selects a flat tree) original value given at command line.  */
+  const char *hpx_coll_radix_help; /**< @brief fan-out of the process collective trees (0 selects a flat tree) help description.  */
   enum enum_hpx_photon_comporder hpx_photon_comporder_arg;	/**< @brief request completion ordering mode.  */
   char * hpx_photon_comporder_orig;	/**< @brief request completion ordering mode original value given at command line.  */
   const char *hpx_photon_comporder_help; /**< @brief request completion ordering mode help description.  */
@@ -230,6 +240,12 @@ struct hpx_options_t
   long hpx_coalescing_buffersize_arg;	/**< @brief set coalescing buffer size.  */
   char * hpx_coalescing_buffersize_orig;	/**< @brief set coalescing buffer size original value given at command line.  */
   const char *hpx_coalescing_buffersize_help; /**< @brief set coalescing buffer size help description.  */
+  long hpx_coalescing_bytes_arg;	/**< @brief flush a destination at this many coalesced bytes.  */
+  char * hpx_coalescing_bytes_orig;	/**< @brief flush a destination at this many coalesced bytes original value given at command line.  */
+  const char *hpx_coalescing_bytes_help; /**< @brief flush a destination at this many coalesced bytes help description.  */
+  long hpx_coalescing_usecs_arg;	/**< @brief flush coalesced parcels after this many microseconds.  */
+  char * hpx_coalescing_usecs_orig;	/**< @brief flush coalesced parcels after this many microseconds original value given at command line.  */
+  const char *hpx_coalescing_usecs_help; /**< @brief flush coalesced parcels after this many microseconds help description.  */
   
   unsigned int hpx_help_given ;	/**< @brief Whether hpx-help was given.  */
   unsigned int hpx_version_given ;	/**< @brief Whether hpx-version was given.  */
@@ -263,9 +279,13 @@ struct hpx_options_t
   unsigned int hpx_isir_testwindow_given ;	/**< @brief Whether hpx-isir-testwindow was given.  */
   unsigned int hpx_isir_sendlimit_given ;	/**< @brief Whether hpx-isir-sendlimit was given.  */
   unsigned int hpx_isir_recvlimit_given ;	/**< @brief Whether hpx-isir-recvlimit was given.  */
+  unsigned int hpx_isir_connections_given ;	/**< @brief Whether hpx-isir-connections was given.  */
+  unsigned int hpx_isir_multiple_given ;	/**< @brief Whether hpx-isir-multiple was given.  */
   unsigned int hpx_pwc_parcelbuffersize_given ;	/**< @brief Whether hpx-pwc-parcelbuffersize was given.  */
   unsigned int hpx_pwc_parceleagerlimit_given ;	/**< @brief Whether hpx-pwc-parceleagerlimit was given.  */
+  unsigned int hpx_pwc_ptraceany_given ;	/**< @brief Whether hpx-pwc-ptraceany was given.  */
   unsigned int hpx_coll_network_given ;	/**< @brief Whether hpx-coll-network was given.  */
+  unsigned int hpx_coll_radix_given ;	/**< @brief Whether hpx-coll-radix was given.  */
   unsigned int hpx_photon_comporder_given ;	/**< @brief Whether hpx-photon-comporder was given.  */
   unsigned int hpx_photon_backend_given ;	/**< @brief Whether hpx-photon-backend was given.  */
   unsigned int hpx_photon_coll_given ;	/**< @brief Whether hpx-photon-coll was given.  */
@@ -288,6 +308,8 @@ struct hpx_options_t
   unsigned int hpx_opt_smp_given ;	/**< @brief Whether hpx-opt-smp was given.  */
   unsigned int hpx_parcel_compression_given ;	/**< @brief Whether hpx-parcel-compression was given.  */
   unsigned int hpx_coalescing_buffersize_given ;	/**< @brief Whether hpx-coalescing-buffersize was given.  */
+  unsigned int hpx_coalescing_bytes_given ;	/**< @brief Whether hpx-coalescing-bytes was given.  */
+  unsigned int hpx_coalescing_usecs_given ;	/**< @brief Whether hpx-coalescing-usecs was given.  */
 
 } ;
 
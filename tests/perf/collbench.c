@@ -25,6 +25,7 @@
 ///
 /// The included micro-benchmarks are:
 /// 1. allreduce
+/// 2. broadcast
 
 /// Allreduce "reduction" operations.
 static void _init_handler(unsigned char *id, const size_t size) {
@@ -127,6 +128,30 @@ static int _benchmark(char *name, hpx_action_t op, int iters, size_t size) {
   printf("%s: %.7f\n", name, elapsed/iters);
   return HPX_SUCCESS;
 }
+
+/// An empty broadcast target, so that we only measure the broadcast tree.
+static int _bcast_noop_handler(void *args, size_t size) {
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, HPX_MARSHALLED, _bcast_noop, _bcast_noop_handler,
+                  HPX_POINTER, HPX_SIZE_T);
+
+/// Time an rsync broadcast of a @p size byte payload to every locality.
+static int _benchmark_bcast(int iters, size_t size) {
+  unsigned char buf[size + 1];
+  for (int i = 0, e = size; i < e; ++i) {
+    buf[i] = rand();
+  }
+
+  hpx_time_t start = hpx_time_now();
+  for (int i = 0; i < iters; ++i) {
+    hpx_bcast_rsync(_bcast_noop, buf, size);
+  }
+  double elapsed = hpx_time_elapsed_ms(start);
+  printf("bcast(localities=%d): %.7f\n", HPX_LOCALITIES, elapsed/iters);
+  return HPX_SUCCESS;
+}
+
 #define _XSTR(s) _STR(s)
 #define _STR(l) #l
 #define _BENCHMARK(op, iters, size) _benchmark(_XSTR(op), op, iters, size)
@@ -140,6 +165,7 @@ static int _main_action(int iters, size_t size) {
   _BENCHMARK(_allreduce_set_get, iters, size);
   _BENCHMARK(_allreduce_join, iters, size);
   _BENCHMARK(_allreduce_join_sync, iters, size);
+  _benchmark_bcast(iters, size);
 
   hpx_exit(0, NULL);
 }
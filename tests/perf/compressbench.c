@@ -0,0 +1,122 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+/// Measure parcel compression over compressible and incompressible payloads.
+///
+/// Each rank sends a stream of parcels to its neighbor, for a range of payload
+/// sizes, with payloads that are all zeros and payloads that are random. The
+/// plain action is the baseline, the compressed action goes through the
+/// compression wrapper, and the batched action is both compressed and
+/// coalesced. Run with --hpx-parcel-compression, and with
+/// --hpx-coalescing-buffersize for the batched numbers.
+
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hpx/hpx.h"
+
+#define MAX_BYTES (1 << 20)
+
+static int _recv_handler(void *args, size_t size) {
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, HPX_MARSHALLED, _plain, _recv_handler,
+                  HPX_POINTER, HPX_SIZE_T);
+static HPX_ACTION(HPX_DEFAULT, HPX_MARSHALLED | HPX_COMPRESSED, _compressed,
+                  _recv_handler, HPX_POINTER, HPX_SIZE_T);
+static HPX_ACTION(HPX_DEFAULT,
+                  HPX_MARSHALLED | HPX_COMPRESSED | HPX_COALESCED, _batched,
+                  _recv_handler, HPX_POINTER, HPX_SIZE_T);
+
+static double _send(hpx_action_t op, const void *buf, size_t bytes, int iters) {
+  hpx_addr_t to = HPX_THERE((HPX_LOCALITY_ID + 1) % HPX_LOCALITIES);
+  hpx_addr_t done = hpx_lco_and_new(iters);
+  hpx_time_t start = hpx_time_now();
+  for (int i = 0; i < iters; ++i) {
+    hpx_call(to, op, done, buf, bytes);
+  }
+  hpx_lco_wait(done);
+  double elapsed = hpx_time_elapsed_us(start);
+  hpx_lco_delete(done, HPX_NULL);
+  return elapsed / iters;
+}
+
+static int _main_action(int iters) {
+  if (HPX_LOCALITIES < 2) {
+    printf("compressbench needs at least two localities\n");
+    hpx_exit(0, NULL);
+  }
+
+  char *zeros = calloc(MAX_BYTES, 1);
+  char *random = malloc(MAX_BYTES);
+  for (int i = 0; i < MAX_BYTES; ++i) {
+    random[i] = rand();
+  }
+
+  printf("%-10s %-8s %12s %12s %12s\n", "bytes", "payload", "plain(us)",
+         "compressed", "batched");
+  for (size_t bytes = 64; bytes <= MAX_BYTES; bytes *= 4) {
+    const char *names[] = { "zeros", "random" };
+    const char *bufs[] = { zeros, random };
+    for (int j = 0; j < 2; ++j) {
+      double plain = _send(_plain, bufs[j], bytes, iters);
+      double compressed = _send(_compressed, bufs[j], bytes, iters);
+      double batched = _send(_batched, bufs[j], bytes, iters);
+      printf("%-10zu %-8s %12.3f %12.3f %12.3f\n", bytes, names[j], plain,
+             compressed, batched);
+    }
+  }
+
+  free(random);
+  free(zeros);
+  hpx_exit(0, NULL);
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _main, _main_action, HPX_INT);
+
+static void
+_usage(FILE *f) {
+  fprintf(f, "Usage: compressbench [options]\n"
+          "\t-i, iterations per size (default 1000)\n"
+          "\t-h, show help\n");
+  hpx_print_help();
+  fflush(f);
+}
+
+int main(int argc, char *argv[argc]) {
+  if (hpx_init(&argc, &argv)) {
+    fprintf(stderr, "HPX failed to initialize.\n");
+    return -1;
+  }
+
+  int iters = 1000;
+  int opt = 0;
+  while ((opt = getopt(argc, argv, "i:h?")) != -1) {
+    switch (opt) {
+     case 'i':
+      iters = atoi(optarg);
+      break;
+     case 'h':
+     case '?':
+      _usage(stdout);
+      return 0;
+     default:
+      _usage(stderr);
+      return -1;
+    }
+  }
+
+  int e = hpx_run(&_main, NULL, &iters);
+  hpx_finalize();
+  return e;
+}
@@ -0,0 +1,86 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <hpx/hpx.h>
+
+#define BENCHMARK "HPX COST OF REMOTE LCO GET AND WAIT"
+
+#define HEADER "# " BENCHMARK "\n"
+#define FIELD_WIDTH 12
+#define ITERS 1000
+
+/// The value sizes to measure, spanning the stack and registered paths.
+static size_t sizes[] = {
+  0,
+  8,
+  1024,
+  16384,
+  262144
+};
+
+static int _new_future_handler(size_t size) {
+  hpx_addr_t f = hpx_lco_future_new(size);
+  return HPX_THREAD_CONTINUE(f);
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _new_future, _new_future_handler,
+                  HPX_SIZE_T);
+
+static int _main_handler(void) {
+  printf(HEADER);
+  printf("# Latency in (us) per operation\n");
+  printf("%s%*s%*s\n", "# Bytes ", FIELD_WIDTH, "get", FIELD_WIDTH, "wait");
+
+  // Use a future on the next locality so that each operation is remote.
+  hpx_addr_t there = HPX_THERE((HPX_LOCALITY_ID + 1) % HPX_LOCALITIES);
+  for (int i = 0, e = sizeof(sizes)/sizeof(sizes[0]); i < e; ++i) {
+    size_t n = sizes[i];
+    hpx_addr_t f;
+    hpx_call_sync(there, _new_future, &f, sizeof(f), &n);
+    char *buffer = calloc(1, n + 1);
+    hpx_lco_set_rsync(f, n, buffer);
+
+    printf("%zu\t", n);
+    hpx_time_t t = hpx_time_now();
+    for (int j = 0; j < ITERS; ++j) {
+      hpx_lco_get(f, n, buffer);
+    }
+    printf("%*g", FIELD_WIDTH, hpx_time_elapsed_us(t) / ITERS);
+
+    t = hpx_time_now();
+    for (int j = 0; j < ITERS; ++j) {
+      hpx_lco_wait(f);
+    }
+    printf("%*g\n", FIELD_WIDTH, hpx_time_elapsed_us(t) / ITERS);
+
+    free(buffer);
+    hpx_lco_delete_sync(f);
+  }
+
+  hpx_exit(0, NULL);
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _main, _main_handler);
+
+int main(int argc, char *argv[]) {
+  if (hpx_init(&argc, &argv)) {
+    fprintf(stderr, "HPX: failed to initialize.\n");
+    return 1;
+  }
+
+  // run the main action
+  int e = hpx_run(&_main, NULL);
+  hpx_finalize();
+  return e;
+}
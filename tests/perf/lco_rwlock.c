@@ -0,0 +1,134 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <hpx/hpx.h>
+
+#define BENCHMARK "HPX COST OF LCO READER-WRITER LOCKS"
+
+#define HEADER "# " BENCHMARK "\n"
+#define FIELD_WIDTH 12
+
+#define THREADS 64
+#define ITERS 10000
+#define WORDS 64
+
+/// The read percentages to measure.
+static int reads[] = {
+  90,
+  99
+};
+
+/// The state protected by the lock. Readers sum it and writers update every
+/// word, so each critical section does a fixed amount of work that a racing
+/// writer could actually disturb.
+static volatile int64_t _words[WORDS];
+
+/// Keeps the readers' sums live.
+static volatile int64_t _sink;
+
+static int64_t _read(void) {
+  int64_t sum = 0;
+  for (int i = 0; i < WORDS; ++i) {
+    sum += _words[i];
+  }
+  return sum;
+}
+
+static void _write(void) {
+  for (int i = 0; i < WORDS; ++i) {
+    _words[i] = _words[i] + 1;
+  }
+}
+
+static int _worker_handler(hpx_addr_t lock, int percent, int use_sema) {
+  unsigned seed = (unsigned)(uintptr_t)hpx_thread_current_parcel();
+  int64_t sum = 0;
+  for (int i = 0; i < ITERS; ++i) {
+    int read = (rand_r(&seed) % 100) < percent;
+    if (use_sema) {
+      hpx_lco_sema_p(lock);
+      if (read) {
+        sum += _read();
+      }
+      else {
+        _write();
+      }
+      hpx_lco_sema_v(lock, HPX_NULL);
+    }
+    else if (read) {
+      hpx_lco_rwlock_rdlock(lock);
+      sum += _read();
+      hpx_lco_rwlock_rdunlock(lock, HPX_NULL);
+    }
+    else {
+      hpx_lco_rwlock_wrlock(lock);
+      _write();
+      hpx_lco_rwlock_wrunlock(lock, HPX_NULL);
+    }
+  }
+  _sink = sum;
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _worker, _worker_handler, HPX_ADDR, HPX_INT,
+                  HPX_INT);
+
+static double _run(hpx_addr_t lock, int percent, int use_sema) {
+  hpx_time_t t = hpx_time_now();
+  hpx_addr_t done = hpx_lco_and_new(THREADS);
+  for (int i = 0; i < THREADS; ++i) {
+    hpx_call(HPX_HERE, _worker, done, &lock, &percent, &use_sema);
+  }
+  hpx_lco_wait(done);
+  hpx_lco_delete(done, HPX_NULL);
+  return hpx_time_elapsed_ms(t);
+}
+
+static int _main_handler(void) {
+  printf(HEADER);
+  printf("# %d threads, %d operations each, latency in (ms)\n", THREADS, ITERS);
+  printf("%s%*s%*s%*s\n", "# Reads ", FIELD_WIDTH, "sema", FIELD_WIDTH,
+         "rwlock", FIELD_WIDTH, "rwlock-wp");
+
+  for (int i = 0, e = sizeof(reads)/sizeof(reads[0]); i < e; ++i) {
+    printf("%d%%\t", reads[i]);
+
+    hpx_addr_t sema = hpx_lco_sema_new(1);
+    printf("%*g", FIELD_WIDTH, _run(sema, reads[i], 1));
+    hpx_lco_delete(sema, HPX_NULL);
+
+    for (int wp = 0; wp < 2; ++wp) {
+      hpx_addr_t lock = hpx_lco_rwlock_new(wp);
+      printf("%*g", FIELD_WIDTH, _run(lock, reads[i], 0));
+      hpx_lco_delete(lock, HPX_NULL);
+    }
+    printf("\n");
+  }
+
+  hpx_exit(0, NULL);
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _main, _main_handler);
+
+int main(int argc, char *argv[]) {
+  if (hpx_init(&argc, &argv)) {
+    fprintf(stderr, "HPX: failed to initialize.\n");
+    return 1;
+  }
+
+  // run the main action
+  int e = hpx_run(&_main, NULL);
+  hpx_finalize();
+  return e;
+}
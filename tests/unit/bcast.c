@@ -58,6 +58,38 @@ static int bcast_handler(void) {
 }
 static HPX_ACTION(HPX_DEFAULT, 0, bcast, bcast_handler);
 
+typedef struct {
+  hpx_addr_t and;
+  int        key;
+} _bcast_args_t;
+
+static int _bcast_marshalled_handler(const _bcast_args_t *args, size_t n) {
+  test_assert(n == sizeof(*args));
+  test_assert(args->key == 42);
+  hpx_lco_set(args->and, 0, NULL, HPX_NULL, HPX_NULL);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, HPX_MARSHALLED, _bcast_marshalled,
+                  _bcast_marshalled_handler, HPX_POINTER, HPX_SIZE_T);
+
+static int bcast_tree_handler(void) {
+  printf("Test hpx_bcast_rsync (marshalled)\n");
+  _bcast_args_t args = {
+    .and = hpx_lco_and_new(HPX_LOCALITIES),
+    .key = 42
+  };
+  int e = hpx_bcast_rsync(_bcast_marshalled, &args, sizeof(args));
+  test_assert(e == HPX_SUCCESS);
+
+  // Every locality should have run the action before rsync was set.
+  e = hpx_lco_wait(args.and);
+  test_assert(e == HPX_SUCCESS);
+  hpx_lco_delete(args.and, HPX_NULL);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, bcast_tree, bcast_tree_handler);
+
 TEST_MAIN({
     ADD_TEST(bcast, 0);
+    ADD_TEST(bcast_tree, 0);
 });
@@ -0,0 +1,110 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+
+#include <stdlib.h>
+#include <hpx/hpx.h>
+#include "tests.h"
+
+/// Identity for a summation.
+static void _zero_handler(int *input, size_t UNUSED) {
+  *input = 0;
+}
+static HPX_ACTION(HPX_FUNCTION, 0, _zero, _zero_handler);
+
+/// Integer summation.
+static void _sum_handler(int *lhs, const int *rhs, size_t UNUSED) {
+  *lhs += *rhs;
+}
+static HPX_ACTION(HPX_FUNCTION, 0, _sum, _sum_handler);
+
+/// Run each of the collectives at one locality and check the results.
+static int _spmd_handler(hpx_addr_t collective) {
+  int n = HPX_LOCALITIES;
+  int r = HPX_LOCALITY_ID;
+  int *values = calloc(n, sizeof(int));
+
+  int in = r + 1;
+  hpx_process_allgather(collective, sizeof(in), &in, values);
+  for (int i = 0; i < n; ++i) {
+    test_assert(values[i] == i + 1);
+  }
+
+  // locality r sends r * n + i to locality i
+  int *blocks = calloc(n, sizeof(int));
+  for (int i = 0; i < n; ++i) {
+    blocks[i] = r * n + i;
+  }
+  hpx_process_alltoall(collective, sizeof(int), blocks, values);
+  for (int i = 0; i < n; ++i) {
+    test_assert(values[i] == i * n + r);
+  }
+  free(blocks);
+
+  // locality r contributes (r + 1) * (i + 1) to block i
+  for (int i = 0; i < n; ++i) {
+    values[i] = (r + 1) * (i + 1);
+  }
+  int out = 0;
+  hpx_process_reduce_scatter(collective, sizeof(out), values, &out, _sum);
+  test_assert(out == (r + 1) * n * (n + 1) / 2);
+
+  hpx_process_scan(collective, sizeof(in), &in, &out, _zero, _sum);
+  test_assert(out == (r + 1) * (r + 2) / 2);
+
+  hpx_process_exscan(collective, sizeof(in), &in, &out, _zero, _sum);
+  test_assert(out == r * (r + 1) / 2);
+
+  hpx_process_allreduce(collective, sizeof(in), &in, &out, _sum);
+  test_assert(out == n * (n + 1) / 2);
+
+  // a persistent allreduce, with a blocking collective overlapping it
+  hpx_process_request_t *request =
+    hpx_process_allreduce_init(collective, sizeof(in), &in, &out, _sum);
+  for (int i = 0; i < 4; ++i) {
+    in = r + i;
+    hpx_process_request_start(request);
+    int sum = 0;
+    hpx_process_scan(collective, sizeof(sum), &i, &sum, _zero, _sum);
+    test_assert(sum == (r + 1) * i);
+    hpx_process_request_wait(request);
+    test_assert(out == n * (n - 1) / 2 + n * i);
+    test_assert(hpx_process_request_test(request));
+  }
+  hpx_process_request_free(request);
+
+  free(values);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _spmd, _spmd_handler, HPX_ADDR);
+
+static int collectives_handler(void) {
+  printf("Test process allgather, allreduce, alltoall, reduce-scatter, scan and "
+         "exscan\n");
+  hpx_addr_t collective = hpx_process_collective_new();
+  test_assert(collective != HPX_NULL);
+
+  // reuse the communicator for a few rounds of operations
+  for (int i = 0; i < 4; ++i) {
+    int e = hpx_bcast_rsync(_spmd, &collective);
+    test_assert(e == HPX_SUCCESS);
+  }
+
+  hpx_process_collective_delete(collective);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, collectives, collectives_handler);
+
+TEST_MAIN({
+    ADD_TEST(collectives, 0);
+});
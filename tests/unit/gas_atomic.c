@@ -0,0 +1,141 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include "hpx/hpx.h"
+#include "tests.h"
+
+/// @file tests/unit/gas_atomic.c
+///
+/// Tests the atomic operations on global words. We allocate one word per
+/// locality, and perform operations on both the local and a remote word.
+
+// The number of updates each locality performs in the concurrent tests.
+enum { UPDATES = 256 };
+
+static hpx_addr_t words = HPX_NULL;
+
+static hpx_addr_t word_at(int i) {
+  return hpx_addr_add(words, i * sizeof(int64_t), sizeof(int64_t));
+}
+
+static int _init_handler(hpx_addr_t base) {
+  words = base;
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _init, _init_handler, HPX_ADDR);
+
+static int init_globals_handler(void) {
+  hpx_addr_t base = hpx_gas_calloc_cyclic(HPX_LOCALITIES, sizeof(int64_t), 0);
+  test_assert_msg(base != HPX_NULL, "failed to allocate words\n");
+  CHECK( hpx_bcast_rsync(_init, &base) );
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, init_globals, init_globals_handler);
+
+static int fini_globals_handler(void) {
+  hpx_gas_free_sync(words);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, fini_globals, fini_globals_handler);
+
+/// Run the single-word operations against one word, leaving it at 0.
+static void test_word(hpx_addr_t word) {
+  int64_t old = 0;
+
+  test_assert(hpx_gas_atomic_fetch_sync(word, HPX_GAS_ATOMIC_ADD, 5) == 0);
+  test_assert(hpx_gas_atomic_fetch_sync(word, HPX_GAS_ATOMIC_ADD, -2) == 5);
+
+  hpx_addr_t f = hpx_lco_future_new(sizeof(old));
+  CHECK( hpx_gas_atomic_fetch(word, HPX_GAS_ATOMIC_MAX, 9, f) );
+  CHECK( hpx_lco_get(f, sizeof(old), &old) );
+  test_assert(old == 3);
+  hpx_lco_reset_sync(f);
+
+  CHECK( hpx_gas_atomic_fetch(word, HPX_GAS_ATOMIC_MIN, 4, f) );
+  CHECK( hpx_lco_get(f, sizeof(old), &old) );
+  test_assert(old == 9);
+  hpx_lco_reset_sync(f);
+
+  CHECK( hpx_gas_atomic_cas(word, 3, 7, f) );
+  CHECK( hpx_lco_get(f, sizeof(old), &old) );
+  test_assert(old == 4);
+  hpx_lco_delete_sync(f);
+
+  test_assert(hpx_gas_atomic_cas_sync(word, 4, 6) == 4);
+  test_assert(hpx_gas_atomic_fetch_sync(word, HPX_GAS_ATOMIC_XOR, 6) == 6);
+  test_assert(hpx_gas_atomic_fetch_sync(word, HPX_GAS_ATOMIC_OR, 0) == 0);
+}
+
+static int atomic_word_handler(void) {
+  int rank = HPX_LOCALITY_ID;
+  printf("Testing atomic operations on a local word\n");
+  test_word(word_at(rank));
+  printf("Testing atomic operations on a remote word\n");
+  test_word(word_at((rank + 1) % HPX_LOCALITIES));
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, atomic_word, atomic_word_handler);
+
+/// Every locality adds to every word with single and batched updates.
+static int _add_handler(void) {
+  int n = HPX_LOCALITIES;
+  for (int i = 0; i < UPDATES; ++i) {
+    hpx_gas_atomic_fetch_sync(word_at(i % n), HPX_GAS_ATOMIC_ADD, 1);
+  }
+
+  hpx_addr_t *addrs = calloc(UPDATES, sizeof(*addrs));
+  int64_t *values = calloc(UPDATES, sizeof(*values));
+  for (int i = 0; i < UPDATES; ++i) {
+    addrs[i] = word_at(i % n);
+    values[i] = 1;
+  }
+  hpx_addr_t done = hpx_lco_future_new(0);
+  CHECK( hpx_gas_atomic_batch(HPX_GAS_ATOMIC_ADD, UPDATES, addrs, values,
+                              done) );
+  free(addrs);
+  free(values);
+  CHECK( hpx_lco_wait(done) );
+  hpx_lco_delete_sync(done);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _add, _add_handler);
+
+static int atomic_concurrent_handler(void) {
+  printf("Testing concurrent atomic updates from every locality\n");
+  CHECK( hpx_bcast_rsync(_add) );
+
+  int n = HPX_LOCALITIES;
+  int64_t total = 0;
+  for (int i = 0; i < n; ++i) {
+    int64_t value;
+    CHECK( hpx_gas_memget_sync(&value, word_at(i), sizeof(value)) );
+    total += value;
+  }
+  if (total != 2 * UPDATES * n) {
+    fprintf(stderr, "expected %d updates, got %" PRId64 "\n", 2 * UPDATES * n,
+            total);
+    exit(EXIT_FAILURE);
+  }
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, atomic_concurrent, atomic_concurrent_handler);
+
+TEST_MAIN({
+    ADD_TEST(init_globals, 0);
+    ADD_TEST(atomic_word, 0);
+    ADD_TEST(atomic_word, 1 % HPX_LOCALITIES);
+    ADD_TEST(atomic_concurrent, 0);
+    ADD_TEST(fini_globals, 0);
+  });
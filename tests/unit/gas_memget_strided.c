@@ -0,0 +1,181 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <sys/uio.h>
+#include "hpx/hpx.h"
+#include "tests.h"
+
+// Each block is a ROWS x COLS matrix of elements.
+enum {
+  ROWS = 8,
+  COLS = 8,
+  ROW_BYTES = COLS * sizeof(uint64_t),
+  BLOCK_BYTES = ROWS * ROW_BYTES
+};
+
+hpx_addr_t   data = 0;
+hpx_addr_t  local = 0;
+hpx_addr_t remote = 0;
+
+static void fail(int i, uint64_t expected, uint64_t actual) {
+  fprintf(stderr, "failed to transfer element %d correctly, "
+          "expected %" PRIu64 ", got %" PRIu64 "\n", i, expected, actual);
+  exit(EXIT_FAILURE);
+}
+
+/// Initialize the global data for a rank.
+static int _init_handler(hpx_addr_t d) {
+  size_t n = BLOCK_BYTES;
+  int rank = HPX_LOCALITY_ID;
+  int peer = (rank + 1) % HPX_LOCALITIES;
+
+  data = d;
+  local = hpx_addr_add(data, rank * n, n);
+  remote = hpx_addr_add(data, peer * n, n);
+
+  uint64_t *buffer;
+  test_assert( hpx_gas_try_pin(local, (void**)&buffer) );
+  for (int i = 0; i < ROWS * COLS; ++i) {
+    buffer[i] = i;
+  }
+  hpx_gas_unpin(local);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _init, _init_handler, HPX_ADDR);
+
+static int init_globals_handler(void) {
+  size_t n = BLOCK_BYTES;
+  hpx_addr_t data = hpx_gas_alloc_cyclic(HPX_LOCALITIES, n, 0);
+  test_assert_msg(data != HPX_NULL, "failed to allocate data\n");
+
+  CHECK( hpx_bcast_rsync(_init, &data) );
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, init_globals, init_globals_handler);
+
+static int fini_globals_handler(void) {
+  hpx_gas_free_sync(data);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, fini_globals, fini_globals_handler);
+
+/// Get one column of a block into a contiguous buffer.
+static void test_get_column(hpx_addr_t block, int col) {
+  uint64_t buffer[ROWS] = {0};
+  hpx_addr_t lsync = hpx_lco_future_new(0);
+  hpx_addr_t from = hpx_addr_add(block, col * sizeof(uint64_t), BLOCK_BYTES);
+  CHECK( hpx_gas_memget_strided(buffer, sizeof(uint64_t), from, ROW_BYTES,
+                                sizeof(uint64_t), ROWS, lsync) );
+  CHECK( hpx_lco_wait(lsync) );
+  hpx_lco_delete_sync(lsync);
+  for (int i = 0; i < ROWS; ++i) {
+    if (buffer[i] != i * COLS + col) {
+      fail(i, i * COLS + col, buffer[i]);
+    }
+  }
+}
+
+/// Put a contiguous buffer into the last column of a block, and read it back.
+static void test_put_column(hpx_addr_t block) {
+  uint64_t buffer[ROWS];
+  for (int i = 0; i < ROWS; ++i) {
+    buffer[i] = 1000 + i;
+  }
+
+  hpx_addr_t lsync = hpx_lco_future_new(0);
+  hpx_addr_t rsync = hpx_lco_future_new(0);
+  hpx_addr_t to = hpx_addr_add(block, (COLS - 1) * sizeof(uint64_t),
+                               BLOCK_BYTES);
+  CHECK( hpx_gas_memput_strided(to, ROW_BYTES, buffer, sizeof(uint64_t),
+                                sizeof(uint64_t), ROWS, lsync, rsync) );
+  CHECK( hpx_lco_wait(lsync) );
+  CHECK( hpx_lco_wait(rsync) );
+  hpx_lco_delete_sync(lsync);
+  hpx_lco_delete_sync(rsync);
+
+  uint64_t matrix[ROWS * COLS];
+  CHECK( hpx_gas_memget_sync(matrix, block, sizeof(matrix)) );
+  for (int i = 0; i < ROWS * COLS; ++i) {
+    uint64_t expected = (i % COLS == COLS - 1) ? 1000 + i / COLS : i;
+    if (matrix[i] != expected) {
+      fail(i, expected, matrix[i]);
+    }
+  }
+
+  // Restore the column for later tests.
+  for (int i = 0; i < ROWS; ++i) {
+    buffer[i] = i * COLS + COLS - 1;
+  }
+  rsync = hpx_lco_future_new(0);
+  CHECK( hpx_gas_memput_strided(to, ROW_BYTES, buffer, sizeof(uint64_t),
+                                sizeof(uint64_t), ROWS, HPX_NULL, rsync) );
+  CHECK( hpx_lco_wait(rsync) );
+  hpx_lco_delete_sync(rsync);
+}
+
+/// Get the lower triangle of a block, packed, with one piece per row.
+static void test_get_triangle(hpx_addr_t block) {
+  uint64_t buffer[ROWS * (ROWS + 1) / 2] = {0};
+  struct iovec to[ROWS];
+  size_t offsets[ROWS];
+  for (int i = 0, k = 0; i < ROWS; k += ++i) {
+    to[i].iov_base = &buffer[k];
+    to[i].iov_len = (i + 1) * sizeof(uint64_t);
+    offsets[i] = i * ROW_BYTES;
+  }
+
+  hpx_addr_t lsync = hpx_lco_future_new(0);
+  CHECK( hpx_gas_memget_indexed(to, block, offsets, ROWS, lsync) );
+  CHECK( hpx_lco_wait(lsync) );
+  hpx_lco_delete_sync(lsync);
+  for (int i = 0, k = 0; i < ROWS; ++i) {
+    for (int j = 0; j <= i; ++j, ++k) {
+      if (buffer[k] != i * COLS + j) {
+        fail(k, i * COLS + j, buffer[k]);
+      }
+    }
+  }
+}
+
+static void test_all(hpx_addr_t block) {
+  for (int col = 0; col < COLS; ++col) {
+    test_get_column(block, col);
+  }
+  test_put_column(block);
+  test_get_triangle(block);
+}
+
+static int strided_local_handler(void) {
+  printf("Testing strided and indexed memget/memput with a local block\n");
+  test_all(local);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, strided_local, strided_local_handler);
+
+static int strided_remote_handler(void) {
+  printf("Testing strided and indexed memget/memput with a remote block\n");
+  test_all(remote);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, strided_remote, strided_remote_handler);
+
+TEST_MAIN({
+    ADD_TEST(init_globals, 0);
+    ADD_TEST(strided_local, 0);
+    ADD_TEST(strided_remote, 0);
+    ADD_TEST(strided_local, 1 % HPX_LOCALITIES);
+    ADD_TEST(strided_remote, 1 % HPX_LOCALITIES);
+    ADD_TEST(fini_globals, 0);
+  });
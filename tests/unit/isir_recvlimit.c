@@ -0,0 +1,58 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+// Runs the ISIR network with a receive limit that is smaller than its
+// preposted pool, and sends parcels in every size class as well as parcels
+// that are larger than the largest class. Each one must still be received.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <hpx/hpx.h>
+#include "tests.h"
+
+/// Select the ISIR network with a small receive limit before hpx_init() reads
+/// the environment.
+__attribute__((constructor))
+static void _use_isir(void) {
+  setenv("HPX_NETWORK", "isir", 1);
+  setenv("HPX_ISIR_RECVLIMIT", "8", 1);
+}
+
+static int _echo_handler(char *args, size_t n) {
+  return hpx_thread_continue(args, n);
+}
+static HPX_ACTION(HPX_DEFAULT, HPX_MARSHALLED, _echo,
+                  _echo_handler, HPX_POINTER, HPX_SIZE_T);
+
+static int isir_recvlimit_handler(void) {
+  printf("Testing ISIR parcels of every size with a small receive limit\n");
+  int peer = (HPX_LOCALITY_ID + 1) % HPX_LOCALITIES;
+  for (size_t n = 8; n <= (1 << 18); n *= 2) {
+    char *send = malloc(n);
+    char *recv = malloc(n);
+    memset(send, n & 0xff, n);
+    memset(recv, 0, n);
+    CHECK( hpx_call_sync(HPX_THERE(peer), _echo, recv, n, send, n) );
+    test_assert_msg(!memcmp(send, recv, n), "data corruption\n");
+    free(send);
+    free(recv);
+  }
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, isir_recvlimit, isir_recvlimit_handler);
+
+TEST_MAIN({
+  ADD_TEST(isir_recvlimit, 0);
+  ADD_TEST(isir_recvlimit, 1 % HPX_LOCALITIES);
+});
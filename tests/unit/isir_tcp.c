@@ -0,0 +1,93 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+// Boots two localities on this host with the TCP bootstrapper and exchanges
+// parcels between them over the TCP ISIR transport. The test launches itself,
+// so it runs the same way whether or not make check uses a launcher.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <hpx/hpx.h>
+#include "tests.h"
+
+enum { RANKS = 2 };
+
+/// Start the localities, unless we are one of them already.
+///
+/// This runs before main(), and the launching process exits with the first
+/// nonzero status of its localities.
+__attribute__((constructor))
+static void _launch(void) {
+  if (getenv("HPX_TCP_ROOT")) {
+    return;
+  }
+
+  char root[64];
+  snprintf(root, sizeof(root), "localhost:%d", 20000 + getpid() % 10000);
+  pid_t pids[RANKS];
+  for (int i = 0; i < RANKS; ++i) {
+    if ((pids[i] = fork()) == 0) {
+      char rank[16], ranks[16];
+      snprintf(rank, sizeof(rank), "%d", i);
+      snprintf(ranks, sizeof(ranks), "%d", RANKS);
+      setenv("HPX_TCP_RANK", rank, 1);
+      setenv("HPX_TCP_RANKS", ranks, 1);
+      setenv("HPX_TCP_ROOT", root, 1);
+      setenv("HPX_NETWORK", "isir", 1);
+      execl("/proc/self/exe", "isir_tcp", (char*)NULL);
+      perror("failed to start a locality");
+      _exit(EXIT_FAILURE);
+    }
+  }
+
+  int status = EXIT_SUCCESS;
+  for (int i = 0; i < RANKS; ++i) {
+    int e;
+    if (waitpid(pids[i], &e, 0) < 0 || !WIFEXITED(e) || WEXITSTATUS(e)) {
+      status = EXIT_FAILURE;
+    }
+  }
+  _exit(status);
+}
+
+static int _echo_handler(char *args, size_t n) {
+  return hpx_thread_continue(args, n);
+}
+static HPX_ACTION(HPX_DEFAULT, HPX_MARSHALLED, _echo,
+                  _echo_handler, HPX_POINTER, HPX_SIZE_T);
+
+static int isir_tcp_handler(void) {
+  printf("Testing parcels between %d TCP localities\n", HPX_LOCALITIES);
+  test_assert(HPX_LOCALITIES == RANKS);
+  int peer = (HPX_LOCALITY_ID + 1) % HPX_LOCALITIES;
+  for (size_t n = 8; n <= (1 << 20); n *= 4) {
+    char *send = malloc(n);
+    char *recv = malloc(n);
+    memset(send, n & 0xff, n);
+    memset(recv, 0, n);
+    CHECK( hpx_call_sync(HPX_THERE(peer), _echo, recv, n, send, n) );
+    test_assert_msg(!memcmp(send, recv, n), "data corruption\n");
+    free(send);
+    free(recv);
+  }
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, isir_tcp, isir_tcp_handler);
+
+TEST_MAIN({
+  ADD_TEST(isir_tcp, 0);
+  ADD_TEST(isir_tcp, 1);
+});
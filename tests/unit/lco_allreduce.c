@@ -114,6 +114,20 @@ _join_sync_leaf_handler(hpx_addr_t allreduce, int i, int j, hpx_addr_t sum) {
 static HPX_ACTION(HPX_DEFAULT, 0, _join_sync_leaf, _join_sync_leaf_handler,
                   HPX_ADDR, HPX_INT, HPX_INT, HPX_ADDR);
 
+/// Use a set-getref pair for the allreduce leaf operation.
+static int
+_set_getref_leaf_handler(hpx_addr_t allreduce, int i, int j, hpx_addr_t sum) {
+  int *ref = NULL;
+  hpx_lco_set_lsync(allreduce, sizeof(j), &j, HPX_NULL);
+  CHECK( hpx_lco_getref(allreduce, sizeof(*ref), (void**)&ref) );
+  int r = *ref;
+  hpx_lco_release(allreduce, ref);
+  test_assert(r == HPX_LOCALITIES * N * (N + 1) / 2);
+  return hpx_call_cc(sum, hpx_lco_set_action, &r, sizeof(r));
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _set_getref_leaf, _set_getref_leaf_handler,
+                  HPX_ADDR, HPX_INT, HPX_INT, HPX_ADDR);
+
 /// Spawn the set-get test.
 static int _test_allreduce_set_get_handler(void) {
   return _test(_set_get_leaf);
@@ -121,6 +135,13 @@ static int _test_allreduce_set_get_handler(void) {
 static HPX_ACTION(HPX_DEFAULT, 0, _test_allreduce_set_get,
                   _test_allreduce_set_get_handler);
 
+/// Spawn the set-getref test.
+static int _test_allreduce_set_getref_handler(void) {
+  return _test(_set_getref_leaf);
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _test_allreduce_set_getref,
+                  _test_allreduce_set_getref_handler);
+
 /// Spawn the join test.
 static int _test_allreduce_join_handler(void) {
   return _test(_join_leaf);
@@ -144,6 +165,7 @@ static HPX_ACTION(HPX_DEFAULT, 0, _test_allreduce_join_sync,
 
 TEST_MAIN({
     ADD_TEST(_test_allreduce_set_get, 0);
+    ADD_TEST(_test_allreduce_set_getref, 0);
     ADD_TEST(_test_allreduce_join_async, 0);
     ADD_TEST(_test_allreduce_join_sync, 0);
     ADD_TEST(_test_allreduce_join, 0);
@@ -0,0 +1,106 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+// Goal of this testcase is to test the HPX LCO channels
+// 1. hpx_lco_chan_new -- Create a new bounded channel.
+// 2. hpx_lco_chan_send/send_n -- Send items, blocking while full.
+// 3. hpx_lco_chan_recv/recv_n/try_recv -- Receive items.
+// 4. hpx_lco_chan_close -- Close a channel and drain it.
+#include "hpx/hpx.h"
+#include "tests.h"
+
+#define ITEMS 64
+#define BATCH 8
+
+static int _producer_handler(hpx_addr_t chan, int id) {
+  int batch[BATCH];
+  for (int i = 0; i < ITEMS; i += BATCH) {
+    for (int j = 0; j < BATCH; ++j) {
+      batch[j] = id * ITEMS + i + j;
+    }
+    hpx_addr_t done = hpx_lco_future_new(0);
+    hpx_lco_chan_send_n(chan, BATCH, sizeof(int), batch, HPX_NULL, done);
+    test_assert(hpx_lco_wait(done) == HPX_SUCCESS);
+    hpx_lco_delete(done, HPX_NULL);
+  }
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _producer, _producer_handler, HPX_ADDR,
+                  HPX_INT);
+
+static int _consumer_handler(hpx_addr_t chan, int n) {
+  int sum = 0;
+  int buffer[BATCH];
+  while (n) {
+    int count = 0;
+    hpx_status_t status = hpx_lco_chan_recv_n(chan, BATCH, sizeof(int),
+                                              buffer, &count);
+    test_assert(status == HPX_SUCCESS);
+    test_assert(0 < count && count <= BATCH && count <= n);
+    for (int i = 0; i < count; ++i) {
+      sum += buffer[i];
+    }
+    n -= count;
+  }
+  return HPX_THREAD_CONTINUE(sum);
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _consumer, _consumer_handler, HPX_ADDR,
+                  HPX_INT);
+
+static int lco_chan_handler(void) {
+  printf("Starting the HPX LCO channel test\n");
+  hpx_time_t t1 = hpx_time_now();
+
+  // a small channel forces the producers to block
+  int n = HPX_LOCALITIES;
+  hpx_addr_t chan = hpx_lco_chan_new(4, sizeof(int));
+  hpx_addr_t producers = hpx_lco_and_new(n);
+  for (int i = 0; i < n; ++i) {
+    hpx_call(HPX_THERE(i), _producer, producers, &chan, &i);
+  }
+
+  // consume from the last locality, which may be remote
+  int total = n * ITEMS;
+  int sum = 0;
+  hpx_call_sync(HPX_THERE(n - 1), _consumer, &sum, sizeof(sum), &chan, &total);
+  test_assert(sum == (total - 1) * total / 2);
+  hpx_lco_wait(producers);
+  hpx_lco_delete(producers, HPX_NULL);
+
+  // try_recv on an empty channel does not block
+  int value = -1;
+  test_assert(hpx_lco_chan_try_recv(chan, sizeof(int), &value) ==
+              HPX_LCO_CHAN_EMPTY);
+
+  // closing drains the remaining items and then reports empty
+  value = 42;
+  test_assert(hpx_lco_chan_send_sync(chan, sizeof(int), &value) ==
+              HPX_SUCCESS);
+  hpx_lco_chan_close(chan, HPX_NULL);
+  test_assert(hpx_lco_chan_send_sync(chan, sizeof(int), &value) ==
+              HPX_LCO_ERROR);
+  value = 0;
+  test_assert(hpx_lco_chan_recv(chan, sizeof(int), &value) == HPX_SUCCESS);
+  test_assert(value == 42);
+  test_assert(hpx_lco_chan_recv(chan, sizeof(int), &value) ==
+              HPX_LCO_CHAN_EMPTY);
+
+  hpx_lco_delete(chan, HPX_NULL);
+  printf(" Elapsed: %g\n", hpx_time_elapsed_ms(t1));
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, lco_chan, lco_chan_handler);
+
+TEST_MAIN({
+  ADD_TEST(lco_chan, 0);
+});
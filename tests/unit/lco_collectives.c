@@ -110,6 +110,38 @@ static int lco_gather_handler(void) {
 }
 static HPX_ACTION(HPX_DEFAULT, 0, lco_gather, lco_gather_handler);
 
+// Read a gather by reference over a few rounds, with more than one reader.
+static int lco_gather_getref_handler(void) {
+  const int n = 4;
+  const int readers = 2;
+  hpx_addr_t gather = hpx_lco_gather_new(n, readers, sizeof(int));
+
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < n; ++i) {
+      int value = round * n + i;
+      hpx_lco_gather_setid(gather, i, sizeof(value), &value, HPX_NULL,
+                           HPX_NULL);
+    }
+
+    int *refs[readers];
+    for (int r = 0; r < readers; ++r) {
+      hpx_status_t e = hpx_lco_getref(gather, n * sizeof(int),
+                                      (void**)&refs[r]);
+      test_assert(e == HPX_SUCCESS);
+      for (int i = 0; i < n; ++i) {
+        test_assert(refs[r][i] == round * n + i);
+      }
+    }
+    for (int r = 0; r < readers; ++r) {
+      hpx_lco_release(gather, refs[r]);
+    }
+  }
+
+  hpx_lco_delete_sync(gather);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, lco_gather_getref, lco_gather_getref_handler);
+
 static HPX_ACTION_DECL(_advanceDomain_alltoall);
 static int _advanceDomain_alltoall_handler(Domain *domain, unsigned long epoch) {
   if (domain->maxCycles <= domain->cycle) {
@@ -173,5 +205,6 @@ static HPX_ACTION(HPX_DEFAULT, 0, lco_alltoall, lco_alltoall_handler);
 
 TEST_MAIN({
   ADD_TEST(lco_gather, 0);
+  ADD_TEST(lco_gather_getref, 0);
   ADD_TEST(lco_alltoall, 0);
 });
@@ -0,0 +1,87 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+// Goal of this testcase is to test the HPX dataflow LCO
+// 1. hpx_lco_dataflow_new -- Create a new dataflow LCO.
+// 2. hpx_lco_dataflow_add -- Add nodes with local and remote inputs.
+// 3. hpx_lco_wait -- Wait for all of the nodes to run.
+#include "hpx/hpx.h"
+#include "tests.h"
+
+static int _add_handler(int *inputs[], int n) {
+  int output = 0;
+  for (int i = 0; i < n; ++i) {
+    output += *inputs[i];
+  }
+  return HPX_THREAD_CONTINUE(output);
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _add, _add_handler, HPX_POINTER, HPX_INT);
+
+static int _new_future_handler(void) {
+  hpx_addr_t f = hpx_lco_future_new(sizeof(int));
+  return HPX_THREAD_CONTINUE(f);
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _new_future, _new_future_handler);
+
+static int lco_dataflow_handler(void) {
+  printf("Starting the HPX dataflow LCO test\n");
+  hpx_time_t t1 = hpx_time_now();
+
+  // a is remote when there is more than one locality
+  hpx_addr_t a;
+  hpx_addr_t there = HPX_THERE((HPX_LOCALITY_ID + 1) % HPX_LOCALITIES);
+  hpx_call_sync(there, _new_future, &a, sizeof(a));
+  hpx_addr_t b = hpx_lco_future_new(sizeof(int));
+  hpx_addr_t c = hpx_lco_future_new(sizeof(int));
+  hpx_addr_t d = hpx_lco_future_new(sizeof(int));
+
+  // c = a + b, d = a + b + c
+  hpx_addr_t df = hpx_lco_dataflow_new();
+  hpx_lco_dataflow_add(df, _add, d, a, sizeof(int), b, sizeof(int), c,
+                       sizeof(int));
+  hpx_lco_dataflow_add(df, _add, c, a, sizeof(int), b, sizeof(int));
+
+  int x = 1, y = 2;
+  hpx_lco_set(b, sizeof(y), &y, HPX_NULL, HPX_NULL);
+  hpx_lco_set(a, sizeof(x), &x, HPX_NULL, HPX_NULL);
+
+  // the dataflow LCO is set once both nodes have run
+  test_assert(hpx_lco_wait(df) == HPX_SUCCESS);
+
+  int z = 0;
+  test_assert(hpx_lco_get(d, sizeof(z), &z) == HPX_SUCCESS);
+  test_assert(z == 6);
+
+  // errors in an input are forwarded to the output
+  hpx_addr_t e = hpx_lco_future_new(sizeof(int));
+  hpx_addr_t f = hpx_lco_future_new(sizeof(int));
+  hpx_lco_dataflow_add(df, _add, f, e, sizeof(int));
+  hpx_lco_error(e, HPX_USER, HPX_NULL);
+  test_assert(hpx_lco_get(f, sizeof(z), &z) == HPX_USER);
+  test_assert(hpx_lco_wait(df) == HPX_SUCCESS);
+
+  hpx_lco_delete_sync(a);
+  hpx_lco_delete_sync(b);
+  hpx_lco_delete_sync(c);
+  hpx_lco_delete_sync(d);
+  hpx_lco_delete_sync(e);
+  hpx_lco_delete_sync(f);
+  hpx_lco_delete_sync(df);
+  printf(" Elapsed: %g\n", hpx_time_elapsed_ms(t1));
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, lco_dataflow, lco_dataflow_handler);
+
+TEST_MAIN({
+  ADD_TEST(lco_dataflow, 0);
+});
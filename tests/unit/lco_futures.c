@@ -104,7 +104,183 @@ static int lco_future_array_handler(void) {
 }
 static HPX_ACTION(HPX_DEFAULT, 0, lco_future_array, lco_future_array_handler);
 
+// This testcase tests the hpx_lco_get_any and hpx_lco_wait_any API functions,
+// which return the index of the first future in the set that was set.
+static int lco_future_any_handler(void) {
+  printf("Starting the future any test\n");
+  int count = HPX_LOCALITIES + 1;
+  uint64_t values[count];
+  void *addresses[count];
+  size_t sizes[count];
+  hpx_addr_t futures[count];
+  hpx_status_t statuses[count];
+
+  // allocate and start a timer
+  hpx_time_t t1 = hpx_time_now();
+
+  for (int i = 0; i < count; i++) {
+    values[i] = 0;
+    addresses[i] = &values[i];
+    sizes[i] = sizeof(uint64_t);
+    futures[i] = hpx_lco_future_new(sizeof(uint64_t));
+  }
+
+  // only set the last future, so it must be the one that we get
+  int last = count - 1;
+  hpx_call(HPX_THERE(last % HPX_LOCALITIES), _get_future_value, futures[last]);
+
+  hpx_status_t status = HPX_ERROR;
+  int first = hpx_lco_get_any(count, futures, sizes, addresses, &status);
+  test_assert(first == last);
+  test_assert(status == HPX_SUCCESS);
+  test_assert(values[last] == SET_VALUE);
+  test_assert(values[0] == 0);
+
+  // a null entry is ignored
+  hpx_addr_t null[] = { HPX_NULL, futures[last] };
+  test_assert(hpx_lco_wait_any(2, null, NULL) == 1);
+
+  // set the rest of the futures and wait for all of them
+  for (int i = 0; i < last; i++) {
+    hpx_call(HPX_THERE(i % HPX_LOCALITIES), _get_future_value, futures[i]);
+  }
+  test_assert(hpx_lco_get_all(count, futures, sizes, addresses, statuses) == 0);
+  for (int i = 0; i < count; i++) {
+    test_assert(statuses[i] == HPX_SUCCESS);
+    test_assert(values[i] == SET_VALUE);
+    hpx_lco_delete(futures[i], HPX_NULL);
+  }
+
+  printf(" Elapsed: %g\n", hpx_time_elapsed_ms(t1));
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, lco_future_any, lco_future_any_handler);
+
+static int _new_future_handler(void) {
+  hpx_addr_t future = hpx_lco_future_new(sizeof(uint64_t));
+  return HPX_THREAD_CONTINUE(future);
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _new_future, _new_future_handler);
+
+static int _new_sema_handler(void) {
+  hpx_addr_t sema = hpx_lco_sema_new(1);
+  return HPX_THREAD_CONTINUE(sema);
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _new_sema, _new_sema_handler);
+
+// This testcase leaves the losers of hpx_lco_get_any untriggered, both local
+// and remote ones, and then deletes them. The registrations with the losers
+// must have been detached by the time get_any returns.
+static int lco_future_any_losers_handler(void) {
+  printf("Starting the future any losers test\n");
+  enum { COUNT = 3, ITERS = 64 };
+  hpx_addr_t remote = HPX_THERE(1 % HPX_LOCALITIES);
+
+  for (int i = 0; i < ITERS; i++) {
+    hpx_addr_t futures[COUNT];
+    uint64_t values[COUNT] = {0};
+    void *addresses[COUNT];
+    size_t sizes[COUNT];
+    futures[0] = hpx_lco_future_new(sizeof(uint64_t));
+    for (int j = 1; j < COUNT; j++) {
+      CHECK( hpx_call_sync(remote, _new_future, &futures[j],
+                           sizeof(futures[j])) );
+    }
+    for (int j = 0; j < COUNT; j++) {
+      addresses[j] = &values[j];
+      sizes[j] = sizeof(uint64_t);
+    }
+
+    int winner = i % COUNT;
+    uint64_t value = SET_VALUE + i;
+    CHECK( hpx_lco_set_rsync(futures[winner], sizeof(value), &value) );
+
+    hpx_status_t status = HPX_ERROR;
+    int first = hpx_lco_get_any(COUNT, futures, sizes, addresses, &status);
+    test_assert(first == winner);
+    test_assert(status == HPX_SUCCESS);
+    test_assert(values[winner] == value);
+
+    for (int j = 0; j < COUNT; j++) {
+      hpx_lco_delete_sync(futures[j]);
+    }
+  }
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, lco_future_any_losers,
+                  lco_future_any_losers_handler);
+
+// This testcase passes LCOs that wait_any doesn't support, which must fail
+// without acquiring them, along with an array of null entries.
+static int lco_future_any_unsupported_handler(void) {
+  printf("Starting the future any unsupported test\n");
+  hpx_addr_t future = hpx_lco_future_new(0);
+  hpx_addr_t semas[2];
+  semas[0] = hpx_lco_sema_new(1);
+  CHECK( hpx_call_sync(HPX_THERE(1 % HPX_LOCALITIES), _new_sema, &semas[1],
+                       sizeof(semas[1])) );
+
+  for (int i = 0; i < 2; i++) {
+    hpx_addr_t lcos[] = { future, semas[i] };
+    hpx_status_t status = HPX_SUCCESS;
+    test_assert(hpx_lco_wait_any(2, lcos, &status) == -1);
+    test_assert(status == HPX_ERROR);
+
+    // the semaphore was not acquired, so this does not block
+    CHECK( hpx_lco_sema_p(semas[i]) );
+    hpx_lco_sema_v_sync(semas[i]);
+    hpx_lco_delete_sync(semas[i]);
+  }
+
+  hpx_addr_t null[] = { HPX_NULL, HPX_NULL };
+  hpx_status_t status = HPX_SUCCESS;
+  test_assert(hpx_lco_wait_any(2, null, &status) == -1);
+  test_assert(status == HPX_ERROR);
+
+  hpx_lco_delete_sync(future);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, lco_future_any_unsupported,
+                  lco_future_any_unsupported_handler);
+
+// This testcase waits for futures that are already in an error state, each of
+// which must be counted exactly once.
+static int lco_future_error_handler(void) {
+  printf("Starting the future error test\n");
+  enum { COUNT = 4 };
+  hpx_addr_t futures[COUNT];
+  hpx_status_t statuses[COUNT];
+
+  for (int i = 0; i < COUNT; i++) {
+    futures[i] = hpx_lco_future_new(0);
+  }
+
+  // error half of the futures before waiting, and set the others
+  for (int i = 0; i < COUNT; i++) {
+    if (i % 2) {
+      hpx_lco_error_sync(futures[i], HPX_ERROR);
+    }
+    else {
+      hpx_lco_set_rsync(futures[i], 0, NULL);
+    }
+  }
+
+  test_assert(hpx_lco_wait_all(COUNT, futures, NULL) == COUNT / 2);
+  test_assert(hpx_lco_wait_all(COUNT, futures, statuses) == COUNT / 2);
+  for (int i = 0; i < COUNT; i++) {
+    test_assert(statuses[i] == ((i % 2) ? HPX_ERROR : HPX_SUCCESS));
+    hpx_lco_delete(futures[i], HPX_NULL);
+  }
+
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, lco_future_error, lco_future_error_handler);
+
 TEST_MAIN({
  ADD_TEST(lco_future_new, 0);
  ADD_TEST(lco_future_array, 0);
+ ADD_TEST(lco_future_any, 0);
+ ADD_TEST(lco_future_any_losers, 0);
+ ADD_TEST(lco_future_any_unsupported, 0);
+ ADD_TEST(lco_future_error, 0);
 });
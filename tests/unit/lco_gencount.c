@@ -145,9 +145,46 @@ static int _multi_wait_N_handler(void) {
 }
 static HPX_ACTION(HPX_DEFAULT, 0, _multi_wait_N, _multi_wait_N_handler);
 
+static int _wait_get_handler(unsigned long i) {
+  hpx_addr_t counter = hpx_thread_current_target();
+  unsigned long current = 0;
+  hpx_status_t e = hpx_lco_gencount_wait_get(counter, i, &current);
+  if (e == HPX_SUCCESS && current < i) {
+    fprintf(stderr, "woke at generation %lu waiting for %lu\n", current, i);
+    return HPX_ERROR;
+  }
+  return e;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _wait_get, _wait_get_handler, HPX_ULONG);
+
+// Advance the counter in strides so that waiters have their generations
+// skipped, and most of them wait beyond the in-place window.
+static int _inc_by_handler(void) {
+  printf("Starting _inc_by\n");
+  unsigned long stride = 7;
+  hpx_addr_t counter = hpx_lco_gencount_new(2);
+  hpx_addr_t done = hpx_lco_and_new(DEPTH);
+  for (unsigned long i = DEPTH; i > 0; --i) {
+    hpx_xcall(counter, _wait_get, done, i);
+  }
+  for (int i = 0; i * stride < DEPTH; ++i) {
+    hpx_lco_gencount_inc_by(counter, stride, HPX_NULL);
+  }
+  test_assert(hpx_lco_wait(done) == HPX_SUCCESS);
+
+  hpx_addr_t cleanup = hpx_lco_and_new(2);
+  hpx_lco_delete(counter, cleanup);
+  hpx_lco_delete(done, cleanup);
+  int e = hpx_call_cc(cleanup, hpx_lco_delete_action);
+  _done("");
+  return e;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _inc_by, _inc_by_handler);
+
 TEST_MAIN({
     ADD_TEST(_single_wait_0, 0);
     ADD_TEST(_single_wait_N, 0);
     ADD_TEST(_multi_wait_0, 0);
     ADD_TEST(_multi_wait_N, 0);
+    ADD_TEST(_inc_by, 0);
 });
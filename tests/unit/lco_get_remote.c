@@ -43,6 +43,24 @@ _lco_get_remote_handler(void) {
 }
 static HPX_ACTION(HPX_DEFAULT, 0, _lco_get_remote, _lco_get_remote_handler);
 
+static int
+_lco_error_remote_handler(void) {
+  int rank = (HPX_LOCALITY_ID + 1) % HPX_LOCALITIES;
+  hpx_addr_t there = HPX_THERE(rank);
+  hpx_addr_t lco;
+  int e = hpx_call_sync(there, _new_future, &lco, sizeof(lco));
+  test_assert(e == HPX_SUCCESS);
+  hpx_lco_error_sync(lco, HPX_USER);
+
+  // errors are returned to remote getters and waiters rather than aborting
+  int i = 0;
+  test_assert(hpx_lco_get(lco, sizeof(i), &i) == HPX_USER);
+  test_assert(hpx_lco_wait(lco) == HPX_USER);
+  return hpx_call_cc(lco, hpx_lco_delete_action);
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _lco_error_remote, _lco_error_remote_handler);
+
 TEST_MAIN({
     ADD_TEST(_lco_get_remote, 0);
+    ADD_TEST(_lco_error_remote, 0);
   });
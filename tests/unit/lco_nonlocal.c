@@ -0,0 +1,111 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+// Fills the local global heap so that local LCO allocations land at another
+// locality, which forces the LCO constructors down their remote construction
+// path. Each future must still be usable and distinct.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <hpx/hpx.h>
+#include "tests.h"
+
+/// Select AGAS with a small heap before hpx_init() reads the environment, so
+/// that local allocations fall back to other localities once the heap is full.
+__attribute__((constructor))
+static void _use_small_agas(void) {
+  setenv("HPX_GAS", "agas", 1);
+  setenv("HPX_HEAPSIZE", "67108864", 1);
+}
+
+// Enough futures to drain the worker's LCO block pool.
+#define FUTURES 256
+
+static hpx_addr_t *_blocks = NULL;
+static int _nblocks = 0;
+
+/// Allocate local blocks of decreasing size until each size lands remotely.
+static void _fill_heap(void) {
+  int capacity = 0;
+  for (size_t bsize = 1 << 20; bsize >= 64; bsize >>= 1) {
+    for (;;) {
+      if (_nblocks == capacity) {
+        capacity = (capacity) ? 2 * capacity : 1024;
+        _blocks = realloc(_blocks, capacity * sizeof(*_blocks));
+        test_assert(_blocks);
+      }
+      hpx_addr_t block = hpx_gas_alloc_local(1, bsize, 0);
+      test_assert(block != HPX_NULL);
+      _blocks[_nblocks++] = block;
+
+      void *local;
+      if (!hpx_gas_try_pin(block, &local)) {
+        break;
+      }
+      hpx_gas_unpin(block);
+    }
+  }
+}
+
+static void _free_heap(void) {
+  for (int i = 0; i < _nblocks; ++i) {
+    hpx_gas_free_sync(_blocks[i]);
+  }
+  free(_blocks);
+  _blocks = NULL;
+  _nblocks = 0;
+}
+
+static int lco_nonlocal_handler(void) {
+  printf("Testing futures constructed at another locality\n");
+  if (HPX_LOCALITIES < 2) {
+    printf("skipping, requires at least two localities\n");
+    return HPX_SUCCESS;
+  }
+
+  _fill_heap();
+
+  hpx_addr_t futures[FUTURES];
+  int remote = 0;
+  for (int i = 0; i < FUTURES; ++i) {
+    futures[i] = hpx_lco_future_new(sizeof(int));
+    test_assert(futures[i] != HPX_NULL);
+    void *local;
+    if (hpx_gas_try_pin(futures[i], &local)) {
+      hpx_gas_unpin(futures[i]);
+    }
+    else {
+      ++remote;
+    }
+  }
+  test_assert_msg(remote, "no future was allocated remotely\n");
+
+  for (int i = 0; i < FUTURES; ++i) {
+    hpx_lco_set_lsync(futures[i], sizeof(i), &i, HPX_NULL);
+  }
+
+  for (int i = 0; i < FUTURES; ++i) {
+    int value = -1;
+    CHECK( hpx_lco_get(futures[i], sizeof(value), &value) );
+    test_assert_msg(value == i, "future holds the wrong value\n");
+    hpx_lco_delete_sync(futures[i]);
+  }
+
+  _free_heap();
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, lco_nonlocal, lco_nonlocal_handler);
+
+TEST_MAIN({
+  ADD_TEST(lco_nonlocal, 0);
+});
@@ -0,0 +1,95 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+// Goal of this testcase is to test the HPX LCO reader-writer locks
+// 1. hpx_lco_rwlock_new -- Create a new lock.
+// 2. hpx_lco_rwlock_rdlock/rdunlock -- Shared acquire and release.
+// 3. hpx_lco_rwlock_wrlock/wrunlock -- Exclusive acquire and release.
+#include "hpx/hpx.h"
+#include "tests.h"
+
+#define THREADS 32
+#define ITERS 100
+
+// both halves are updated by writers with a yield in between, so readers that
+// see them differ have raced with a writer
+static volatile int _a = 0;
+static volatile int _b = 0;
+
+static int _reader_handler(hpx_addr_t lock) {
+  for (int i = 0; i < ITERS; ++i) {
+    test_assert(hpx_lco_rwlock_rdlock(lock) == HPX_SUCCESS);
+    int a = _a;
+    hpx_thread_yield();
+    test_assert(a == _b);
+    hpx_lco_rwlock_rdunlock(lock, HPX_NULL);
+  }
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _reader, _reader_handler, HPX_ADDR);
+
+static int _writer_handler(hpx_addr_t lock) {
+  for (int i = 0; i < ITERS; ++i) {
+    test_assert(hpx_lco_rwlock_wrlock(lock) == HPX_SUCCESS);
+    _a = _a + 1;
+    hpx_thread_yield();
+    _b = _b + 1;
+    hpx_lco_rwlock_wrunlock(lock, HPX_NULL);
+  }
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _writer, _writer_handler, HPX_ADDR);
+
+// remote threads just exercise the remote acquire and release paths
+static int _remote_handler(hpx_addr_t lock) {
+  for (int i = 0; i < ITERS; ++i) {
+    test_assert(hpx_lco_rwlock_rdlock(lock) == HPX_SUCCESS);
+    hpx_lco_rwlock_rdunlock(lock, HPX_NULL);
+    test_assert(hpx_lco_rwlock_wrlock(lock) == HPX_SUCCESS);
+    hpx_lco_rwlock_wrunlock(lock, HPX_NULL);
+  }
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _remote, _remote_handler, HPX_ADDR);
+
+static void _run(int writer_preference) {
+  hpx_addr_t lock = hpx_lco_rwlock_new(writer_preference);
+  hpx_addr_t done = hpx_lco_and_new(THREADS + HPX_LOCALITIES);
+  _a = _b = 0;
+  for (int i = 0; i < THREADS; ++i) {
+    hpx_action_t op = (i % 4) ? _reader : _writer;
+    hpx_call(HPX_HERE, op, done, &lock);
+  }
+  for (int i = 0; i < HPX_LOCALITIES; ++i) {
+    hpx_call(HPX_THERE(i), _remote, done, &lock);
+  }
+  hpx_lco_wait(done);
+  hpx_lco_delete(done, HPX_NULL);
+  test_assert(_a == _b);
+  test_assert(_a == (THREADS / 4) * ITERS);
+  hpx_lco_delete(lock, HPX_NULL);
+}
+
+static int lco_rwlock_handler(void) {
+  printf("Starting the HPX LCO reader-writer lock test\n");
+  hpx_time_t t1 = hpx_time_now();
+  _run(0);
+  _run(1);
+  printf(" Elapsed: %g\n", hpx_time_elapsed_ms(t1));
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, lco_rwlock, lco_rwlock_handler);
+
+TEST_MAIN({
+  ADD_TEST(lco_rwlock, 0);
+});
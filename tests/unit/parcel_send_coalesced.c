@@ -50,6 +50,21 @@ static int _checkcoalescing_action(void) {
   hpx_lco_wait(lco);
   hpx_lco_wait(done);
 
+  hpx_lco_delete(done, HPX_NULL);
+  hpx_lco_delete(lco, HPX_NULL);
+
+  // Tighten the limits for the action, so that the deadline and the byte limit
+  // flush the batches instead of the parcel count.
+  test_assert(hpx_action_set_coalescing(_set, 256, 10) == HPX_SUCCESS);
+  test_assert(hpx_action_set_coalescing(hpx_lco_set_action, 0, 0) != HPX_SUCCESS);
+  lco = hpx_lco_and_new(hpx_get_num_ranks());
+  done = hpx_lco_future_new(0);
+  count = 1;
+  hpx_bcast(_set, HPX_NULL, done, &lco, &count);
+
+  hpx_lco_wait(lco);
+  hpx_lco_wait(done);
+
   hpx_lco_delete(done, HPX_NULL);
   hpx_lco_delete(lco, HPX_NULL);
   printf("Coalescing test succeeded\n");
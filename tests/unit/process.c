@@ -66,6 +66,44 @@ static int process_handler(void) {
 }
 static HPX_ACTION(HPX_DEFAULT, 0, process, process_handler);
 
+// Enough spawns at each locality to fill a worker's credit cache.
+#define SPAWNS 1024
+
+static int _leaf_handler(void) {
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _leaf, _leaf_handler);
+
+static int _fanout_handler(int n) {
+  for (int i = 0; i < n; ++i) {
+    hpx_call(HPX_HERE, _leaf, HPX_NULL);
+  }
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _fanout, _fanout_handler, HPX_INT);
+
+// Credit returned away from the process's home locality is cached by the
+// returning worker and flushed up the credit tree, both eagerly when the cache
+// fills and from the yield queue, so termination depends on those flushes.
+static int process_cached_credit_handler(void) {
+  printf("Test hpx_lco_process with cached credit returns\n");
+
+  int n = SPAWNS;
+  hpx_addr_t psync = hpx_lco_future_new(0);
+  hpx_addr_t proc = hpx_process_new(psync);
+  for (int i = 0; i < HPX_LOCALITIES; ++i) {
+    hpx_process_call(proc, HPX_THERE(i), _fanout, HPX_NULL, &n);
+  }
+  CHECK( hpx_lco_wait(psync) );
+  hpx_lco_delete(psync, HPX_NULL);
+  hpx_process_delete(proc, HPX_NULL);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, process_cached_credit,
+                  process_cached_credit_handler);
+
 TEST_MAIN({
  ADD_TEST(process, 0);
+ ADD_TEST(process_cached_credit, 0);
+ ADD_TEST(process_cached_credit, 1 % HPX_LOCALITIES);
 });
@@ -0,0 +1,108 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+// Exercises the PWC network over the shared-memory transport on this host. The
+// network is forced to PWC, and the eager parcel, rendezvous parcel, and
+// put/get paths are each run against a peer locality.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <hpx/hpx.h>
+#include <libhpx/libhpx.h>
+#include "tests.h"
+
+/// Select the PWC network before hpx_init() reads the environment.
+__attribute__((constructor))
+static void _use_pwc(void) {
+  setenv("HPX_NETWORK", "pwc", 1);
+}
+
+static int _echo_handler(char *args, size_t n) {
+  return hpx_thread_continue(args, n);
+}
+static HPX_ACTION(HPX_DEFAULT, HPX_MARSHALLED, _echo,
+                  _echo_handler, HPX_POINTER, HPX_SIZE_T);
+
+static void _fill(char *buffer, size_t n, unsigned seed) {
+  for (size_t i = 0; i < n; ++i) {
+    buffer[i] = rand_r(&seed);
+  }
+}
+
+static void _check(const char *expected, const char *actual, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    if (expected[i] != actual[i]) {
+      fprintf(stderr, "data corruption at offset %zu of %zu\n", i, n);
+      exit(EXIT_FAILURE);
+    }
+  }
+}
+
+/// Send @p n bytes to the next locality and check that they come back.
+static void _echo_bytes(size_t n) {
+  char *send = malloc(n);
+  char *recv = malloc(n);
+  _fill(send, n, n);
+  int peer = (HPX_LOCALITY_ID + 1) % HPX_LOCALITIES;
+  CHECK( hpx_call_sync(HPX_THERE(peer), _echo, recv, n, send, n) );
+  _check(send, recv, n);
+  free(send);
+  free(recv);
+}
+
+static int pwc_shm_eager_handler(void) {
+  printf("Testing eager parcels over the shm transport\n");
+  _echo_bytes(64);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, pwc_shm_eager, pwc_shm_eager_handler);
+
+static int pwc_shm_rendezvous_handler(void) {
+  printf("Testing rendezvous parcels over the shm transport\n");
+  const libhpx_config_t *cfg = libhpx_get_config();
+  _echo_bytes(4 * cfg->pwc_parceleagerlimit);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, pwc_shm_rendezvous,
+                  pwc_shm_rendezvous_handler);
+
+static int pwc_shm_memput_memget_handler(void) {
+  printf("Testing memput and memget over the shm transport\n");
+  // Use a few pages so that the cross-memory copies cross page boundaries.
+  size_t n = 4 * 4096 + 8;
+  hpx_addr_t data = hpx_gas_alloc_cyclic(HPX_LOCALITIES, n, 0);
+  test_assert_msg(data != HPX_NULL, "failed to allocate data\n");
+  int peer = (HPX_LOCALITY_ID + 1) % HPX_LOCALITIES;
+  hpx_addr_t block = hpx_addr_add(data, peer * n, n);
+
+  char *send = malloc(n);
+  char *recv = malloc(n);
+  _fill(send, n, 42);
+  CHECK( hpx_gas_memput_rsync(block, send, n) );
+  CHECK( hpx_gas_memget_sync(recv, block, n) );
+  _check(send, recv, n);
+  free(send);
+  free(recv);
+  hpx_gas_free_sync(data);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, pwc_shm_memput_memget,
+                  pwc_shm_memput_memget_handler);
+
+TEST_MAIN({
+  ADD_TEST(pwc_shm_eager, 0);
+  ADD_TEST(pwc_shm_rendezvous, 0);
+  ADD_TEST(pwc_shm_memput_memget, 0);
+  ADD_TEST(pwc_shm_memput_memget, 1 % HPX_LOCALITIES);
+});